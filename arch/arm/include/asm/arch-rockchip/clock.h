@@ -18,6 +18,10 @@
 #define ROCKCHIP_PLL_SYNC_RATE		BIT(0)
 /* normal mode only. now only for pll_rk3036, pll_rk3328 type */
 #define ROCKCHIP_PLL_FIXED_MODE		BIT(1)
+/* program the PLL but leave the lock wait to rockchip_pll_wait_lock() */
+#define ROCKCHIP_PLL_DEFER_LOCK		BIT(2)
+/* set by rockchip_pll_set_rate() when a deferred lock wait is owed */
+#define ROCKCHIP_PLL_LOCK_PENDING	BIT(3)
 
 enum {
 	ROCKCHIP_SYSCON_NOC,
@@ -147,6 +151,12 @@ static inline int rockchip_pll_set_rate(struct rockchip_pll_clock *pll,
 	return 0;
 }
 
+static inline int rockchip_pll_wait_lock(struct rockchip_pll_clock *pll,
+					 void __iomem *base, ulong pll_id)
+{
+	return 0;
+}
+
 static inline const struct rockchip_cpu_rate_table *
 rockchip_get_cpu_settings(struct rockchip_cpu_rate_table *cpu_table,
 			  ulong rate)
@@ -159,6 +169,12 @@ int rockchip_pll_set_rate(struct rockchip_pll_clock *pll,
 			  ulong drate);
 ulong rockchip_pll_get_rate(struct rockchip_pll_clock *pll,
 			    void __iomem *base, ulong clk_id);
+/*
+ * Finish a PLL that was programmed with ROCKCHIP_PLL_DEFER_LOCK set: wait for
+ * lock and switch it to normal mode. Clears both deferral flags.
+ */
+int rockchip_pll_wait_lock(struct rockchip_pll_clock *pll,
+			   void __iomem *base, ulong pll_id);
 const struct rockchip_cpu_rate_table *
 rockchip_get_cpu_settings(struct rockchip_cpu_rate_table *cpu_table,
 			  ulong rate);
@@ -13,6 +13,7 @@
  */
 
 #include <common.h>
+#include <android_misc.h>
 #include <command.h>
 #include <amp.h>
 #include <dm.h>
@@ -95,6 +96,9 @@ static void announce_and_cleanup(bootm_headers_t *images, int fake)
 	udc_disconnect();
 #endif
 
+	/* Write back boot-time misc updates (A/B tries, BCB) */
+	android_misc_flush();
+
 	board_quiesce_devices(images);
 
 	/* Flush all console data */
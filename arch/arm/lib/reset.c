@@ -22,6 +22,7 @@
  */
 
 #include <common.h>
+#include <android_misc.h>
 
 __weak void reset_misc(void)
 {
@@ -31,6 +32,8 @@ int do_reset(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
 {
 	puts ("resetting ...\n");
 
+	android_misc_flush();
+
 	udelay (50000);				/* wait 50 ms */
 
 	disable_interrupts();
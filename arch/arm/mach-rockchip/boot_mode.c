@@ -5,6 +5,7 @@
  */
 
 #include <common.h>
+#include <android_misc.h>
 #include <boot_rkimg.h>
 #include <malloc.h>
 #include <asm/io.h>
@@ -38,7 +39,8 @@ static int misc_require_recovery(u32 bcb_offset, int *bcb_recovery_msg)
 
 	cnt = DIV_ROUND_UP(sizeof(struct bootloader_message), dev_desc->blksz);
 	bmsg = memalign(ARCH_DMA_MINALIGN, cnt * dev_desc->blksz);
-	if (blk_dread(dev_desc, part.start + bcb_offset, cnt, bmsg) != cnt) {
+	if (!bmsg ||
+	    android_misc_read(dev_desc, &part, bcb_offset, cnt, bmsg) != cnt) {
 		recovery = 0;
 	} else {
 		recovery = !strcmp(bmsg->command, "boot-recovery");
@@ -8,6 +8,7 @@
 #include <adc.h>
 #include <android_bootloader.h>
 #include <android_image.h>
+#include <android_misc.h>
 #include <bidram.h>
 #include <bootm.h>
 #include <boot_rkimg.h>
@@ -383,8 +384,8 @@ void board_run_recovery_wipe_data(void)
 	strcpy(bmsg.recovery, "recovery\n--wipe_data");
 	bmsg.status[0] = 0;
 	cnt = DIV_ROUND_UP(sizeof(struct bootloader_message), dev_desc->blksz);
-	ret = blk_dwrite(dev_desc, part_info.start + bcb_offset, cnt, &bmsg);
-	if (ret != cnt)
+	ret = android_misc_write(dev_desc, &part_info, bcb_offset, cnt, &bmsg);
+	if (ret != cnt || android_misc_flush())
 		printf("Wipe data failed, ret=%d\n", ret);
 out:
 	/* now reboot to recovery */
@@ -0,0 +1,63 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <event_loop.h>
+#include <irq-generic.h>
+#include <rk_timer_irq.h>
+#include <asm/io.h>
+#include <asm/system.h>
+
+/*
+ * Event loop waits stop the CPU in WFI, with the timer that the charge
+ * animation and the debugger use for their own wakeups as a one-shot bound
+ * on the idle time. Any other interrupt ends the idle early. If one of those
+ * users holds the timer, or the caller runs with IRQs masked, the wait falls
+ * back to polling.
+ */
+
+/* IRQ mask bit, in DAIF on AArch64 and in CPSR on AArch32 */
+#define EVENT_IDLE_IRQ_MASKED	BIT(7)
+
+static void event_idle_timer_isr(int irq, void *data)
+{
+	writel(TIMER_CLR_INT, TIMER_BASE + TIMER_INTSTATUS);
+	writel(0, TIMER_BASE + TIMER_CTRL);
+}
+
+void arch_event_idle(ulong ms)
+{
+	u64 count = 24000ULL * ms;
+	unsigned long flags;
+
+	/* Do not leave a timer interrupt pending for a masked caller */
+	local_irq_save(flags);
+	if ((flags & EVENT_IDLE_IRQ_MASKED) || irq_is_busy(TIMER_IRQ)) {
+		local_irq_restore(flags);
+		return;
+	}
+
+	writel(0, TIMER_BASE + TIMER_CTRL);
+	writel((u32)count, TIMER_BASE + TIMER_LOAD_COUNT0);
+	writel((u32)(count >> 32), TIMER_BASE + TIMER_LOAD_COUNT1);
+	writel(TIMER_CLR_INT, TIMER_BASE + TIMER_INTSTATUS);
+
+	irq_install_handler(TIMER_IRQ, event_idle_timer_isr, NULL);
+	if (irq_handler_enable(TIMER_IRQ)) {
+		irq_free_handler(TIMER_IRQ);
+		local_irq_restore(flags);
+		return;
+	}
+	writel(TIMER_EN | TIMER_INT_EN, TIMER_BASE + TIMER_CTRL);
+
+	/* A pending interrupt still ends WFI while it is masked */
+	if (!event_loop_woken())
+		wfi();
+	local_irq_restore(flags);
+
+	writel(0, TIMER_BASE + TIMER_CTRL);
+	irq_free_handler(TIMER_IRQ);
+}
@@ -6,6 +6,7 @@
 #include <common.h>
 #include <dm.h>
 #include <errno.h>
+#include <event_loop.h>
 #include <linux/libfdt.h>
 #include <os.h>
 #include <asm/io.h>
@@ -46,6 +47,22 @@ void __udelay(unsigned long usec)
 		os_usleep(usec);
 }
 
+#if CONFIG_IS_ENABLED(EVENT_LOOP)
+/* Idle in a host signal wait, which event_loop_wakeup() interrupts */
+void arch_event_idle(ulong ms)
+{
+	struct sandbox_state *state = state_get_current();
+
+	if (!state->skip_delays)
+		os_wait_wakeup(ms * 1000);
+}
+
+void arch_event_wakeup(void)
+{
+	os_raise_wakeup();
+}
+#endif
+
 int cleanup_before_linux(void)
 {
 	return 0;
@@ -7,6 +7,9 @@
 #include <errno.h>
 #include <fcntl.h>
 #include <getopt.h>
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdint.h>
 #include <stdlib.h>
@@ -187,6 +190,86 @@ void os_usleep(unsigned long usec)
 	usleep(usec);
 }
 
+/*
+ * SIGUSR1 is kept blocked and only ever collected by sigtimedwait(), so a
+ * wakeup raised while nobody is waiting stays pending for the next wait.
+ */
+static void os_block_wakeup(sigset_t *set)
+{
+	sigemptyset(set);
+	sigaddset(set, SIGUSR1);
+	sigprocmask(SIG_BLOCK, set, NULL);
+}
+
+void os_wait_wakeup(unsigned long usec)
+{
+	struct timespec ts;
+	sigset_t set;
+
+	os_block_wakeup(&set);
+	ts.tv_sec = usec / 1000000;
+	ts.tv_nsec = (usec % 1000000) * 1000;
+	sigtimedwait(&set, NULL, &ts);
+}
+
+void os_raise_wakeup(void)
+{
+	sigset_t set;
+
+	os_block_wakeup(&set);
+	kill(getpid(), SIGUSR1);
+}
+
+struct os_thread {
+	pthread_t id;
+	void (*func)(void *arg);
+	void *arg;
+};
+
+static void *os_thread_start(void *data)
+{
+	struct os_thread *thread = data;
+
+	thread->func(thread->arg);
+
+	return NULL;
+}
+
+int os_thread_create(void (*func)(void *arg), void *arg, void **threadp)
+{
+	struct os_thread *thread;
+
+	thread = os_malloc(sizeof(*thread));
+	if (!thread)
+		return -1;
+
+	thread->func = func;
+	thread->arg = arg;
+	if (pthread_create(&thread->id, NULL, os_thread_start, thread)) {
+		os_free(thread);
+		return -1;
+	}
+	*threadp = thread;
+
+	return 0;
+}
+
+int os_thread_join(void *data)
+{
+	struct os_thread *thread = data;
+	int ret;
+
+	ret = pthread_join(thread->id, NULL);
+	os_free(thread);
+
+	return ret ? -1 : 0;
+}
+
+void os_thread_yield(void)
+{
+	sched_yield();
+}
+
 uint64_t __attribute__((no_instrument_function)) os_get_nsec(void)
 {
 #if defined(CLOCK_MONOTONIC) && defined(_POSIX_MONOTONIC_CLOCK)
@@ -24,6 +24,19 @@ enum sandbox_clk_id {
 	SANDBOX_CLK_ID_COUNT,
 };
 
+/**
+ * enum sandbox_clk_cru_id - Identity of clocks implemented by the sandbox
+ * CRU, a clock provider with PLLs that have to lock.
+ *
+ * DIV0 is fed by PLL0 and DIV1 by PLL1.
+ */
+enum sandbox_clk_cru_id {
+	SANDBOX_CLK_CRU_ID_PLL0,
+	SANDBOX_CLK_CRU_ID_PLL1,
+	SANDBOX_CLK_CRU_ID_DIV0,
+	SANDBOX_CLK_CRU_ID_DIV1,
+};
+
 /**
  * enum sandbox_clk_test_id - Identity of the clocks consumed by the sandbox
  * clock test device.
@@ -55,6 +68,37 @@ ulong sandbox_clk_query_rate(struct udevice *dev, int id);
  */
 int sandbox_clk_query_enable(struct udevice *dev, int id);
 
+/**
+ * sandbox_clk_cru_get_rate_count - Query how often the sandbox CRU was asked
+ * for a rate.
+ *
+ * @dev:	The sandbox CRU device.
+ * @return:	The number of get_rate() calls that reached the driver.
+ */
+uint sandbox_clk_cru_get_rate_count(struct udevice *dev);
+/**
+ * sandbox_clk_cru_pll_program_count - Query how often a sandbox CRU PLL was
+ * reprogrammed.
+ *
+ * @dev:	The sandbox CRU device.
+ * @return:	The number of PLL rate changes.
+ */
+uint sandbox_clk_cru_pll_program_count(struct udevice *dev);
+/**
+ * sandbox_clk_cru_lock_wait_count - Query how often the sandbox CRU waited
+ * for its PLLs to lock.
+ *
+ * @dev:	The sandbox CRU device.
+ * @return:	The number of lock waits.
+ */
+uint sandbox_clk_cru_lock_wait_count(struct udevice *dev);
+/**
+ * sandbox_clk_cru_reset_counts - Reset the sandbox CRU call counters.
+ *
+ * @dev:	The sandbox CRU device.
+ */
+void sandbox_clk_cru_reset_counts(struct udevice *dev);
+
 /**
  * sandbox_clk_test_get - Ask the sandbox clock test device to request its
  * clocks.
@@ -82,4 +82,13 @@ int sandbox_gpio_get_direction(struct udevice *dev, unsigned int offset);
 int sandbox_gpio_set_direction(struct udevice *dev, unsigned int offset,
 			       int output);
 
+/**
+ * Return how often the driver read the simulated input register (used only
+ * in sandbox test code)
+ *
+ * @param dev		device to use
+ * @return number of get_value() and get_values() calls so far
+ */
+uint sandbox_gpio_get_read_count(struct udevice *dev);
+
 #endif
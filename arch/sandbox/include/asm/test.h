@@ -48,6 +48,15 @@ void sandbox_i2c_eeprom_set_test_mode(struct udevice *dev,
 
 void sandbox_i2c_eeprom_set_offset_len(struct udevice *dev, int offset_len);
 
+/**
+ * sandbox_i2c_pmic_xfer_count() - get the number of PMIC bus transactions
+ *
+ * @emul:	PMIC emulator
+ * @reset:	true to restart counting from zero
+ * @return number of transactions since the last reset
+ */
+int sandbox_i2c_pmic_xfer_count(struct udevice *emul, bool reset);
+
 /*
  * sandbox_timer_add_offset()
  *
@@ -79,6 +88,28 @@ long sandbox_i2c_rtc_get_set_base_time(struct udevice *dev, long base_time);
 
 int sandbox_usb_keyb_add_string(struct udevice *dev, const char *str);
 
+/**
+ * sandbox_adc_set_noise() - make the sandbox ADC readings noisy
+ *
+ * Conversions alternately read @noise above and below the channel's data,
+ * so the average of an even number of them is exact, as long as the data is
+ * not below @noise.
+ *
+ * @dev: Device to update
+ * @noise: Offset to apply, 0 for exact readings
+ */
+void sandbox_adc_set_noise(struct udevice *dev, unsigned int noise);
+
+/**
+ * sandbox_adc_get_starts() - get the number of conversions started
+ *
+ * A multi-channel conversion counts once.
+ *
+ * @dev: Device to check
+ * @return number of conversions started since the device was probed
+ */
+unsigned int sandbox_adc_get_starts(struct udevice *dev);
+
 /**
  * sandbox_osd_get_mem() - get the internal memory of a sandbox OSD
  *
@@ -102,6 +133,17 @@ int sandbox_osd_get_mem(struct udevice *dev, u8 *buf, size_t buflen);
 int sandbox_pwm_get_config(struct udevice *dev, uint channel, uint *period_nsp,
 			   uint *duty_nsp, bool *enablep, bool *polarityp);
 
+/**
+ * sandbox_serial_get_access_counts() - get the register accesses of a
+ * sandbox serial port
+ *
+ * @dev: Device to check
+ * @status_readsp: Returns the number of status register reads so far
+ * @data_writesp: Returns the number of data register writes so far
+ */
+void sandbox_serial_get_access_counts(struct udevice *dev, uint *status_readsp,
+				      uint *data_writesp);
+
 /**
  * sandbox_sf_set_block_protect() - Set the BP bits of the status register
  *
@@ -140,6 +140,68 @@ static int do_host_dev(cmd_tbl_t *cmdtp, int flag, int argc,
 	return 0;
 }
 
+static int do_host_model(cmd_tbl_t *cmdtp, int flag, int argc,
+			 char * const argv[])
+{
+	char *ep;
+	int dev, ret;
+
+	if (argc != 3)
+		return CMD_RET_USAGE;
+
+	dev = simple_strtoul(argv[1], &ep, 16);
+	if (*ep) {
+		printf("** Bad device specification %s **\n", argv[1]);
+		return CMD_RET_USAGE;
+	}
+
+	ret = host_dev_set_model(dev, argv[2]);
+	if (ret == -ENODEV) {
+		puts("Not bound to a backing file\n");
+		return 1;
+	} else if (ret == -ENOENT) {
+		printf("Unknown model '%s'\n", argv[2]);
+		return 1;
+	}
+
+	return 0;
+}
+
+static int do_host_stats(cmd_tbl_t *cmdtp, int flag, int argc,
+			 char * const argv[])
+{
+	struct sandbox_storage *storage;
+	bool reset = false;
+
+	if (argc > 2)
+		return CMD_RET_USAGE;
+	if (argc == 2) {
+		if (strcmp(argv[1], "reset"))
+			return CMD_RET_USAGE;
+		reset = true;
+	}
+
+	list_for_each_entry(storage, sandbox_storage_list(), sibling) {
+		struct sandbox_storage_stats *stats = &storage->stats;
+
+		if (reset) {
+			memset(stats, '\0', sizeof(*stats));
+			continue;
+		}
+		printf("%s: model %s\n", storage->name,
+		       storage->model ? storage->model->name : "none");
+		printf("  reads %lu, %llu bytes\n", stats->reads,
+		       stats->read_bytes);
+		printf("  writes %lu, %llu bytes\n", stats->writes,
+		       stats->write_bytes);
+		printf("  erases %lu, %llu bytes\n", stats->erases,
+		       stats->erase_bytes);
+		printf("  time %llu us\n", stats->time_us);
+	}
+
+	return 0;
+}
+
 static cmd_tbl_t cmd_host_sub[] = {
 	U_BOOT_CMD_MKENT(load, 7, 0, do_host_load, "", ""),
 	U_BOOT_CMD_MKENT(ls, 3, 0, do_host_ls, "", ""),
@@ -148,6 +210,8 @@ static cmd_tbl_t cmd_host_sub[] = {
 	U_BOOT_CMD_MKENT(bind, 3, 0, do_host_bind, "", ""),
 	U_BOOT_CMD_MKENT(info, 3, 0, do_host_info, "", ""),
 	U_BOOT_CMD_MKENT(dev, 0, 1, do_host_dev, "", ""),
+	U_BOOT_CMD_MKENT(model, 3, 0, do_host_model, "", ""),
+	U_BOOT_CMD_MKENT(stats, 2, 0, do_host_stats, "", ""),
 };
 
 static int do_host(cmd_tbl_t *cmdtp, int flag, int argc,
@@ -185,6 +249,9 @@ U_BOOT_CMD(
 	"host bind <dev> [<filename>] - bind \"host\" device to file\n"
 	"host info [<dev>]            - show device binding & info\n"
 	"host dev [<dev>] - Set or retrieve the current host device\n"
+	"host model <dev> <model>     - emulate timing of storage device\n"
+	"                               (none, emmc, spi-nand, spi-nor, usb-msc)\n"
+	"host stats [reset]           - show or reset storage statistics\n"
 	"host commands use the \"hostfs\" device. The \"host\" device is used\n"
 	"with standard IO commands such as fatls or ext2load"
 );
@@ -7,6 +7,7 @@
 
 #include <errno.h>
 #include <common.h>
+#include <android_misc.h>
 #include <command.h>
 #include <console.h>
 #include <g_dnl.h>
@@ -231,6 +232,9 @@ static int do_rkusb(cmd_tbl_t *cmdtp, int flag, int argc, char *const argv[])
 		free(sn);
 	}
 
+	/* The host writes the disk directly, misc included */
+	android_misc_invalidate();
+
 	rc = g_dnl_register("rkusb_ums_dnl");
 	if (rc) {
 		pr_err("g_dnl_register failed");
@@ -8,6 +8,7 @@
 
 #include <android_bootloader_message.h>
 #include <android_image.h>
+#include <android_misc.h>
 #include <boot_rkimg.h>
 #include <common.h>
 #include <malloc.h>
@@ -90,8 +91,8 @@ static void *android_boot_control_create_from_disk(
 	if (!buf)
 		return NULL;
 
-	if (blk_dread(dev_desc, part_info->start + abc_offset, abc_blocks,
-		      buf) != abc_blocks) {
+	if (android_misc_read(dev_desc, part_info, abc_offset, abc_blocks,
+			      buf) != abc_blocks) {
 		printf("ANDROID: Could not read from boot control partition\n");
 		free(buf);
 		return NULL;
@@ -102,7 +103,9 @@ static void *android_boot_control_create_from_disk(
 
 /** android_boot_control_store
  * Store the loaded boot_control block back to the same location it was read
- * from with android_boot_control_create_from_misc().
+ * from with android_boot_control_create_from_misc(). The update is written
+ * through to the disk at once, so that a boot attempt is counted even if the
+ * bootloader hangs or is reset before the kernel starts.
  *
  * @abc_data_block: pointer to the boot_control struct and the extra bytes after
  *                  it up to the nearest block boundary.
@@ -120,8 +123,9 @@ static int android_boot_control_store(void *abc_data_block,
 			      slot_suffix) / part_info->blksz;
 	abc_blocks = DIV_ROUND_UP(sizeof(struct android_bootloader_control),
 				  part_info->blksz);
-	if (blk_dwrite(dev_desc, part_info->start + abc_offset, abc_blocks,
-		       abc_data_block) != abc_blocks) {
+	if (android_misc_write(dev_desc, part_info, abc_offset, abc_blocks,
+			       abc_data_block) != abc_blocks ||
+	    android_misc_flush()) {
 		printf("ANDROID: Could not write back the misc partition\n");
 		return -1;
 	}
@@ -296,7 +300,7 @@ int read_misc_virtual_ab_message(struct misc_virtual_ab_message *message)
 	}
 
 	cnt = DIV_ROUND_UP(sizeof(struct misc_virtual_ab_message), dev_desc->blksz);
-	if (blk_dread(dev_desc, part_info.start + bcb_offset, cnt, message) != cnt) {
+	if (android_misc_read(dev_desc, &part_info, bcb_offset, cnt, message) != cnt) {
 		debug("%s: could not read from misc partition\n", __func__);
 		return -1;
 	}
@@ -330,9 +334,9 @@ int write_misc_virtual_ab_message(struct misc_virtual_ab_message *message)
 	}
 
 	cnt = DIV_ROUND_UP(sizeof(struct misc_virtual_ab_message), dev_desc->blksz);
-	ret = blk_dwrite(dev_desc, part_info.start + bcb_offset, cnt, message);
-	if (ret != cnt)
-		debug("%s: blk_dwrite write failed, ret=%d\n", __func__, ret);
+	ret = android_misc_write(dev_desc, &part_info, bcb_offset, cnt, message);
+	if (ret != cnt || android_misc_flush())
+		debug("%s: misc write failed, ret=%d\n", __func__, ret);
 
 	return 0;
 }
@@ -11,6 +11,7 @@
 #include <android_avb/rk_avb_ops_user.h>
 #include <android_image.h>
 #include <android_ab.h>
+#include <android_misc.h>
 #include <bootm.h>
 #include <asm/arch/hotkey.h>
 #include <cli.h>
@@ -44,9 +45,9 @@ int android_bootloader_message_load(
 		return -1;
 	}
 
-	if (blk_dread(dev_desc, part_info->start + android_bcb_msg_sector_offset(),
-	     message_blocks, message) !=
-	    message_blocks) {
+	if (android_misc_read(dev_desc, part_info,
+			      android_bcb_msg_sector_offset(),
+			      message_blocks, message) != message_blocks) {
 		printf("Could not read from misc partition\n");
 		return -1;
 	}
@@ -60,15 +61,16 @@ static int android_bootloader_message_write(
 	struct android_bootloader_message *message)
 {
 	ulong message_blocks = sizeof(struct android_bootloader_message) /
-	    part_info->blksz + android_bcb_msg_sector_offset();
+	    part_info->blksz;
+	u32 offset = android_bcb_msg_sector_offset();
 
-	if (message_blocks > part_info->size) {
+	if (offset + message_blocks > part_info->size) {
 		printf("misc partition too small.\n");
 		return -1;
 	}
 
-	if (blk_dwrite(dev_desc, part_info->start, message_blocks, message) !=
-	    message_blocks) {
+	if (android_misc_write(dev_desc, part_info, offset, message_blocks,
+			       message) != message_blocks) {
 		printf("Could not write to misc partition\n");
 		return -1;
 	}
@@ -147,7 +149,12 @@ int android_bcb_write(char *cmd)
 	}
 
 	strcpy(message.command, cmd);
-	return android_bootloader_message_write(dev_desc, &part_info, &message);
+	ret = android_bootloader_message_write(dev_desc, &part_info, &message);
+	if (ret)
+		return ret;
+
+	/* The command is for the next boot, don't lose it to a crash */
+	return android_misc_flush();
 }
 
 /**
@@ -0,0 +1,191 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:     GPL-2.0+
+ */
+
+#include <common.h>
+#include <android_misc.h>
+#include <malloc.h>
+
+/*
+ * The BCB (0KB or 16KB), the A/B metadata (2KB) and the virtual A/B message
+ * (32KB) all live at the start of misc. They are read several times during
+ * one boot, so the area is loaded once and reads are served from memory.
+ *
+ * Updates are kept in memory until android_misc_flush(), which runs before
+ * the kernel is started or the board is reset. Pending updates are recorded
+ * as block ranges in the order they were first made, and written back in
+ * that order. Nothing guarantees that a flush happens, e.g. on a watchdog
+ * reset or a hang, and the BCB has no CRC to detect a torn write, so callers
+ * flush right away any update that must not be lost: the A/B tries counter
+ * and commands for the next boot.
+ */
+#define MISC_MAX_DIRTY		8
+
+struct misc_range {
+	lbaint_t blk;
+	lbaint_t cnt;
+};
+
+static struct {
+	struct blk_desc *dev_desc;
+	lbaint_t start;
+	lbaint_t blkcnt;
+	ulong blksz;
+	u8 *buf;
+	struct misc_range dirty[MISC_MAX_DIRTY];
+	int ndirty;
+} misc;
+
+static int android_misc_load(struct blk_desc *dev_desc,
+			     const disk_partition_t *part_info)
+{
+	lbaint_t blkcnt;
+	u8 *buf;
+
+	if (misc.buf && misc.dev_desc == dev_desc &&
+	    misc.start == part_info->start)
+		return 0;
+
+	android_misc_invalidate();
+
+	blkcnt = CONFIG_ANDROID_MISC_CACHE_SIZE / dev_desc->blksz;
+	if (blkcnt > part_info->size)
+		blkcnt = part_info->size;
+	if (!blkcnt)
+		return -EINVAL;
+
+	buf = memalign(ARCH_DMA_MINALIGN, blkcnt * dev_desc->blksz);
+	if (!buf)
+		return -ENOMEM;
+
+	if (blk_dread(dev_desc, part_info->start, blkcnt, buf) != blkcnt) {
+		printf("Could not read from misc partition\n");
+		free(buf);
+		return -EIO;
+	}
+
+	misc.dev_desc = dev_desc;
+	misc.start = part_info->start;
+	misc.blkcnt = blkcnt;
+	misc.blksz = dev_desc->blksz;
+	misc.buf = buf;
+	misc.ndirty = 0;
+	debug("MISC: cached %lu blocks\n", (ulong)blkcnt);
+
+	return 0;
+}
+
+static int android_misc_mark_dirty(lbaint_t blk, lbaint_t cnt)
+{
+	struct misc_range *r;
+	int i;
+
+	for (i = 0; i < misc.ndirty; i++) {
+		r = &misc.dirty[i];
+		if (blk >= r->blk && blk + cnt <= r->blk + r->cnt)
+			return 0;
+	}
+
+	/* Grow the latest range if the new one touches it */
+	if (misc.ndirty) {
+		r = &misc.dirty[misc.ndirty - 1];
+		if (blk <= r->blk + r->cnt && blk + cnt >= r->blk) {
+			cnt = max(blk + cnt, r->blk + r->cnt);
+			r->blk = min(blk, r->blk);
+			r->cnt = cnt - r->blk;
+			return 0;
+		}
+	}
+
+	/* If the write-back fails, the old ranges stay and there is no room */
+	if (misc.ndirty == MISC_MAX_DIRTY && android_misc_flush())
+		return -ENOSPC;
+
+	misc.dirty[misc.ndirty].blk = blk;
+	misc.dirty[misc.ndirty].cnt = cnt;
+	misc.ndirty++;
+
+	return 0;
+}
+
+ulong android_misc_read(struct blk_desc *dev_desc,
+			const disk_partition_t *part_info,
+			lbaint_t blk, lbaint_t blkcnt, void *buf)
+{
+	if (!android_misc_load(dev_desc, part_info) &&
+	    blk + blkcnt <= misc.blkcnt) {
+		memcpy(buf, misc.buf + blk * misc.blksz, blkcnt * misc.blksz);
+		return blkcnt;
+	}
+
+	/* Outside the cached area: make pending updates visible first */
+	android_misc_flush();
+
+	return blk_dread(dev_desc, part_info->start + blk, blkcnt, buf);
+}
+
+ulong android_misc_write(struct blk_desc *dev_desc,
+			 const disk_partition_t *part_info,
+			 lbaint_t blk, lbaint_t blkcnt, const void *buf)
+{
+	lbaint_t cnt;
+	ulong ret;
+
+	if (!android_misc_load(dev_desc, part_info) &&
+	    blk + blkcnt <= misc.blkcnt) {
+		memcpy(misc.buf + blk * misc.blksz, buf, blkcnt * misc.blksz);
+		if (!android_misc_mark_dirty(blk, blkcnt))
+			return blkcnt;
+
+		/* The update cannot be logged, so write it through */
+		return blk_dwrite(dev_desc, part_info->start + blk, blkcnt,
+				  buf);
+	}
+
+	android_misc_flush();
+
+	ret = blk_dwrite(dev_desc, part_info->start + blk, blkcnt, buf);
+	if (ret != blkcnt || !misc.buf || misc.dev_desc != dev_desc ||
+	    misc.start != part_info->start || blk >= misc.blkcnt)
+		return ret;
+
+	/* Keep the cached copy of the blocks we just wrote in sync */
+	cnt = min(blkcnt, misc.blkcnt - blk);
+	memcpy(misc.buf + blk * misc.blksz, buf, cnt * misc.blksz);
+
+	return ret;
+}
+
+int android_misc_flush(void)
+{
+	struct misc_range *r;
+	int i;
+
+	for (i = 0; i < misc.ndirty; i++) {
+		r = &misc.dirty[i];
+		if (blk_dwrite(misc.dev_desc, misc.start + r->blk, r->cnt,
+			       misc.buf + r->blk * misc.blksz) != r->cnt) {
+			printf("Could not write to misc partition\n");
+			misc.ndirty -= i;
+			memmove(misc.dirty, r, misc.ndirty * sizeof(*r));
+			return -EIO;
+		}
+		debug("MISC: wrote back %lu blocks at %lu\n",
+		      (ulong)r->cnt, (ulong)r->blk);
+	}
+	misc.ndirty = 0;
+
+	return 0;
+}
+
+void android_misc_invalidate(void)
+{
+	if (!misc.buf)
+		return;
+
+	android_misc_flush();
+	free(misc.buf);
+	memset(&misc, 0, sizeof(misc));
+}
@@ -12,8 +12,11 @@
 #include <common.h>
 #include <command.h>
 #include <console.h>
+#include <malloc.h>
 #include <linux/ctype.h>
 
+DECLARE_GLOBAL_DATA_PTR;
+
 /*
  * Use puts() instead of printf() to avoid printf buffer overflow
  * for long help messages
@@ -82,22 +85,28 @@ int _do_help(cmd_tbl_t *cmd_start, int cmd_items, cmd_tbl_t *cmdtp, int flag,
 	return rcode;
 }
 
+/*
+ * Some commands allow length modifiers (like "cp.b");
+ * compare command name only until first dot.
+ */
+static int cmd_name_len(const char *cmd)
+{
+	const char *p;
+
+	return ((p = strchr(cmd, '.')) == NULL) ? strlen(cmd) : (p - cmd);
+}
+
 /* find command table entry for a command */
 cmd_tbl_t *find_cmd_tbl(const char *cmd, cmd_tbl_t *table, int table_len)
 {
 	cmd_tbl_t *cmdtp;
 	cmd_tbl_t *cmdtp_temp = table;	/* Init value */
-	const char *p;
 	int len;
 	int n_found = 0;
 
 	if (!cmd)
 		return NULL;
-	/*
-	 * Some commands allow length modifiers (like "cp.b");
-	 * compare command name only until first dot.
-	 */
-	len = ((p = strchr(cmd, '.')) == NULL) ? strlen (cmd) : (p - cmd);
+	len = cmd_name_len(cmd);
 
 	for (cmdtp = table; cmdtp != table + table_len; cmdtp++) {
 		if (strncmp(cmd, cmdtp->name, len) == 0) {
@@ -115,10 +124,89 @@ cmd_tbl_t *find_cmd_tbl(const char *cmd, cmd_tbl_t *table, int table_len)
 	return NULL;	/* not found or ambiguous command */
 }
 
+#ifdef CONFIG_CMDLINE_INDEX
+/*
+ * The linker list is ordered by section name, which is not always the
+ * command name (e.g. '?'), so keep a separate index of the command table
+ * sorted by name. It is built on the first lookup after relocation, once
+ * the table has reached its final address and malloc() is available.
+ */
+static cmd_tbl_t **cmd_index;
+static int cmd_index_len;
+
+static int h_cmp_cmd(const void *v1, const void *v2)
+{
+	const cmd_tbl_t *const *c1 = v1, *const *c2 = v2;
+
+	return strcmp((*c1)->name, (*c2)->name);
+}
+
+static bool find_cmd_index_ready(void)
+{
+	cmd_tbl_t *start = ll_entry_start(cmd_tbl_t, cmd);
+	const int len = ll_entry_count(cmd_tbl_t, cmd);
+	int i;
+
+	/* BSS is not usable before relocation, so do not even read it */
+	if (!(gd->flags & GD_FLG_RELOC))
+		return false;
+	if (cmd_index)
+		return true;
+
+	cmd_index = malloc(len * sizeof(*cmd_index));
+	if (!cmd_index)
+		return false;
+	for (i = 0; i < len; i++)
+		cmd_index[i] = start + i;
+	qsort(cmd_index, len, sizeof(*cmd_index), h_cmp_cmd);
+	cmd_index_len = len;
+
+	return true;
+}
+
+/* binary search of the sorted index, same matching rules as find_cmd_tbl() */
+static cmd_tbl_t *find_cmd_index(const char *cmd)
+{
+	int len = cmd_name_len(cmd);
+	int lo = 0, hi = cmd_index_len;
+	cmd_tbl_t *cmdtp;
+
+	/* first entry whose name does not sort before the command */
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+
+		if (strncmp(cmd_index[mid]->name, cmd, len) < 0)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+	if (lo == cmd_index_len)
+		return NULL;
+
+	cmdtp = cmd_index[lo];
+	if (strncmp(cmd, cmdtp->name, len))
+		return NULL;			/* not found */
+	if (len == strlen(cmdtp->name))
+		return cmdtp;			/* full match */
+
+	/* abbreviated command: all candidates are adjacent in the index */
+	if (lo + 1 < cmd_index_len &&
+	    !strncmp(cmd, cmd_index[lo + 1]->name, len))
+		return NULL;			/* ambiguous command */
+
+	return cmdtp;
+}
+#endif
+
 cmd_tbl_t *find_cmd(const char *cmd)
 {
 	cmd_tbl_t *start = ll_entry_start(cmd_tbl_t, cmd);
 	const int len = ll_entry_count(cmd_tbl_t, cmd);
+
+#ifdef CONFIG_CMDLINE_INDEX
+	if (cmd && find_cmd_index_ready())
+		return find_cmd_index(cmd);
+#endif
 	return find_cmd_tbl(cmd, start, len);
 }
 
@@ -437,8 +525,6 @@ int cmd_get_data_size(char* arg, int default_size)
 #endif
 
 #if defined(CONFIG_NEEDS_MANUAL_RELOC)
-DECLARE_GLOBAL_DATA_PTR;
-
 void fixup_cmdtable(cmd_tbl_t *cmdtp, int size)
 {
 	int	i;
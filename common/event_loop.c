@@ -0,0 +1,154 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <errno.h>
+#include <event_loop.h>
+#include <watchdog.h>
+
+/*
+ * Longest idle between watchdog kicks, well below any watchdog period. The
+ * waits replace mdelay(), which kicks the watchdog as it goes, and also have
+ * to kick watchdogs started through driver model.
+ */
+#define EVENT_IDLE_MAX_MS	100
+
+static LIST_HEAD(event_work_list);
+static volatile bool event_woken;
+
+static bool event_time_after_eq(ulong a, ulong b)
+{
+	return (long)(a - b) >= 0;
+}
+
+void event_work_init(struct event_work *work, event_work_func_t func)
+{
+	INIT_LIST_HEAD(&work->node);
+	work->func = func;
+	work->queued = false;
+}
+
+void event_queue_work(struct event_work *work, ulong delay_ms)
+{
+	struct event_work *pos;
+
+	event_cancel_work(work);
+	work->due = get_timer(0) + delay_ms;
+
+	/* Keep the list sorted, after any work due at the same time */
+	list_for_each_entry(pos, &event_work_list, node) {
+		if (!event_time_after_eq(work->due, pos->due))
+			break;
+	}
+	list_add_tail(&work->node, &pos->node);
+	work->queued = true;
+}
+
+bool event_cancel_work(struct event_work *work)
+{
+	if (!work->queued)
+		return false;
+
+	list_del_init(&work->node);
+	work->queued = false;
+
+	return true;
+}
+
+ulong event_loop_run(void)
+{
+	struct event_work *work;
+	ulong now;
+
+	/*
+	 * Take one item at a time, as a work function may queue or cancel
+	 * other work, or wait itself.
+	 */
+	while (!list_empty(&event_work_list)) {
+		work = list_first_entry(&event_work_list, struct event_work,
+					node);
+		now = get_timer(0);
+		if (!event_time_after_eq(now, work->due))
+			return work->due - now;
+
+		event_cancel_work(work);
+		work->func(work);
+	}
+
+	return EVENT_LOOP_IDLE_FOREVER;
+}
+
+__weak void arch_event_idle(ulong ms)
+{
+}
+
+__weak void arch_event_wakeup(void)
+{
+}
+
+bool event_loop_woken(void)
+{
+	return event_woken;
+}
+
+void event_loop_wakeup(void)
+{
+	event_woken = true;
+	arch_event_wakeup();
+}
+
+static void event_loop_idle(ulong ms)
+{
+	if (ms && !event_woken)
+		arch_event_idle(ms);
+	event_woken = false;
+}
+
+int event_wait(bool (*cond)(void *data), void *data, ulong timeout_ms)
+{
+	ulong start, elapsed, next;
+
+	start = get_timer(0);
+	for (;;) {
+		watchdog_progress();
+		next = event_loop_run();
+		if (cond(data))
+			return 0;
+
+		elapsed = get_timer(start);
+		if (elapsed >= timeout_ms)
+			return -ETIMEDOUT;
+
+		next = min(next, timeout_ms - elapsed);
+		event_loop_idle(min_t(ulong, next, EVENT_IDLE_MAX_MS));
+	}
+}
+
+static bool event_never(void *data)
+{
+	return false;
+}
+
+void event_loop_sleep(ulong ms)
+{
+	event_wait(event_never, NULL, ms);
+}
+
+void complete(struct completion *comp)
+{
+	comp->done = true;
+	event_loop_wakeup();
+}
+
+static bool event_completion_done(void *data)
+{
+	return completion_done(data);
+}
+
+int wait_for_completion_timeout(struct completion *comp, ulong timeout_ms)
+{
+	return event_wait(event_completion_done, comp, timeout_ms);
+}
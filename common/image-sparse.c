@@ -42,6 +42,7 @@
 #include <part.h>
 #include <sparse_format.h>
 #include <fastboot.h>
+#include <watchdog.h>
 
 #include <linux/math64.h>
 
@@ -110,6 +111,8 @@ void write_sparse_image(
 	/* Start processing chunks */
 	blk = info->start;
 	for (chunk = 0; chunk < sparse_header->total_chunks; chunk++) {
+		watchdog_progress();
+
 		/* Read and skip over chunk header */
 		chunk_header = (chunk_header_t *)data;
 		data += sizeof(chunk_header_t);
@@ -221,6 +224,7 @@ void write_sparse_image(
 				}
 				blk += blks;
 				i += j;
+				watchdog_progress();
 			}
 			bytes_written += ((u64)blkcnt) * info->blksz;
 			total_blocks += DIV_ROUND_UP_ULL(chunk_data_sz,
@@ -288,6 +288,43 @@ int usb_bulk_msg(struct usb_device *dev, unsigned int pipe,
 		return -EIO;
 }
 
+/*
+ * Host controllers without batch support carry out one transfer at a time
+ */
+__weak int submit_bulk_batch(struct usb_device *dev,
+			     struct usb_bulk_req *reqs, int count)
+{
+	return -ENOSYS;
+}
+
+/*
+ * submits several bulk messages, queued together if the host controller
+ * supports it and otherwise one after the other. Returns 0 if all of them
+ * completed OK, with the result of each in reqs[].act_len/status.
+ */
+int usb_bulk_batch(struct usb_device *dev, struct usb_bulk_req *reqs,
+		   int count, int timeout)
+{
+	int ret, i;
+
+	for (i = 0; i < count; i++) {
+		reqs[i].act_len = 0;
+		reqs[i].status = USB_ST_NOT_PROC;
+	}
+	ret = submit_bulk_batch(dev, reqs, count);
+	if (ret != -ENOSYS)
+		return ret ? -EIO : 0;
+
+	for (i = 0; i < count; i++) {
+		ret = usb_bulk_msg(dev, reqs[i].pipe, reqs[i].buffer,
+				   reqs[i].length, &reqs[i].act_len, timeout);
+		reqs[i].status = dev->status;
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
 
 /*-------------------------------------------------------------------
  * Max Packet stuff
@@ -742,6 +742,59 @@ static int usb_stor_BBB_transport(struct scsi_cmd *srb, struct us_data *us)
 	else
 		pipe = pipeout;
 
+	/*
+	 * For reads the data and the CSW come from the same endpoint, so
+	 * queue both at once when the host controller can do that. This
+	 * saves waiting for the data to arrive before asking for the CSW.
+	 */
+	if (dir_in) {
+		struct usb_bulk_req reqs[2] = {
+			{ .pipe = pipein, .buffer = srb->pdata,
+			  .length = srb->datalen,
+			  .status = USB_ST_NOT_PROC },
+			{ .pipe = pipein, .buffer = csw,
+			  .length = UMASS_BBB_CSW_SIZE,
+			  .status = USB_ST_NOT_PROC },
+		};
+
+		result = submit_bulk_batch(us->pusb_dev, reqs, 2);
+		if (result != -ENOSYS) {
+			data_actlen = reqs[0].act_len;
+			if (reqs[0].status & USB_ST_STALLED) {
+				debug("DATA:stall\n");
+				result = usb_stor_BBB_clear_endpt_stall(us,
+								us->ep_in);
+				if (result >= 0)
+					goto st;
+			}
+			if (reqs[0].status) {
+				debug("usb_bulk_batch data status %ld\n",
+				      reqs[0].status);
+				usb_stor_BBB_reset(us);
+				return USB_STOR_TRANSPORT_FAILED;
+			}
+			retry = 0;
+			if (reqs[1].status & USB_ST_STALLED) {
+				debug("STATUS:stall\n");
+				result = usb_stor_BBB_clear_endpt_stall(us,
+								us->ep_in);
+				if (result >= 0) {
+					retry = 1;
+					goto again;
+				}
+			}
+			if (reqs[1].status) {
+				debug("usb_bulk_batch CSW status %ld\n",
+				      reqs[1].status);
+				usb_stor_BBB_reset(us);
+				return USB_STOR_TRANSPORT_FAILED;
+			}
+			actlen = reqs[1].act_len;
+			result = 0;
+			goto csw;
+		}
+	}
+
 	result = usb_bulk_msg(us->pusb_dev, pipe, srb->pdata, srb->datalen,
 			      &data_actlen, USB_CNTL_TIMEOUT * 5);
 	/* special handling of STALL in DATA phase */
@@ -789,6 +842,7 @@ again:
 		usb_stor_BBB_reset(us);
 		return USB_STOR_TRANSPORT_FAILED;
 	}
+csw:
 #ifdef BBB_XPORT_TRACE
 	ptr = (unsigned char *)csw;
 	for (index = 0; index < UMASS_BBB_CSW_SIZE; index++)
@@ -939,6 +993,73 @@ do_retry:
 	return USB_STOR_TRANSPORT_FAILED;
 }
 
+/* Transfer size that practically every device copes with, see below */
+#define USB_STOR_SAFE_XFER_BLK		240
+
+/* Quirk flags, named after the Linux usb-storage quirk letters */
+#define US_QUIRK_MAX_XFER_64		BIT(0)	/* 'm' */
+#define US_QUIRK_MAX_XFER_240		BIT(1)	/* 'g' */
+
+struct usb_stor_quirk {
+	u16 vid;
+	u16 pid;
+	uint flags;
+};
+
+static const struct usb_stor_quirk usb_stor_quirks[] = {
+	/* ASMedia ASM1053 USB 3 SATA bridges have issues with large xfers */
+	{ 0x174c, 0x5106, US_QUIRK_MAX_XFER_240 },
+	{ 0x174c, 0x55aa, US_QUIRK_MAX_XFER_240 },
+};
+
+/*
+ * Look up the quirks of a device. Entries in the 'usb_storage_quirks'
+ * environment variable take precedence over the built-in table. It is a
+ * comma-separated list of VID:PID:flags in the same format as the Linux
+ * usb-storage.quirks parameter, e.g. "174c:55aa:g,0781:5581:m".
+ */
+static uint usb_stor_get_quirks(struct usb_device *udev)
+{
+	u16 vid = udev->descriptor.idVendor;
+	u16 pid = udev->descriptor.idProduct;
+	int i;
+#ifndef CONFIG_SPL_BUILD
+	const char *s;
+	char *end;
+	uint flags;
+
+	for (s = env_get("usb_storage_quirks"); s && *s; s++) {
+		ulong qvid, qpid;
+
+		qvid = simple_strtoul(s, &end, 16);
+		if (*end != ':')
+			break;
+		qpid = simple_strtoul(end + 1, &end, 16);
+		if (*end != ':')
+			break;
+		flags = 0;
+		for (s = end + 1; *s && *s != ','; s++) {
+			if (*s == 'm')
+				flags |= US_QUIRK_MAX_XFER_64;
+			else if (*s == 'g')
+				flags |= US_QUIRK_MAX_XFER_240;
+		}
+		if (qvid == vid && qpid == pid)
+			return flags;
+		if (!*s)
+			break;
+	}
+#endif
+
+	for (i = 0; i < ARRAY_SIZE(usb_stor_quirks); i++) {
+		if (usb_stor_quirks[i].vid == vid &&
+		    usb_stor_quirks[i].pid == pid)
+			return usb_stor_quirks[i].flags;
+	}
+
+	return 0;
+}
+
 static void usb_stor_set_max_xfer_blk(struct usb_device *udev,
 				      struct us_data *us)
 {
@@ -958,8 +1079,20 @@ static void usb_stor_set_max_xfer_blk(struct usb_device *udev,
 	 * Windows 7 limiting transfers to 128 sectors for both USB2 and USB3
 	 * and Apple Mac OS X 10.11 limiting transfers to 256 sectors for USB2
 	 * and 2048 for USB3 devices.
+	 *
+	 * So like Mac OS X we allow SuperSpeed devices more, unless they are
+	 * known not to cope. If a larger transfer fails anyway we drop back to
+	 * 240 sectors, see usb_stor_reduce_xfer().
 	 */
-	unsigned short blk = 240;
+	unsigned short blk = USB_STOR_SAFE_XFER_BLK;
+	uint quirks = usb_stor_get_quirks(udev);
+
+	if (udev->speed >= USB_SPEED_SUPER)
+		blk = CONFIG_USB_STORAGE_SS_MAX_XFER_BLK;
+	if (quirks & US_QUIRK_MAX_XFER_240)
+		blk = min_t(unsigned short, blk, 240);
+	if (quirks & US_QUIRK_MAX_XFER_64)
+		blk = min_t(unsigned short, blk, 64);
 
 #if CONFIG_IS_ENABLED(DM_USB)
 	size_t size;
@@ -970,9 +1103,30 @@ static void usb_stor_set_max_xfer_blk(struct usb_device *udev,
 		blk = size / 512;
 #endif
 
+	debug("USB storage: max transfer %u blocks (quirks %x)\n", blk,
+	      quirks);
 	us->max_xfer_blk = blk;
 }
 
+/*
+ * Called when a transfer of @blks blocks has failed. If it was larger than
+ * the safe size, assume the device cannot handle it and use the safe size
+ * from now on.
+ *
+ * @return true if the transfer size was reduced and should be retried
+ */
+static bool usb_stor_reduce_xfer(struct us_data *us, unsigned short blks)
+{
+	if (blks <= USB_STOR_SAFE_XFER_BLK)
+		return false;
+
+	printf("USB storage: %u block transfer failed, using %u blocks\n",
+	       blks, USB_STOR_SAFE_XFER_BLK);
+	us->max_xfer_blk = USB_STOR_SAFE_XFER_BLK;
+
+	return true;
+}
+
 static int usb_inquiry(struct scsi_cmd *srb, struct us_data *ss)
 {
 	int retry, i;
@@ -1185,6 +1339,10 @@ retry_it:
 		if (usb_read_10(srb, ss, start, smallblks)) {
 			debug("Read ERROR\n");
 			usb_request_sense(srb, ss);
+			if (usb_stor_reduce_xfer(ss, smallblks)) {
+				smallblks = ss->max_xfer_blk;
+				goto retry_it;
+			}
 			if (retry--)
 				goto retry_it;
 			blkcnt -= blks;
@@ -1271,6 +1429,10 @@ retry_it:
 		if (usb_write_10(srb, ss, start, smallblks)) {
 			debug("Write ERROR\n");
 			usb_request_sense(srb, ss);
+			if (usb_stor_reduce_xfer(ss, smallblks)) {
+				smallblks = ss->max_xfer_blk;
+				goto retry_it;
+			}
 			if (retry--)
 				goto retry_it;
 			blkcnt -= blks;
@@ -234,6 +234,232 @@ void dev_print (struct blk_desc *dev_desc)
 
 #ifdef HAVE_BLOCK_DEVICE
 
+#ifdef CONFIG_PARTITION_CACHE
+/*
+ * Parsed partition table of a block device. Looking up a partition by name
+ * otherwise means asking the partition driver for every entry in turn, and
+ * the EFI driver re-reads the whole GPT for each of them.
+ */
+struct part_cache_entry {
+	int part;			/* partition number (1 = first) */
+	disk_partition_t info;
+};
+
+struct part_cache {
+	int part_type;			/* table type the cache was built from */
+	lbaint_t lba;			/* device size, to catch media changes */
+	unsigned char hwpart;		/* hardware partition it belongs to */
+	bool complete;			/* all entries present (not just up to
+					   the first missing one) */
+	int count;			/* number of entries */
+	int alloc;			/* allocated entries */
+	struct part_cache_entry *ent;	/* entries, sorted by part number */
+	uint hash_mask;			/* number of hash slots - 1 */
+	u16 *hash;			/* entry index + 1, 0 if slot unused */
+};
+
+/* FNV-1a, which is plenty for a table of a few dozen short names */
+static uint part_cache_hash_name(const char *name)
+{
+	uint hash = 2166136261u;
+
+	while (*name)
+		hash = (hash ^ (uchar)*name++) * 16777619u;
+
+	return hash;
+}
+
+static void part_cache_free(struct part_cache *cache)
+{
+	free(cache->hash);
+	free(cache->ent);
+	free(cache);
+}
+
+void part_cache_invalidate(struct blk_desc *dev_desc)
+{
+	if (dev_desc->part_cache) {
+		part_cache_free(dev_desc->part_cache);
+		dev_desc->part_cache = NULL;
+	}
+}
+
+void part_cache_check_write(struct blk_desc *dev_desc, lbaint_t start,
+			    lbaint_t blkcnt)
+{
+	struct part_cache *cache = dev_desc->part_cache;
+	struct part_cache_entry *ent;
+	int i;
+
+	if (!cache)
+		return;
+
+	/*
+	 * Partition tables live outside the partitions they describe, so a
+	 * write which stays within one partition cannot change the table.
+	 */
+	for (i = 0, ent = cache->ent; i < cache->count; i++, ent++) {
+		if (start >= ent->info.start &&
+		    start + blkcnt <= ent->info.start + ent->info.size)
+			return;
+	}
+	part_cache_invalidate(dev_desc);
+}
+
+static int part_cache_add(void *priv, int part, disk_partition_t *info)
+{
+	struct part_cache *cache = priv;
+	struct part_cache_entry *ent;
+
+	if (cache->count == cache->alloc) {
+		/* No realloc() here, since it is not available in SPL */
+		ent = malloc(sizeof(*ent) * (cache->alloc + 16));
+		if (!ent)
+			return -ENOMEM;
+		memcpy(ent, cache->ent, sizeof(*ent) * cache->count);
+		free(cache->ent);
+		cache->ent = ent;
+		cache->alloc += 16;
+	}
+	ent = &cache->ent[cache->count++];
+	ent->part = part;
+	ent->info = *info;
+
+	return 0;
+}
+
+static int part_cache_build_hash(struct part_cache *cache)
+{
+	uint size = 16;
+	uint slot;
+	int i;
+
+	while (size < cache->count * 2)
+		size <<= 1;
+	cache->hash = calloc(size, sizeof(*cache->hash));
+	if (!cache->hash)
+		return -ENOMEM;
+	cache->hash_mask = size - 1;
+
+	/*
+	 * Entries are inserted in partition order with linear probing, so a
+	 * lookup finds the first of several partitions with the same name,
+	 * as a linear search would.
+	 */
+	for (i = 0; i < cache->count; i++) {
+		slot = part_cache_hash_name((char *)cache->ent[i].info.name);
+		slot &= cache->hash_mask;
+		while (cache->hash[slot])
+			slot = (slot + 1) & cache->hash_mask;
+		cache->hash[slot] = i + 1;
+	}
+
+	return 0;
+}
+
+static int part_cache_fill(struct blk_desc *dev_desc, struct part_driver *drv,
+			   struct part_cache *cache)
+{
+	disk_partition_t info;
+	int ret, i;
+
+	if (drv->get_all) {
+		ret = drv->get_all(dev_desc, part_cache_add, cache);
+		if (ret)
+			return ret;
+		cache->complete = true;
+
+		return 0;
+	}
+
+	/* Same as a search through get_info(): stop at the first gap */
+	for (i = 1; i < drv->max_entries; i++) {
+		memset(&info, '\0', sizeof(info));
+		if (drv->get_info(dev_desc, i, &info))
+			break;
+		ret = part_cache_add(cache, i, &info);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
+/**
+ * part_cache_get() - Get the partition cache of a device, filling it if needed
+ *
+ * @dev_desc:	Block device descriptor
+ * @drv:	Partition driver for the device
+ * @return cache, or NULL if it could not be built, in which case the caller
+ *	   should fall back to asking the driver
+ */
+static struct part_cache *part_cache_get(struct blk_desc *dev_desc,
+					 struct part_driver *drv)
+{
+	struct part_cache *cache = dev_desc->part_cache;
+
+	if (cache && cache->part_type == dev_desc->part_type &&
+	    cache->lba == dev_desc->lba && cache->hwpart == dev_desc->hwpart)
+		return cache;
+	part_cache_invalidate(dev_desc);
+
+	cache = calloc(1, sizeof(*cache));
+	if (!cache)
+		return NULL;
+	cache->part_type = dev_desc->part_type;
+	cache->lba = dev_desc->lba;
+	cache->hwpart = dev_desc->hwpart;
+	if (part_cache_fill(dev_desc, drv, cache) ||
+	    part_cache_build_hash(cache)) {
+		debug("%s: Cannot cache %s partition table\n", __func__,
+		      drv->name);
+		part_cache_free(cache);
+		return NULL;
+	}
+	debug("%s: Cached %d %s partitions\n", __func__, cache->count,
+	      drv->name);
+	dev_desc->part_cache = cache;
+
+	return cache;
+}
+
+static struct part_cache_entry *part_cache_find(struct part_cache *cache,
+						int part)
+{
+	int lo = 0, hi = cache->count;
+
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+
+		if (cache->ent[mid].part == part)
+			return &cache->ent[mid];
+		if (cache->ent[mid].part < part)
+			lo = mid + 1;
+		else
+			hi = mid;
+	}
+
+	return NULL;
+}
+
+static struct part_cache_entry *part_cache_find_name(struct part_cache *cache,
+						     const char *name)
+{
+	struct part_cache_entry *ent;
+	uint slot;
+
+	slot = part_cache_hash_name(name) & cache->hash_mask;
+	while (cache->hash[slot]) {
+		ent = &cache->ent[cache->hash[slot] - 1];
+		if (!strcmp(name, (char *)ent->info.name))
+			return ent;
+		slot = (slot + 1) & cache->hash_mask;
+	}
+
+	return NULL;
+}
+#endif /* CONFIG_PARTITION_CACHE */
+
 void part_init(struct blk_desc *dev_desc)
 {
 	struct part_driver *drv =
@@ -242,6 +468,7 @@ void part_init(struct blk_desc *dev_desc)
 	struct part_driver *entry;
 
 	blkcache_invalidate(dev_desc->if_type, dev_desc->devnum);
+	part_cache_invalidate(dev_desc);
 
 	dev_desc->part_type = PART_TYPE_UNKNOWN;
 	for (entry = drv; entry != drv + n_ents; entry++) {
@@ -350,6 +577,10 @@ int part_get_info(struct blk_desc *dev_desc, int part,
 {
 #ifdef HAVE_BLOCK_DEVICE
 	struct part_driver *drv;
+#ifdef CONFIG_PARTITION_CACHE
+	struct part_cache_entry *ent;
+	struct part_cache *cache;
+#endif
 
 #if CONFIG_IS_ENABLED(PARTITION_UUIDS)
 	/* The common case is no UUID support */
@@ -370,6 +601,18 @@ int part_get_info(struct blk_desc *dev_desc, int part,
 		       drv->name);
 		return -ENOSYS;
 	}
+#ifdef CONFIG_PARTITION_CACHE
+	cache = part_cache_get(dev_desc, drv);
+	if (cache) {
+		ent = part_cache_find(cache, part);
+		if (ent) {
+			*info = ent->info;
+			return 0;
+		}
+		if (cache->complete)
+			return -1;
+	}
+#endif
 	if (drv->get_info(dev_desc, part, info) == 0) {
 		PRINTF("## Valid %s partition found ##\n", drv->name);
 		return 0;
@@ -674,6 +917,41 @@ cleanup:
 	return ret;
 }
 
+static int part_find_by_name(struct blk_desc *dev_desc,
+			     struct part_driver *part_drv, const char *name,
+			     disk_partition_t *info)
+{
+	int ret, i;
+#ifdef CONFIG_PARTITION_CACHE
+	struct part_cache_entry *ent;
+	struct part_cache *cache;
+
+	cache = part_cache_get(dev_desc, part_drv);
+	if (cache) {
+		ent = part_cache_find_name(cache, name);
+		if (!ent)
+			return -1;
+		*info = ent->info;
+
+		return ent->part;
+	}
+#endif
+
+	for (i = 1; i < part_drv->max_entries; i++) {
+		ret = part_drv->get_info(dev_desc, i, info);
+		if (ret != 0) {
+			/* no more entries in table */
+			break;
+		}
+		if (strcmp(name, (const char *)info->name) == 0) {
+			/* matched */
+			return i;
+		}
+	}
+
+	return -1;
+}
+
 /*
  * For android A/B system, we append the current slot suffix quietly,
  * this takes over the responsibility of slot suffix appending from
@@ -688,7 +966,7 @@ static int part_get_info_by_name_option(struct blk_desc *dev_desc,
 	struct part_driver *part_drv;
 	const char *full_name = name;
 	int none_slot_try = 1;
-	int ret, i;
+	int ret;
 
 	part_drv = part_driver_lookup_type(dev_desc);
 	if (!part_drv)
@@ -718,17 +996,9 @@ static int part_get_info_by_name_option(struct blk_desc *dev_desc,
 
 lookup:
 	debug("## Query partition(%d): %s\n", none_slot_try, full_name);
-	for (i = 1; i < part_drv->max_entries; i++) {
-		ret = part_drv->get_info(dev_desc, i, info);
-		if (ret != 0) {
-			/* no more entries in table */
-			break;
-		}
-		if (strcmp(full_name, (const char *)info->name) == 0) {
-			/* matched */
-			return i;
-		}
-	}
+	ret = part_find_by_name(dev_desc, part_drv, full_name, info);
+	if (ret > 0)
+		return ret;
 
 	/* 2. Query partition without A/B slot suffix if above failed */
 	if (none_slot_try) {
@@ -170,6 +170,23 @@ static void print_partition_extended(struct blk_desc *dev_desc,
 }
 
 
+static void dos_pt_to_info(struct blk_desc *dev_desc, lbaint_t ext_part_sector,
+			   dos_partition_t *pt, int part_num,
+			   unsigned int disksig, disk_partition_t *info)
+{
+	info->blksz = DOS_PART_DEFAULT_SECTOR;
+	info->start = (lbaint_t)(ext_part_sector + le32_to_int(pt->start4));
+	info->size  = (lbaint_t)le32_to_int(pt->size4);
+	part_set_generic_name(dev_desc, part_num, (char *)info->name);
+	/* sprintf(info->type, "%d, pt->sys_ind); */
+	strcpy((char *)info->type, "U-Boot");
+	info->bootable = is_bootable(pt);
+#if CONFIG_IS_ENABLED(PARTITION_UUIDS)
+	sprintf(info->uuid, "%08x-%02x", disksig, part_num);
+#endif
+	info->sys_ind = pt->sys_ind;
+}
+
 /*  Print a partition that is relative to its Extended partition table
  */
 static int part_get_info_extended(struct blk_desc *dev_desc,
@@ -211,19 +228,8 @@ static int part_get_info_extended(struct blk_desc *dev_desc,
 		    (pt->sys_ind != 0) &&
 		    (part_num == which_part) &&
 		    (is_extended(pt->sys_ind) == 0)) {
-			info->blksz = DOS_PART_DEFAULT_SECTOR;
-			info->start = (lbaint_t)(ext_part_sector +
-					le32_to_int(pt->start4));
-			info->size  = (lbaint_t)le32_to_int(pt->size4);
-			part_set_generic_name(dev_desc, part_num,
-					      (char *)info->name);
-			/* sprintf(info->type, "%d, pt->sys_ind); */
-			strcpy((char *)info->type, "U-Boot");
-			info->bootable = is_bootable(pt);
-#if CONFIG_IS_ENABLED(PARTITION_UUIDS)
-			sprintf(info->uuid, "%08x-%02x", disksig, part_num);
-#endif
-			info->sys_ind = pt->sys_ind;
+			dos_pt_to_info(dev_desc, ext_part_sector, pt, part_num,
+				       disksig, info);
 			return 0;
 		}
 
@@ -265,6 +271,93 @@ static int part_get_info_extended(struct blk_desc *dev_desc,
 	return -1;
 }
 
+#ifdef CONFIG_PARTITION_CACHE
+/*  Collect all primary/logical partitions, numbered as above
+ */
+static int part_get_all_extended(struct blk_desc *dev_desc,
+				 lbaint_t ext_part_sector, lbaint_t relative,
+				 int part_num, unsigned int disksig,
+				 int (*add)(void *priv, int part,
+					    disk_partition_t *info),
+				 void *priv)
+{
+	ALLOC_CACHE_ALIGN_BUFFER(unsigned char, buffer, dev_desc->blksz);
+	disk_partition_t info;
+	dos_partition_t *pt;
+	int ret, i;
+
+	if (blk_dread(dev_desc, ext_part_sector, 1, (ulong *)buffer) != 1) {
+		printf ("** Can't read partition table on %d:" LBAFU " **\n",
+			dev_desc->devnum, ext_part_sector);
+		return -1;
+	}
+	if (buffer[DOS_PART_MAGIC_OFFSET] != 0x55 ||
+		buffer[DOS_PART_MAGIC_OFFSET + 1] != 0xaa) {
+		printf ("bad MBR sector signature 0x%02x%02x\n",
+			buffer[DOS_PART_MAGIC_OFFSET],
+			buffer[DOS_PART_MAGIC_OFFSET + 1]);
+		return -1;
+	}
+
+	/* A DOS PBR without partition table is one partition covering all */
+	if (!ext_part_sector && test_block_type(buffer) == DOS_PBR) {
+		memset(&info, '\0', sizeof(info));
+		info.start = 0;
+		info.size = dev_desc->lba;
+		info.blksz = DOS_PART_DEFAULT_SECTOR;
+		strcpy((char *)info.type, "U-Boot");
+		return add(priv, 1, &info);
+	}
+
+#if CONFIG_IS_ENABLED(PARTITION_UUIDS)
+	if (!ext_part_sector)
+		disksig = le32_to_int(&buffer[DOS_PART_DISKSIG_OFFSET]);
+#endif
+
+	pt = (dos_partition_t *) (buffer + DOS_PART_TBL_OFFSET);
+	for (i = 0; i < 4; i++, pt++) {
+		if (((pt->boot_ind & ~0x80) == 0) &&
+		    (pt->sys_ind != 0) &&
+		    (is_extended(pt->sys_ind) == 0)) {
+			memset(&info, '\0', sizeof(info));
+			dos_pt_to_info(dev_desc, ext_part_sector, pt, part_num,
+				       disksig, &info);
+			ret = add(priv, part_num, &info);
+			if (ret)
+				return ret;
+		}
+
+		if ((ext_part_sector == 0) ||
+		    (pt->sys_ind != 0 && !is_extended (pt->sys_ind)) ) {
+			part_num++;
+		}
+	}
+
+	/* Follows the first extended partition, as get_info() does */
+	pt = (dos_partition_t *) (buffer + DOS_PART_TBL_OFFSET);
+	for (i = 0; i < 4; i++, pt++) {
+		if (is_extended (pt->sys_ind)) {
+			lbaint_t lba_start
+				= le32_to_int (pt->start4) + relative;
+
+			return part_get_all_extended(dev_desc, lba_start,
+				 ext_part_sector == 0 ? lba_start : relative,
+				 part_num, disksig, add, priv);
+		}
+	}
+
+	return 0;
+}
+
+static int part_get_all_dos(struct blk_desc *dev_desc,
+			    int (*add)(void *priv, int part,
+				       disk_partition_t *info),
+			    void *priv)
+{
+	return part_get_all_extended(dev_desc, 0, 0, 1, 0, add, priv);
+}
+#endif
+
 void part_print_dos(struct blk_desc *dev_desc)
 {
 	printf("Part\tStart Sector\tNum Sectors\tUUID\t\tType\n");
@@ -302,6 +395,9 @@ U_BOOT_PART_TYPE(dos) = {
 	.part_type	= PART_TYPE_DOS,
 	.max_entries	= DOS_ENTRY_NUMBERS,
 	.get_info	= part_get_info_ptr(part_get_info_dos),
+#ifdef CONFIG_PARTITION_CACHE
+	.get_all	= part_get_all_dos,
+#endif
 	.print		= part_print_ptr(part_print_dos),
 	.test		= part_test_dos,
 };
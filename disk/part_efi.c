@@ -278,6 +278,32 @@ void part_print_efi(struct blk_desc *dev_desc)
 	return;
 }
 
+static void gpt_pte_to_info(struct blk_desc *dev_desc, gpt_entry *pte,
+			    disk_partition_t *info)
+{
+	/* The 'lbaint_t' casting may limit the maximum disk size to 2 TB */
+	info->start = (lbaint_t)le64_to_cpu(pte->starting_lba);
+	/* The ending LBA is inclusive, to calculate size, add 1 to it */
+	info->size = (lbaint_t)le64_to_cpu(pte->ending_lba) + 1
+		     - info->start;
+	info->blksz = dev_desc->blksz;
+
+	sprintf((char *)info->name, "%s", print_efiname(pte));
+	strcpy((char *)info->type, "U-Boot");
+	info->bootable = is_bootable(pte);
+#if CONFIG_IS_ENABLED(PARTITION_UUIDS)
+	uuid_bin_to_str(pte->unique_partition_guid.b, info->uuid,
+			UUID_STR_FORMAT_GUID);
+#endif
+#ifdef CONFIG_PARTITION_TYPE_GUID
+	uuid_bin_to_str(pte->partition_type_guid.b,
+			info->type_guid, UUID_STR_FORMAT_GUID);
+#endif
+
+	debug("%s: start 0x" LBAF ", size 0x" LBAF ", name %s\n", __func__,
+	      info->start, info->size, info->name);
+}
+
 int part_get_info_efi(struct blk_desc *dev_desc, int part,
 		      disk_partition_t *info)
 {
@@ -325,31 +351,51 @@ int part_get_info_efi(struct blk_desc *dev_desc, int part,
 		return -1;
 	}
 
-	/* The 'lbaint_t' casting may limit the maximum disk size to 2 TB */
-	info->start = (lbaint_t)le64_to_cpu(gpt_pte[part - 1].starting_lba);
-	/* The ending LBA is inclusive, to calculate size, add 1 to it */
-	info->size = (lbaint_t)le64_to_cpu(gpt_pte[part - 1].ending_lba) + 1
-		     - info->start;
-	info->blksz = dev_desc->blksz;
+	gpt_pte_to_info(dev_desc, &gpt_pte[part - 1], info);
 
-	sprintf((char *)info->name, "%s",
-			print_efiname(&gpt_pte[part - 1]));
-	strcpy((char *)info->type, "U-Boot");
-	info->bootable = is_bootable(&gpt_pte[part - 1]);
-#if CONFIG_IS_ENABLED(PARTITION_UUIDS)
-	uuid_bin_to_str(gpt_pte[part - 1].unique_partition_guid.b, info->uuid,
-			UUID_STR_FORMAT_GUID);
-#endif
-#ifdef CONFIG_PARTITION_TYPE_GUID
-	uuid_bin_to_str(gpt_pte[part - 1].partition_type_guid.b,
-			info->type_guid, UUID_STR_FORMAT_GUID);
-#endif
+	return 0;
+}
 
-	debug("%s: start 0x" LBAF ", size 0x" LBAF ", name %s\n", __func__,
-	      info->start, info->size, info->name);
+#ifdef CONFIG_PARTITION_CACHE
+static int part_get_all_efi(struct blk_desc *dev_desc,
+			    int (*add)(void *priv, int part,
+				       disk_partition_t *info),
+			    void *priv)
+{
+	ALLOC_CACHE_ALIGN_BUFFER_PAD(gpt_header, gpt_head, 1, dev_desc->blksz);
+	gpt_entry *gpt_pte = NULL;
+	disk_partition_t info;
+	int ret = 0;
+	u32 i;
 
-	return 0;
+	/* Always read the table here, rather than the copy kept above */
+	if (is_gpt_valid(dev_desc, GPT_PRIMARY_PARTITION_TABLE_LBA,
+			 gpt_head, &gpt_pte) != 1) {
+		printf("%s: *** ERROR: Invalid GPT ***\n", __func__);
+		if (is_gpt_valid(dev_desc, (dev_desc->lba - 1),
+				 gpt_head, &gpt_pte) != 1) {
+			printf("%s: *** ERROR: Invalid Backup GPT ***\n",
+			       __func__);
+			return -1;
+		}
+		printf("%s: ***        Using Backup GPT ***\n", __func__);
+	}
+
+	for (i = 0; i < le32_to_cpu(gpt_head->num_partition_entries); i++) {
+		if (!is_pte_valid(&gpt_pte[i]))
+			continue;
+		memset(&info, '\0', sizeof(info));
+		gpt_pte_to_info(dev_desc, &gpt_pte[i], &info);
+		ret = add(priv, i + 1, &info);
+		if (ret)
+			break;
+	}
+
+	free(gpt_pte);
+
+	return ret;
 }
+#endif
 
 #ifdef CONFIG_RKIMG_BOOTLOADER
 #if defined(CONFIG_SPL_KERNEL_BOOT) || !defined(CONFIG_SPL_BUILD)
@@ -586,10 +632,12 @@ int write_gpt_table(struct blk_desc *dev_desc,
 		goto err;
 
 	debug("GPT successfully written to block device!\n");
+	part_cache_invalidate(dev_desc);
 	return 0;
 
  err:
 	printf("** Can't write to device %d **\n", dev_desc->devnum);
+	part_cache_invalidate(dev_desc);
 	return -1;
 }
 
@@ -819,7 +867,7 @@ int gpt_restore(struct blk_desc *dev_desc, char *str_disk_guid,
 	if (ret)
 		goto err;
 
-	/* Write GPT partition table */
+	/* Write GPT partition table, which also drops the partition cache */
 	ret = write_gpt_table(dev_desc, gpt_h, gpt_e);
 
 err:
@@ -1270,6 +1318,9 @@ U_BOOT_PART_TYPE(a_efi) = {
 	.part_type	= PART_TYPE_EFI,
 	.max_entries	= GPT_ENTRY_NUMBERS,
 	.get_info	= part_get_info_ptr(part_get_info_efi),
+#ifdef CONFIG_PARTITION_CACHE
+	.get_all	= part_get_all_efi,
+#endif
 	.print		= part_print_ptr(part_print_efi),
 	.test		= part_test_efi,
 };
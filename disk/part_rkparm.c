@@ -171,6 +171,18 @@ static void part_print_rkparm(struct blk_desc *dev_desc)
 	return;
 }
 
+static void rkparm_part_to_info(struct blk_desc *dev_desc,
+				struct rkparm_part *p, disk_partition_t *info)
+{
+	info->start = p->start;
+	info->size = p->size;
+	info->blksz = dev_desc->blksz;
+
+	sprintf((char *)info->name, "%s", p->name);
+	strcpy((char *)info->type, "U-Boot");
+	info->bootable = 0;
+}
+
 static int part_get_info_rkparm(struct blk_desc *dev_desc, int idx,
 		      disk_partition_t *info)
 {
@@ -205,17 +217,45 @@ static int part_get_info_rkparm(struct blk_desc *dev_desc, int idx,
 		return -EINVAL;
 	}
 
-	info->start = p->start;
-	info->size = p->size;
-	info->blksz = dev_desc->blksz;
-
-	sprintf((char *)info->name, "%s", p->name);
-	strcpy((char *)info->type, "U-Boot");
-	info->bootable = 0;
+	rkparm_part_to_info(dev_desc, p, info);
 
 	return 0;
 }
 
+#ifdef CONFIG_PARTITION_CACHE
+static int part_get_all_rkparm(struct blk_desc *dev_desc,
+			       int (*add)(void *priv, int part,
+					  disk_partition_t *info),
+			       void *priv)
+{
+	struct list_head *node;
+	struct rkparm_part *p;
+	disk_partition_t info;
+	int part_num = 1;
+	int ret = 0;
+
+	if (list_empty(&parts_head) ||
+	    (dev_num != ((dev_desc->if_type << 8) + dev_desc->devnum))) {
+		ret = rkparm_init_param(dev_desc, &parts_head);
+		if (ret) {
+			printf("%s Invalid rkparm partition\n", __func__);
+			return -1;
+		}
+	}
+
+	list_for_each(node, &parts_head) {
+		p = list_entry(node, struct rkparm_part, node);
+		memset(&info, '\0', sizeof(info));
+		rkparm_part_to_info(dev_desc, p, &info);
+		ret = add(priv, part_num++, &info);
+		if (ret)
+			break;
+	}
+
+	return ret;
+}
+#endif
+
 static int part_test_rkparm(struct blk_desc *dev_desc)
 {
 	int ret = 0;
@@ -241,6 +281,9 @@ U_BOOT_PART_TYPE(b_rkparm) = {
 	.part_type	= PART_TYPE_RKPARM,
 	.max_entries	= RKPARM_ENTRY_NUMBERS,
 	.get_info	= part_get_info_ptr(part_get_info_rkparm),
+#ifdef CONFIG_PARTITION_CACHE
+	.get_all	= part_get_all_rkparm,
+#endif
 	.print		= part_print_ptr(part_print_rkparm),
 	.test		= part_test_rkparm,
 };
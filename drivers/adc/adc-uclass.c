@@ -262,6 +262,82 @@ try_manual:
 	return _adc_channels_single_shot(dev, channel_mask, channels);
 }
 
+/* One conversion of every selected channel, with the supply already on */
+static int adc_channels_sequence(struct udevice *dev, unsigned int channel_mask,
+				 struct adc_channel *channels)
+{
+	const struct adc_ops *ops = dev_get_driver_ops(dev);
+	unsigned int data;
+	int channel, ret;
+
+	if (ops->start_channels && ops->channels_data) {
+		ret = ops->start_channels(dev, channel_mask);
+		if (ret)
+			return ret;
+
+		return adc_channels_data(dev, channel_mask, channels);
+	}
+
+	if (!ops->start_channel)
+		return -ENOSYS;
+
+	for (channel = 0; channel <= ADC_MAX_CHANNEL; channel++) {
+		if (!((channel_mask >> channel) & 0x1))
+			continue;
+
+		ret = ops->start_channel(dev, channel);
+		if (ret)
+			return ret;
+
+		ret = adc_channel_data(dev, channel, &data);
+		if (ret)
+			return ret;
+
+		channels->id = channel;
+		channels->data = data;
+		channels++;
+	}
+
+	return 0;
+}
+
+int adc_channels_average(struct udevice *dev, unsigned int channel_mask,
+			 unsigned int samples, struct adc_channel *channels)
+{
+	struct adc_channel sample[ADC_MAX_CHANNEL + 1];
+	u32 sum[ADC_MAX_CHANNEL + 1] = { 0 };
+	int count = hweight32(channel_mask);
+	unsigned int i;
+	int j, ret;
+
+	if (!samples)
+		return -EINVAL;
+
+	ret = check_channel(dev, channel_mask, CHECK_MASK, __func__);
+	if (ret)
+		return ret;
+
+	ret = adc_supply_enable(dev);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < samples; i++) {
+		ret = adc_channels_sequence(dev, channel_mask, sample);
+		if (ret)
+			return ret;
+
+		for (j = 0; j < count; j++)
+			sum[j] += sample[j].data;
+	}
+
+	for (j = 0; j < count; j++) {
+		channels[j].id = sample[j].id;
+		channels[j].data = (sum[j] + samples / 2) / samples;
+	}
+
+	return 0;
+}
+
 #ifdef CONFIG_ADC_REQ_REGULATOR
 static int adc_vdd_platdata_update(struct udevice *dev)
 {
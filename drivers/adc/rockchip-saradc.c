@@ -12,6 +12,7 @@
 #include <dm.h>
 #include <errno.h>
 #include <asm/io.h>
+#include <linux/iopoll.h>
 
 #define SARADC_CTRL_CHN_MASK		GENMASK(2, 0)
 #define SARADC_CTRL_POWER_CTRL		BIT(3)
@@ -36,9 +37,19 @@ struct rockchip_saradc_data {
 struct rockchip_saradc_priv {
 	struct rockchip_saradc_regs		*regs;
 	int					active_channel;
+	unsigned int				active_channel_mask;
 	const struct rockchip_saradc_data	*data;
 };
 
+/* Select the channel to be used and trigger conversion */
+static void rockchip_saradc_convert(struct rockchip_saradc_priv *priv,
+				    int channel)
+{
+	writel(SARADC_CTRL_POWER_CTRL | (channel & SARADC_CTRL_CHN_MASK) |
+	       SARADC_CTRL_IRQ_ENABLE, &priv->regs->ctrl);
+	priv->active_channel = channel;
+}
+
 int rockchip_saradc_channel_data(struct udevice *dev, int channel,
 				 unsigned int *data)
 {
@@ -76,15 +87,76 @@ int rockchip_saradc_start_channel(struct udevice *dev, int channel)
 	/* 8 clock periods as delay between power up and start cmd */
 	writel(8, &priv->regs->dly_pu_soc);
 
-	/* Select the channel to be used and trigger conversion */
-	writel(SARADC_CTRL_POWER_CTRL | (channel & SARADC_CTRL_CHN_MASK) |
-	       SARADC_CTRL_IRQ_ENABLE, &priv->regs->ctrl);
+	rockchip_saradc_convert(priv, channel);
 
-	priv->active_channel = channel;
+	return 0;
+}
+
+/*
+ * The controller converts one channel per start, so a multi-channel
+ * conversion is a sequence of them: each channel is started as soon as the
+ * previous one is read, polling the status bit with no delay in between.
+ */
+int rockchip_saradc_start_channels(struct udevice *dev,
+				   unsigned int channel_mask)
+{
+	struct rockchip_saradc_priv *priv = dev_get_priv(dev);
+
+	if (channel_mask >> priv->data->num_channels) {
+		pr_err("Requested channels are invalid!");
+		return -EINVAL;
+	}
+
+	writel(8, &priv->regs->dly_pu_soc);
+	rockchip_saradc_convert(priv, __ffs(channel_mask));
+	priv->active_channel_mask = channel_mask;
 
 	return 0;
 }
 
+int rockchip_saradc_channels_data(struct udevice *dev,
+				  unsigned int channel_mask,
+				  struct adc_channel *channels)
+{
+	struct rockchip_saradc_priv *priv = dev_get_priv(dev);
+	struct adc_uclass_platdata *uc_pdata = dev_get_uclass_platdata(dev);
+	unsigned int ctrl;
+	int channel, ret = 0;
+
+	if (channel_mask != priv->active_channel_mask) {
+		pr_err("Requested channels are not active!");
+		return -EINVAL;
+	}
+
+	for (channel = 0; channel < priv->data->num_channels; channel++) {
+		if (!(channel_mask & BIT(channel)))
+			continue;
+
+		if (channel != priv->active_channel)
+			rockchip_saradc_convert(priv, channel);
+
+		ret = readl_poll_timeout(&priv->regs->ctrl, ctrl,
+					 ctrl & SARADC_CTRL_IRQ_STATUS,
+					 SARADC_TIMEOUT);
+		if (ret)
+			break;
+
+		channels->id = channel;
+		channels->data = readl(&priv->regs->data) & uc_pdata->data_mask;
+		channels++;
+
+		/* Clear the status for the next channel */
+		writel(0, &priv->regs->ctrl);
+	}
+
+	/* Power down adc */
+	writel(0, &priv->regs->ctrl);
+	priv->active_channel = -1;
+	priv->active_channel_mask = 0;
+
+	return ret;
+}
+
 int rockchip_saradc_stop(struct udevice *dev)
 {
 	struct rockchip_saradc_priv *priv = dev_get_priv(dev);
@@ -93,6 +165,7 @@ int rockchip_saradc_stop(struct udevice *dev)
 	writel(0, &priv->regs->ctrl);
 
 	priv->active_channel = -1;
+	priv->active_channel_mask = 0;
 
 	return 0;
 }
@@ -133,6 +206,7 @@ int rockchip_saradc_ofdata_to_platdata(struct udevice *dev)
 	uc_pdata->data_mask = (1 << priv->data->num_bits) - 1;;
 	uc_pdata->data_format = ADC_DATA_FORMAT_BIN;
 	uc_pdata->data_timeout_us = SARADC_TIMEOUT / 5;
+	uc_pdata->multidata_timeout_us = SARADC_TIMEOUT / 5;
 	uc_pdata->channel_mask = (1 << priv->data->num_channels) - 1;
 
 	return 0;
@@ -140,7 +214,9 @@ int rockchip_saradc_ofdata_to_platdata(struct udevice *dev)
 
 static const struct adc_ops rockchip_saradc_ops = {
 	.start_channel = rockchip_saradc_start_channel,
+	.start_channels = rockchip_saradc_start_channels,
 	.channel_data = rockchip_saradc_channel_data,
+	.channels_data = rockchip_saradc_channels_data,
 	.stop = rockchip_saradc_stop,
 };
 
@@ -9,6 +9,7 @@
 #include <dm.h>
 #include <adc.h>
 #include <sandbox-adc.h>
+#include <asm/test.h>
 
 /**
  * struct sandbox_adc_priv - sandbox ADC device's operation status and data
@@ -17,14 +18,41 @@
  * @conversion_mode   - conversion mode: single or multi-channel
  * @active_channel    - active channel number, valid for single channel mode
  * data[]             - channels data
+ * @noise             - added to and taken from the data on alternate starts
+ * @starts            - number of conversions started so far
  */
 struct sandbox_adc_priv {
 	int conversion_status;
 	int conversion_mode;
 	int active_channel_mask;
 	unsigned int data[4];
+	unsigned int noise;
+	unsigned int starts;
 };
 
+void sandbox_adc_set_noise(struct udevice *dev, unsigned int noise)
+{
+	struct sandbox_adc_priv *priv = dev_get_priv(dev);
+
+	priv->noise = noise;
+}
+
+unsigned int sandbox_adc_get_starts(struct udevice *dev)
+{
+	struct sandbox_adc_priv *priv = dev_get_priv(dev);
+
+	return priv->starts;
+}
+
+static unsigned int sandbox_adc_read(struct sandbox_adc_priv *priv,
+				     int channel)
+{
+	if (priv->starts & 1)
+		return priv->data[channel] + priv->noise;
+
+	return priv->data[channel] - min(priv->noise, priv->data[channel]);
+}
+
 int sandbox_adc_start_channel(struct udevice *dev, int channel)
 {
 	struct sandbox_adc_priv *priv = dev_get_priv(dev);
@@ -35,6 +63,7 @@ int sandbox_adc_start_channel(struct udevice *dev, int channel)
 	priv->active_channel_mask = 1 << channel;
 	/* Start conversion */
 	priv->conversion_status = SANDBOX_ADC_ACTIVE;
+	priv->starts++;
 
 	return 0;
 }
@@ -49,6 +78,7 @@ int sandbox_adc_start_channels(struct udevice *dev, unsigned int channel_mask)
 	priv->active_channel_mask = channel_mask;
 	/* Start conversion */
 	priv->conversion_status = SANDBOX_ADC_ACTIVE;
+	priv->starts++;
 
 	return 0;
 }
@@ -69,7 +99,7 @@ int sandbox_adc_channel_data(struct udevice *dev, int channel,
 	if (priv->conversion_status == SANDBOX_ADC_INACTIVE)
 		return -EIO;
 
-	*data = priv->data[channel];
+	*data = sandbox_adc_read(priv, channel);
 
 	return 0;
 }
@@ -98,7 +128,7 @@ int sandbox_adc_channels_data(struct udevice *dev, unsigned int channel_mask,
 		if (!((channel_mask >> i) & 0x1))
 			continue;
 
-		channels->data = priv->data[i];
+		channels->data = sandbox_adc_read(priv, i);
 		channels->id = i;
 		channels++;
 	}
@@ -54,7 +54,17 @@ struct ahci_uc_priv *probe_ent = NULL;
 #define WAIT_MS_FLUSH	5000
 #define WAIT_MS_LINKUP	200
 
+/*
+ * Number of blocks in each NCQ command. Several of these are in flight at
+ * once, so they can be larger than MAX_SATA_BLOCKS_READ_WRITE.
+ */
+#ifndef MAX_SATA_BLOCKS_NCQ
+#define MAX_SATA_BLOCKS_NCQ	0x800
+#endif
+
 #define AHCI_CAP_S64A BIT(31)
+#define AHCI_CAP_SNCQ BIT(30)
+#define AHCI_CAP_NCS(cap)	((((cap) >> 8) & 0x1f) + 1)
 
 __weak void __iomem *ahci_port_base(void __iomem *base, u32 port)
 {
@@ -494,11 +504,9 @@ static int ahci_init_one(struct ahci_uc_priv *uc_priv, pci_dev_t dev)
 
 #define MAX_DATA_BYTE_COUNT  (4*1024*1024)
 
-static int ahci_fill_sg(struct ahci_uc_priv *uc_priv, u8 port,
+static int ahci_fill_sg(struct ahci_uc_priv *uc_priv, struct ahci_sg *ahci_sg,
 			unsigned char *buf, int buf_len)
 {
-	struct ahci_ioports *pp = &(uc_priv->port[port]);
-	struct ahci_sg *ahci_sg = pp->cmd_tbl_sg;
 	u32 sg_count;
 	int i;
 
@@ -530,17 +538,21 @@ static int ahci_fill_sg(struct ahci_uc_priv *uc_priv, u8 port,
 }
 
 
-static void ahci_fill_cmd_slot(struct ahci_ioports *pp, u32 opts)
+static void ahci_fill_cmd_hdr(struct ahci_cmd_hdr *hdr, u32 opts, ulong tbl)
 {
-	pp->cmd_slot->opts = cpu_to_le32(opts);
-	pp->cmd_slot->status = 0;
-	pp->cmd_slot->tbl_addr = cpu_to_le32((u32)pp->cmd_tbl & 0xffffffff);
+	hdr->opts = cpu_to_le32(opts);
+	hdr->status = 0;
+	hdr->tbl_addr = cpu_to_le32((u32)tbl & 0xffffffff);
 #ifdef CONFIG_PHYS_64BIT
-	pp->cmd_slot->tbl_addr_hi =
-	    cpu_to_le32((u32)(((pp->cmd_tbl) >> 16) >> 16));
+	hdr->tbl_addr_hi = cpu_to_le32((u32)((tbl >> 16) >> 16));
 #endif
 }
 
+static void ahci_fill_cmd_slot(struct ahci_ioports *pp, u32 opts)
+{
+	ahci_fill_cmd_hdr(pp->cmd_slot, opts, pp->cmd_tbl);
+}
+
 static int wait_spinup(void __iomem *port_mmio)
 {
 	ulong start;
@@ -587,7 +599,7 @@ static int ahci_port_start(struct ahci_uc_priv *uc_priv, u8 port)
 	pp->cmd_slot =
 		(struct ahci_cmd_hdr *)(uintptr_t)virt_to_phys((void *)mem);
 	debug("cmd_slot = %p\n", pp->cmd_slot);
-	mem += (AHCI_CMD_SLOT_SZ + 224);
+	mem += AHCI_CMD_SLOT_SZ * AHCI_MAX_CMD_SLOT;
 
 	/*
 	 * Second item: Received-FIS area
@@ -606,6 +618,18 @@ static int ahci_port_start(struct ahci_uc_priv *uc_priv, u8 port)
 	pp->cmd_tbl_sg =
 			(struct ahci_sg *)(uintptr_t)virt_to_phys((void *)mem);
 
+	/*
+	 * Command tables for NCQ, so that each slot can have a command in
+	 * flight. Whether NCQ is used depends on the device, see
+	 * ata_scsiop_inquiry().
+	 */
+	pp->ncq_depth = 0;
+	if (uc_priv->cap & AHCI_CAP_SNCQ && !pp->ncq_tbl) {
+		mem = memalign(128, AHCI_NCQ_MAX_SLOT * (AHCI_CMD_TBL_SZ));
+		if (mem)
+			pp->ncq_tbl = virt_to_phys((void *)mem);
+	}
+
 	dma_addr = (ulong)pp->cmd_slot;
 	writel_with_flush(dma_addr, port_mmio + PORT_LST_ADDR);
 	writel_with_flush(dma_addr >> 32, port_mmio + PORT_LST_ADDR_HI);
@@ -656,7 +680,7 @@ static int ahci_device_data_io(struct ahci_uc_priv *uc_priv, u8 port, u8 *fis,
 
 	memcpy((unsigned char *)pp->cmd_tbl, fis, fis_len);
 
-	sg_count = ahci_fill_sg(uc_priv, port, buf, buf_len);
+	sg_count = ahci_fill_sg(uc_priv, pp->cmd_tbl_sg, buf, buf_len);
 	opts = (fis_len >> 2) | (sg_count << 16) | (is_write << 6);
 	ahci_fill_cmd_slot(pp, opts);
 
@@ -679,6 +703,148 @@ static int ahci_device_data_io(struct ahci_uc_priv *uc_priv, u8 port, u8 *fis,
 }
 
 
+/*
+ * After an NCQ error the device refuses further commands until the NCQ
+ * error log is read. Restart the port's command engine to clear the
+ * outstanding commands, then read the log.
+ */
+static void ahci_ncq_recover(struct ahci_uc_priv *uc_priv, u8 port)
+{
+	struct ahci_ioports *pp = &(uc_priv->port[port]);
+	void __iomem *port_mmio = pp->port_mmio;
+	ALLOC_CACHE_ALIGN_BUFFER(u8, log, ATA_SECT_SIZE);
+	u8 fis[20];
+	u32 cmd;
+
+	cmd = readl(port_mmio + PORT_CMD);
+	writel_with_flush(cmd & ~PORT_CMD_START, port_mmio + PORT_CMD);
+	if (waiting_for_cmd_completed(port_mmio + PORT_CMD, 500,
+				      PORT_CMD_LIST_ON))
+		debug("scsi_ahci: port %d did not stop\n", port);
+	writel(readl(port_mmio + PORT_SCR_ERR), port_mmio + PORT_SCR_ERR);
+	writel(readl(port_mmio + PORT_IRQ_STAT), port_mmio + PORT_IRQ_STAT);
+	writel_with_flush(cmd | PORT_CMD_START, port_mmio + PORT_CMD);
+
+	memset(fis, 0, sizeof(fis));
+	fis[0] = 0x27;		/* Host to device FIS. */
+	fis[1] = 1 << 7;	/* Command FIS. */
+	fis[2] = ATA_CMD_READ_LOG_EXT;
+	fis[4] = ATA_LOG_SATA_NCQ;
+	fis[7] = 1 << 6;
+	fis[12] = 1;
+	ahci_device_data_io(uc_priv, port, fis, sizeof(fis), log,
+			    ATA_SECT_SIZE, 0);
+}
+
+/*
+ * Read or write using NCQ (READ/WRITE FPDMA QUEUED), with up to
+ * pp->ncq_depth commands of MAX_SATA_BLOCKS_NCQ blocks in flight. New
+ * commands are issued as soon as slots become free.
+ */
+static int ahci_ncq_data_io(struct ahci_uc_priv *uc_priv, u8 port,
+			    lbaint_t lba, u32 blocks, u8 *buf, u8 is_write)
+{
+	struct ahci_ioports *pp = &(uc_priv->port[port]);
+	void __iomem *port_mmio = pp->port_mmio;
+	u32 len = blocks * ATA_SECT_SIZE;
+	u32 issued = 0, done, new;
+	u32 now_blocks, irq;
+	int sg_count, tag;
+	ulong start;
+	ulong tbl;
+	u8 *fis;
+
+	if ((readl(port_mmio + PORT_SCR_STAT) & 0xf) != 0x03) {
+		debug("No Link on port %d!\n", port);
+		return -EIO;
+	}
+
+	ahci_dcache_flush_range((unsigned long)buf, len);
+	writel(readl(port_mmio + PORT_IRQ_STAT), port_mmio + PORT_IRQ_STAT);
+
+	while (blocks || issued) {
+		new = 0;
+		for (tag = 0; tag < pp->ncq_depth && blocks; tag++) {
+			if (issued & BIT(tag))
+				continue;
+
+			now_blocks = min_t(u32, MAX_SATA_BLOCKS_NCQ, blocks);
+			tbl = pp->ncq_tbl + tag * (AHCI_CMD_TBL_SZ);
+			fis = (u8 *)tbl;
+			memset(fis, 0, 20);
+			fis[0] = 0x27;	/* Host to device FIS. */
+			fis[1] = 1 << 7;	/* Command FIS. */
+			fis[2] = is_write ? ATA_CMD_FPDMA_WRITE :
+				 ATA_CMD_FPDMA_READ;
+			/* Block count goes in the features registers */
+			fis[3] = now_blocks & 0xff;
+			fis[11] = (now_blocks >> 8) & 0xff;
+			fis[4] = (lba >> 0) & 0xff;
+			fis[5] = (lba >> 8) & 0xff;
+			fis[6] = (lba >> 16) & 0xff;
+			fis[7] = 1 << 6; /* device reg: set LBA mode */
+			fis[8] = (lba >> 24) & 0xff;
+#ifdef CONFIG_SYS_64BIT_LBA
+			fis[9] = (lba >> 32) & 0xff;
+			fis[10] = (lba >> 40) & 0xff;
+#endif
+			fis[12] = tag << 3;
+
+			sg_count = ahci_fill_sg(uc_priv, (struct ahci_sg *)
+						(tbl + AHCI_CMD_TBL_HDR), buf,
+						now_blocks * ATA_SECT_SIZE);
+			if (sg_count < 0)
+				goto err;
+			ahci_fill_cmd_hdr(&pp->cmd_slot[tag], 5 |
+					  (sg_count << 16) | (is_write << 6),
+					  tbl);
+			ahci_dcache_flush_range(tbl, AHCI_CMD_TBL_SZ);
+			new |= BIT(tag);
+
+			buf += now_blocks * ATA_SECT_SIZE;
+			lba += now_blocks;
+			blocks -= now_blocks;
+		}
+
+		if (new) {
+			ahci_dcache_flush_range((unsigned long)pp->cmd_slot,
+						AHCI_CMD_SLOT_SZ *
+						AHCI_MAX_CMD_SLOT);
+			writel(new, port_mmio + PORT_SCR_ACT);
+			writel_with_flush(new, port_mmio + PORT_CMD_ISSUE);
+			issued |= new;
+		}
+
+		/* Wait for at least one command to complete */
+		start = get_timer(0);
+		do {
+			irq = readl(port_mmio + PORT_IRQ_STAT);
+			if (irq & (PORT_IRQ_FATAL)) {
+				printf("scsi_ahci: NCQ error on port %d (irq %#x)\n",
+				       port, irq);
+				goto err;
+			}
+			if (get_timer(start) > WAIT_MS_DATAIO) {
+				printf("timeout exit!\n");
+				goto err;
+			}
+			done = issued & ~(readl(port_mmio + PORT_SCR_ACT) |
+					  readl(port_mmio + PORT_CMD_ISSUE));
+		} while (!done);
+		issued &= ~done;
+	}
+
+	ahci_dcache_invalidate_range((unsigned long)buf - len, len);
+
+	return 0;
+err:
+	/* Don't try NCQ again on this port */
+	ahci_ncq_recover(uc_priv, port);
+	pp->ncq_depth = 0;
+
+	return -EIO;
+}
+
 static char *ata_id_strcpy(u16 *target, u16 *src, int len)
 {
 	int i;
@@ -745,6 +911,14 @@ static int ata_scsiop_inquiry(struct ahci_uc_priv *uc_priv,
 	ata_id_strcpy((u16 *)&pccb->pdata[16], &idbuf[ATA_ID_PROD], 16);
 	ata_id_strcpy((u16 *)&pccb->pdata[32], &idbuf[ATA_ID_FW_REV], 4);
 
+	if (uc_priv->port[port].ncq_tbl && ata_id_has_ncq(idbuf)) {
+		uc_priv->port[port].ncq_depth =
+			min_t(u32, AHCI_CAP_NCS(uc_priv->cap),
+			      (idbuf[ATA_ID_QUEUE_DEPTH] & 0x1f) + 1);
+		debug("scsi_ahci: port %d NCQ depth %d\n", port,
+		      uc_priv->port[port].ncq_depth);
+	}
+
 #ifdef DEBUG
 	ata_dump_id(idbuf);
 #endif
@@ -793,6 +967,23 @@ static int ata_scsiop_read_write(struct ahci_uc_priv *uc_priv,
 	debug("scsi_ahci: %s %u blocks starting from lba 0x" LBAFU "\n",
 	      is_write ?  "write" : "read", blocks, lba);
 
+	if (uc_priv->port[pccb->target].ncq_depth) {
+		if (ATA_SECT_SIZE * blocks > user_buffer_size) {
+			printf("scsi_ahci: Error: buffer too small.\n");
+			return -EIO;
+		}
+		if (ahci_ncq_data_io(uc_priv, pccb->target, lba, blocks,
+				     user_buffer, is_write)) {
+			debug("scsi_ahci: SCSI %s10 NCQ command failure.\n",
+			      is_write ? "WRITE" : "READ");
+			return -EIO;
+		}
+		if (is_write)
+			return ata_io_flush(uc_priv, pccb->target);
+
+		return 0;
+	}
+
 	/* Preset the FIS */
 	memset(fis, 0, sizeof(fis));
 	fis[0] = 0x27;		 /* Host to device FIS. */
@@ -477,6 +477,7 @@ unsigned long blk_dwrite(struct blk_desc *block_dev, lbaint_t start,
 		return -ENOSYS;
 
 	blkcache_invalidate(block_dev->if_type, block_dev->devnum);
+	part_cache_check_write(block_dev, start, blkcnt);
 	return ops->write(dev, start, blkcnt, buffer);
 }
 
@@ -490,6 +491,7 @@ unsigned long blk_derase(struct blk_desc *block_dev, lbaint_t start,
 		return -ENOSYS;
 
 	blkcache_invalidate(block_dev->if_type, block_dev->devnum);
+	part_cache_check_write(block_dev, start, blkcnt);
 	return ops->erase(dev, start, blkcnt);
 }
 
@@ -676,8 +678,18 @@ int blk_unbind_all(int if_type)
 	return 0;
 }
 
+static int blk_pre_unbind(struct udevice *dev)
+{
+	struct blk_desc *desc = dev_get_uclass_platdata(dev);
+
+	part_cache_invalidate(desc);
+
+	return 0;
+}
+
 UCLASS_DRIVER(blk) = {
 	.id		= UCLASS_BLK,
 	.name		= "blk",
+	.pre_unbind	= blk_pre_unbind,
 	.per_device_platdata_auto_alloc_size = sizeof(struct blk_desc),
 };
@@ -55,8 +55,12 @@ static unsigned long host_block_read(struct blk_desc *block_dev,
 		return -1;
 	}
 	ssize_t len = os_read(host_dev->fd, buffer, blkcnt * block_dev->blksz);
-	if (len >= 0)
+	if (len >= 0) {
+		sandbox_storage_account(&host_dev->storage,
+					SANDBOX_STORAGE_READ,
+					(u64)start * block_dev->blksz, len);
 		return len / block_dev->blksz;
+	}
 	return -1;
 }
 
@@ -82,8 +86,12 @@ static unsigned long host_block_write(struct blk_desc *block_dev,
 		return -1;
 	}
 	ssize_t len = os_write(host_dev->fd, buffer, blkcnt * block_dev->blksz);
-	if (len >= 0)
+	if (len >= 0) {
+		sandbox_storage_account(&host_dev->storage,
+					SANDBOX_STORAGE_WRITE,
+					(u64)start * block_dev->blksz, len);
 		return len / block_dev->blksz;
+	}
 	return -1;
 }
 
@@ -158,6 +166,7 @@ int host_dev_bind(int dev, char *filename)
 	if (!host_dev)
 		return -1;
 	if (host_dev->blk_dev.priv) {
+		sandbox_storage_unregister(&host_dev->storage);
 		os_close(host_dev->fd);
 		host_dev->blk_dev.priv = NULL;
 	}
@@ -186,6 +195,9 @@ int host_dev_bind(int dev, char *filename)
 	blk_dev->block_write = host_block_write;
 	blk_dev->devnum = dev;
 	blk_dev->part_type = PART_TYPE_UNKNOWN;
+	host_dev->storage.name = host_dev->filename;
+	host_dev->storage.model = NULL;
+	sandbox_storage_register(&host_dev->storage);
 	part_init(blk_dev);
 
 	return 0;
@@ -217,7 +229,51 @@ int host_get_dev_err(int devnum, struct blk_desc **blk_devp)
 	return 0;
 }
 
+int host_dev_set_model(int devnum, const char *name)
+{
+	const struct sandbox_storage_model *model;
+	struct host_block_dev *host_dev;
+	struct blk_desc *blk_dev;
+	int ret;
+
+	ret = host_get_dev_err(devnum, &blk_dev);
+	if (ret)
+		return -ENODEV;
+	model = sandbox_storage_find_model(name);
+	if (!model)
+		return -ENOENT;
+
 #ifdef CONFIG_BLK
+	host_dev = dev_get_priv(blk_dev->bdev);
+#else
+	host_dev = blk_dev->priv;
+#endif
+	host_dev->storage.model = model;
+	memset(&host_dev->storage.stats, '\0', sizeof(host_dev->storage.stats));
+
+	return 0;
+}
+
+#ifdef CONFIG_BLK
+static int host_blk_probe(struct udevice *dev)
+{
+	struct host_block_dev *host_dev = dev_get_priv(dev);
+
+	host_dev->storage.name = dev->name;
+	sandbox_storage_register(&host_dev->storage);
+
+	return 0;
+}
+
+static int host_blk_remove(struct udevice *dev)
+{
+	struct host_block_dev *host_dev = dev_get_priv(dev);
+
+	sandbox_storage_unregister(&host_dev->storage);
+
+	return 0;
+}
+
 static const struct blk_ops sandbox_host_blk_ops = {
 	.read	= host_block_read,
 	.write	= host_block_write,
@@ -227,6 +283,8 @@ U_BOOT_DRIVER(sandbox_host_blk) = {
 	.name		= "sandbox_host_blk",
 	.id		= UCLASS_BLK,
 	.ops		= &sandbox_host_blk_ops,
+	.probe		= host_blk_probe,
+	.remove		= host_blk_remove,
 	.priv_auto_alloc_size	= sizeof(struct host_block_dev),
 };
 #else
@@ -0,0 +1,167 @@
+/*
+ * Timing model for emulated storage devices
+ *
+ * Copyright (C) 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <sandboxblockdev.h>
+#include <asm/test.h>
+#include <linux/kernel.h>
+
+/*
+ * Typical figures from datasheets; good enough to compare access patterns,
+ * not to predict the boot time of a particular board.
+ */
+static const struct sandbox_storage_model sandbox_storage_models[] = {
+	{
+		.name		= "none",
+	}, {
+		/* HS200 eMMC 5.1 */
+		.name		= "emmc",
+		.cmd_us		= 100,
+		.read_kbps	= 180 * 1024,
+		.write_kbps	= 60 * 1024,
+		.max_bytes	= 65535 * 512,
+		.queue_depth	= 1,
+	}, {
+		/* 2KiB page SPI-NAND, quad I/O at 100MHz */
+		.name		= "spi-nand",
+		.cmd_us		= 5,
+		.read_kbps	= 40 * 1024,
+		.write_kbps	= 40 * 1024,
+		.max_bytes	= 2048,
+		.queue_depth	= 1,
+		.page_size	= 2048,
+		.page_read_us	= 60,
+		.page_prog_us	= 400,
+		.erase_size	= 128 << 10,
+		.erase_us	= 3000,
+	}, {
+		/* quad SPI-NOR at 100MHz */
+		.name		= "spi-nor",
+		.cmd_us		= 1,
+		.read_kbps	= 48 * 1024,
+		.write_kbps	= 48 * 1024,
+		.queue_depth	= 1,
+		.page_size	= 256,
+		.page_prog_us	= 700,
+		.erase_size	= 4 << 10,
+		.erase_us	= 45000,
+	}, {
+		/* USB 2.0 mass storage (bulk-only transport) */
+		.name		= "usb-msc",
+		.cmd_us		= 1000,
+		.read_kbps	= 35 * 1024,
+		.write_kbps	= 25 * 1024,
+		.max_bytes	= 240 * 512,
+		.queue_depth	= 1,
+	},
+};
+
+static LIST_HEAD(sandbox_storage_head);
+
+/* Modelled time not yet added to the millisecond sandbox timer */
+static ulong sandbox_storage_pending_us;
+
+const struct sandbox_storage_model *sandbox_storage_find_model(
+							const char *name)
+{
+	int i;
+
+	for (i = 0; i < ARRAY_SIZE(sandbox_storage_models); i++) {
+		if (!strcmp(name, sandbox_storage_models[i].name))
+			return &sandbox_storage_models[i];
+	}
+
+	return NULL;
+}
+
+void sandbox_storage_register(struct sandbox_storage *storage)
+{
+	memset(&storage->stats, '\0', sizeof(storage->stats));
+	list_add_tail(&storage->sibling, &sandbox_storage_head);
+}
+
+void sandbox_storage_unregister(struct sandbox_storage *storage)
+{
+	if (storage->sibling.next)
+		list_del_init(&storage->sibling);
+}
+
+struct list_head *sandbox_storage_list(void)
+{
+	return &sandbox_storage_head;
+}
+
+/* Number of @unit-sized units touched by @len bytes at @offset */
+static u64 units_touched(u64 offset, u64 len, uint unit)
+{
+	if (!unit || !len)
+		return 0;
+
+	return DIV_ROUND_UP(offset + len, unit) - offset / unit;
+}
+
+static u64 transfer_us(u64 len, uint kbps)
+{
+	if (!kbps)
+		return 0;
+
+	return DIV_ROUND_UP(len * 1000000, (u64)kbps * 1024);
+}
+
+ulong sandbox_storage_account(struct sandbox_storage *storage,
+			      enum sandbox_storage_op op, u64 offset, u64 len)
+{
+	const struct sandbox_storage_model *model = storage->model;
+	struct sandbox_storage_stats *stats = &storage->stats;
+	u64 cmds, pages, time = 0;
+
+	switch (op) {
+	case SANDBOX_STORAGE_READ:
+		stats->reads++;
+		stats->read_bytes += len;
+		break;
+	case SANDBOX_STORAGE_WRITE:
+		stats->writes++;
+		stats->write_bytes += len;
+		break;
+	case SANDBOX_STORAGE_ERASE:
+		stats->erases++;
+		stats->erase_bytes += len;
+		break;
+	}
+	if (!model)
+		return 0;
+
+	cmds = 1;
+	if (model->max_bytes && op != SANDBOX_STORAGE_ERASE)
+		cmds = DIV_ROUND_UP(len, model->max_bytes);
+	time = DIV_ROUND_UP(cmds, max(model->queue_depth, 1U)) *
+		model->cmd_us;
+	pages = units_touched(offset, len, model->page_size);
+	switch (op) {
+	case SANDBOX_STORAGE_READ:
+		time += transfer_us(len, model->read_kbps);
+		time += pages * model->page_read_us;
+		break;
+	case SANDBOX_STORAGE_WRITE:
+		time += transfer_us(len, model->write_kbps);
+		time += pages * model->page_prog_us;
+		break;
+	case SANDBOX_STORAGE_ERASE:
+		time += units_touched(offset, len, model->erase_size) *
+			model->erase_us;
+		break;
+	}
+	stats->time_us += time;
+
+	sandbox_storage_pending_us += time;
+	sandbox_timer_add_offset(sandbox_storage_pending_us / 1000);
+	sandbox_storage_pending_us %= 1000;
+
+	return time;
+}
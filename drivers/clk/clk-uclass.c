@@ -15,6 +15,102 @@
 #include <dm/read.h>
 #include <dt-structs.h>
 #include <errno.h>
+#include <malloc.h>
+
+#if CONFIG_IS_ENABLED(CLK_RATE_CACHE)
+#define CLK_RATE_CACHE_SIZE	32
+
+struct clk_rate_entry {
+	struct udevice *dev;
+	ulong id;
+	ulong rate;
+};
+
+/**
+ * struct clk_uc_priv - clk uclass private data
+ *
+ * Rates read through clk_get_rate() are kept until the next rate or parent
+ * change of any clock. Clocks feed each other across providers, so a change
+ * anywhere drops the whole cache.
+ *
+ * @cache:	cached rates
+ * @count:	number of valid entries in @cache
+ * @next:	entry to replace when @cache is full
+ */
+struct clk_uc_priv {
+	struct clk_rate_entry cache[CLK_RATE_CACHE_SIZE];
+	int count;
+	int next;
+};
+
+static struct clk_uc_priv *clk_uc_priv(void)
+{
+	struct uclass *uc;
+
+	if (uclass_get(UCLASS_CLK, &uc))
+		return NULL;
+
+	return uc->priv;
+}
+
+static bool clk_rate_cache_get(struct clk *clk, ulong *ratep)
+{
+	struct clk_uc_priv *priv = clk_uc_priv();
+	struct clk_rate_entry *e;
+	int i;
+
+	if (!priv)
+		return false;
+
+	for (i = 0; i < priv->count; i++) {
+		e = &priv->cache[i];
+		if (e->dev == clk->dev && e->id == clk->id) {
+			*ratep = e->rate;
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static void clk_rate_cache_put(struct clk *clk, ulong rate)
+{
+	struct clk_uc_priv *priv = clk_uc_priv();
+	struct clk_rate_entry *e;
+
+	if (!priv)
+		return;
+
+	if (priv->count < CLK_RATE_CACHE_SIZE) {
+		e = &priv->cache[priv->count++];
+	} else {
+		e = &priv->cache[priv->next];
+		priv->next = (priv->next + 1) % CLK_RATE_CACHE_SIZE;
+	}
+
+	e->dev = clk->dev;
+	e->id = clk->id;
+	e->rate = rate;
+}
+
+static void clk_rate_cache_invalidate(void)
+{
+	struct clk_uc_priv *priv = clk_uc_priv();
+
+	if (priv) {
+		priv->count = 0;
+		priv->next = 0;
+	}
+}
+#else
+static inline bool clk_rate_cache_get(struct clk *clk, ulong *ratep)
+{
+	return false;
+}
+
+static inline void clk_rate_cache_put(struct clk *clk, ulong rate) {}
+static inline void clk_rate_cache_invalidate(void) {}
+#endif
 
 static inline const struct clk_ops *clk_dev_ops(struct udevice *dev)
 {
@@ -191,45 +287,77 @@ static int clk_set_default_parents(struct udevice *dev)
 
 static int clk_set_default_rates(struct udevice *dev)
 {
-	struct clk clk;
+	struct clk *clks;
+	ulong *rates;
+	u32 *values;
 	int index;
 	int num_rates;
+	int count, i, j;
 	int size;
 	int ret = 0;
-	u32 *rates = NULL;
 
 	size = dev_read_size(dev, "assigned-clock-rates");
 	if (size < 0)
 		return 0;
 
 	num_rates = size / sizeof(u32);
-	rates = calloc(num_rates, sizeof(u32));
-	if (!rates)
-		return -ENOMEM;
+	values = calloc(num_rates, sizeof(u32));
+	clks = calloc(num_rates, sizeof(*clks));
+	rates = calloc(num_rates, sizeof(*rates));
+	if (!values || !clks || !rates) {
+		ret = -ENOMEM;
+		goto fail;
+	}
 
-	ret = dev_read_u32_array(dev, "assigned-clock-rates", rates, num_rates);
+	ret = dev_read_u32_array(dev, "assigned-clock-rates", values,
+				 num_rates);
 	if (ret)
 		goto fail;
 
+	count = 0;
 	for (index = 0; index < num_rates; index++) {
 		ret = clk_get_by_indexed_prop(dev, "assigned-clocks",
-					      index, &clk);
+					      index, &clks[count]);
 		if (ret) {
 			debug("%s: could not get assigned clock %d for %s\n",
 			      __func__, index, dev_read_name(dev));
 			continue;
 		}
 
-		ret = clk_set_rate(&clk, rates[index]);
-		if (ret < 0) {
-			debug("%s: failed to set rate on clock %d for %s\n",
-			      __func__, index, dev_read_name(dev));
-			continue;
+		/* Only the last rate given for a clock matters */
+		for (i = 0; i < count; i++) {
+			if (clks[i].dev == clks[count].dev &&
+			    clks[i].id == clks[count].id)
+				break;
+		}
+		if (i < count) {
+			memmove(&clks[i], &clks[i + 1],
+				(count - i) * sizeof(*clks));
+			memmove(&rates[i], &rates[i + 1],
+				(count - i - 1) * sizeof(*rates));
+			count--;
 		}
+
+		rates[count++] = values[index];
+	}
+
+	/* Hand each run of clocks from one provider over in a single call */
+	ret = 0;
+	for (i = 0; i < count; i = j) {
+		for (j = i + 1; j < count && clks[j].dev == clks[i].dev; j++)
+			;
+
+		ret = clk_set_rates(&clks[i], &rates[i], j - i);
+		if (ret)
+			debug("%s: failed to set rates of %s for %s: %d\n",
+			      __func__, clks[i].dev->name, dev_read_name(dev),
+			      ret);
 	}
 
 fail:
 	free(rates);
+	free(clks);
+	free(values);
 	return ret;
 }
 
@@ -326,13 +454,21 @@ int clk_free(struct clk *clk)
 ulong clk_get_rate(struct clk *clk)
 {
 	const struct clk_ops *ops = clk_dev_ops(clk->dev);
+	ulong rate;
 
 	debug("%s(clk=%p)\n", __func__, clk);
 
 	if (!ops->get_rate)
 		return -ENOSYS;
 
-	return ops->get_rate(clk);
+	if (clk_rate_cache_get(clk, &rate))
+		return rate;
+
+	rate = ops->get_rate(clk);
+	if (!IS_ERR_VALUE(rate))
+		clk_rate_cache_put(clk, rate);
+
+	return rate;
 }
 
 ulong clk_set_rate(struct clk *clk, ulong rate)
@@ -344,9 +480,41 @@ ulong clk_set_rate(struct clk *clk, ulong rate)
 	if (!ops->set_rate)
 		return -ENOSYS;
 
+	clk_rate_cache_invalidate();
+
 	return ops->set_rate(clk, rate);
 }
 
+int clk_set_rates(struct clk *clks, const ulong *rates, int count)
+{
+	const struct clk_ops *ops;
+	ulong ret;
+	int i, err = 0;
+
+	if (!count)
+		return 0;
+
+	ops = clk_dev_ops(clks[0].dev);
+	if (ops->set_rates) {
+		clk_rate_cache_invalidate();
+		err = ops->set_rates(clks, rates, count);
+		if (err != -ENOSYS)
+			return err;
+		err = 0;
+	}
+
+	for (i = 0; i < count; i++) {
+		ret = clk_set_rate(&clks[i], rates[i]);
+		if (IS_ERR_VALUE(ret)) {
+			debug("%s: failed to set clock %lu to %lu\n",
+			      __func__, clks[i].id, rates[i]);
+			err = ret;
+		}
+	}
+
+	return err;
+}
+
 int clk_get_phase(struct clk *clk)
 {
 	const struct clk_ops *ops = clk_dev_ops(clk->dev);
@@ -376,6 +544,8 @@ int clk_set_parent(struct clk *clk, struct clk *parent)
 	if (!ops->set_parent)
 		return -ENOSYS;
 
+	clk_rate_cache_invalidate();
+
 	return ops->set_parent(clk, parent);
 }
 
@@ -448,7 +618,21 @@ int clks_probe(void)
 	return 0;
 }
 
+#if CONFIG_IS_ENABLED(CLK_RATE_CACHE)
+static int clk_uclass_pre_remove(struct udevice *dev)
+{
+	/* Do not hand out rates for a device that may be replaced */
+	clk_rate_cache_invalidate();
+
+	return 0;
+}
+#endif
+
 UCLASS_DRIVER(clk) = {
 	.id		= UCLASS_CLK,
 	.name		= "clk",
+#if CONFIG_IS_ENABLED(CLK_RATE_CACHE)
+	.pre_remove	= clk_uclass_pre_remove,
+	.priv_auto_alloc_size = sizeof(struct clk_uc_priv),
+#endif
 };
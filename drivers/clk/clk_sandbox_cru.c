@@ -0,0 +1,205 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ *
+ * A small clock unit for testing the clk uclass on sandbox: two PLLs, each
+ * feeding one integer divider. A PLL that has been programmed must be waited
+ * on before its divider may be changed, like on a real CRU.
+ */
+
+#include <common.h>
+#include <clk-uclass.h>
+#include <dm.h>
+#include <errno.h>
+#include <asm/clk.h>
+
+#define SANDBOX_CLK_CRU_NUM_PLLS	2
+#define SANDBOX_CLK_CRU_OSC_HZ		24000000
+#define SANDBOX_CLK_CRU_DIV_MAX		256
+
+struct sandbox_clk_cru_priv {
+	ulong pll_rate[SANDBOX_CLK_CRU_NUM_PLLS];
+	bool lock_pending[SANDBOX_CLK_CRU_NUM_PLLS];
+	uint div[SANDBOX_CLK_CRU_NUM_PLLS];
+	bool defer_lock;
+	uint get_rate_count;
+	uint pll_program_count;
+	uint lock_wait_count;
+};
+
+static int sandbox_clk_cru_pll(ulong id)
+{
+	switch (id) {
+	case SANDBOX_CLK_CRU_ID_PLL0:
+	case SANDBOX_CLK_CRU_ID_DIV0:
+		return 0;
+	case SANDBOX_CLK_CRU_ID_PLL1:
+	case SANDBOX_CLK_CRU_ID_DIV1:
+		return 1;
+	default:
+		return -EINVAL;
+	}
+}
+
+static bool sandbox_clk_cru_is_pll(ulong id)
+{
+	return id == SANDBOX_CLK_CRU_ID_PLL0 || id == SANDBOX_CLK_CRU_ID_PLL1;
+}
+
+static void sandbox_clk_cru_wait_lock(struct sandbox_clk_cru_priv *priv)
+{
+	bool pending = false;
+	int i;
+
+	for (i = 0; i < SANDBOX_CLK_CRU_NUM_PLLS; i++) {
+		pending |= priv->lock_pending[i];
+		priv->lock_pending[i] = false;
+	}
+
+	/* PLLs programmed together lock together */
+	if (pending)
+		priv->lock_wait_count++;
+}
+
+static ulong sandbox_clk_cru_get_rate(struct clk *clk)
+{
+	struct sandbox_clk_cru_priv *priv = dev_get_priv(clk->dev);
+	int pll = sandbox_clk_cru_pll(clk->id);
+
+	if (pll < 0)
+		return pll;
+
+	priv->get_rate_count++;
+	if (sandbox_clk_cru_is_pll(clk->id))
+		return priv->pll_rate[pll];
+
+	return priv->pll_rate[pll] / priv->div[pll];
+}
+
+static ulong sandbox_clk_cru_set_rate(struct clk *clk, ulong rate)
+{
+	struct sandbox_clk_cru_priv *priv = dev_get_priv(clk->dev);
+	int pll = sandbox_clk_cru_pll(clk->id);
+	uint div;
+
+	if (pll < 0)
+		return pll;
+	if (!rate)
+		return -EINVAL;
+
+	if (sandbox_clk_cru_is_pll(clk->id)) {
+		if (priv->pll_rate[pll] == rate)
+			return rate;
+
+		priv->pll_rate[pll] = rate;
+		priv->lock_pending[pll] = true;
+		priv->pll_program_count++;
+		if (!priv->defer_lock)
+			sandbox_clk_cru_wait_lock(priv);
+
+		return rate;
+	}
+
+	if (priv->lock_pending[pll])
+		return -EBUSY;
+
+	div = DIV_ROUND_UP(priv->pll_rate[pll], rate);
+	priv->div[pll] = clamp(div, 1U, (uint)SANDBOX_CLK_CRU_DIV_MAX);
+
+	return priv->pll_rate[pll] / priv->div[pll];
+}
+
+static int sandbox_clk_cru_set_rates(struct clk *clks, const ulong *rates,
+				     int count)
+{
+	struct sandbox_clk_cru_priv *priv = dev_get_priv(clks[0].dev);
+	ulong rate;
+	int i, ret = 0;
+
+	priv->defer_lock = true;
+	for (i = 0; i < count; i++) {
+		if (!sandbox_clk_cru_is_pll(clks[i].id))
+			continue;
+
+		rate = sandbox_clk_cru_set_rate(&clks[i], rates[i]);
+		if (IS_ERR_VALUE(rate))
+			ret = rate;
+	}
+	priv->defer_lock = false;
+	sandbox_clk_cru_wait_lock(priv);
+
+	for (i = 0; i < count; i++) {
+		if (sandbox_clk_cru_is_pll(clks[i].id))
+			continue;
+
+		rate = sandbox_clk_cru_set_rate(&clks[i], rates[i]);
+		if (IS_ERR_VALUE(rate))
+			ret = rate;
+	}
+
+	return ret;
+}
+
+static struct clk_ops sandbox_clk_cru_ops = {
+	.get_rate	= sandbox_clk_cru_get_rate,
+	.set_rate	= sandbox_clk_cru_set_rate,
+	.set_rates	= sandbox_clk_cru_set_rates,
+};
+
+static int sandbox_clk_cru_probe(struct udevice *dev)
+{
+	struct sandbox_clk_cru_priv *priv = dev_get_priv(dev);
+	int i;
+
+	for (i = 0; i < SANDBOX_CLK_CRU_NUM_PLLS; i++) {
+		priv->pll_rate[i] = SANDBOX_CLK_CRU_OSC_HZ;
+		priv->div[i] = 1;
+	}
+
+	return clk_set_defaults(dev);
+}
+
+static const struct udevice_id sandbox_clk_cru_ids[] = {
+	{ .compatible = "sandbox,clk-cru" },
+	{ }
+};
+
+U_BOOT_DRIVER(clk_sandbox_cru) = {
+	.name		= "clk_sandbox_cru",
+	.id		= UCLASS_CLK,
+	.of_match	= sandbox_clk_cru_ids,
+	.ops		= &sandbox_clk_cru_ops,
+	.probe		= sandbox_clk_cru_probe,
+	.priv_auto_alloc_size = sizeof(struct sandbox_clk_cru_priv),
+};
+
+uint sandbox_clk_cru_get_rate_count(struct udevice *dev)
+{
+	struct sandbox_clk_cru_priv *priv = dev_get_priv(dev);
+
+	return priv->get_rate_count;
+}
+
+uint sandbox_clk_cru_pll_program_count(struct udevice *dev)
+{
+	struct sandbox_clk_cru_priv *priv = dev_get_priv(dev);
+
+	return priv->pll_program_count;
+}
+
+uint sandbox_clk_cru_lock_wait_count(struct udevice *dev)
+{
+	struct sandbox_clk_cru_priv *priv = dev_get_priv(dev);
+
+	return priv->lock_wait_count;
+}
+
+void sandbox_clk_cru_reset_counts(struct udevice *dev)
+{
+	struct sandbox_clk_cru_priv *priv = dev_get_priv(dev);
+
+	priv->get_rate_count = 0;
+	priv->pll_program_count = 0;
+	priv->lock_wait_count = 0;
+}
@@ -245,12 +245,37 @@ rockchip_get_pll_settings(struct rockchip_pll_clock *pll, ulong rate)
 	}
 }
 
+static void rk3036_pll_finish(struct rockchip_pll_clock *pll,
+			      void __iomem *base, ulong pll_id)
+{
+	int timeout = 100;
+
+	/* waiting for pll lock */
+	while ((timeout > 0) && !(readl(base + pll->con_offset + 0x4) & (1 << pll->lock_shift))) {
+		udelay(1);
+		timeout--;
+	}
+
+	if (!(readl(base + pll->con_offset + 0x4) & (1 << pll->lock_shift)))
+		printf("%s: wait pll lock timeout! pll_id=%ld\n", __func__, pll_id);
+
+	if (!(pll->pll_flags & ROCKCHIP_PLL_FIXED_MODE)) {
+		rk_clrsetreg(base + pll->mode_offset, pll->mode_mask << pll->mode_shift,
+			     RKCLK_PLL_MODE_NORMAL << pll->mode_shift);
+	}
+
+	debug("PLL at %p: con0=%x con1= %x con2= %x mode= %x\n",
+	      pll, readl(base + pll->con_offset),
+	      readl(base + pll->con_offset + 0x4),
+	      readl(base + pll->con_offset + 0x8),
+	      readl(base + pll->mode_offset));
+}
+
 static int rk3036_pll_set_rate(struct rockchip_pll_clock *pll,
 			       void __iomem *base, ulong pll_id,
 			       ulong drate)
 {
 	const struct rockchip_pll_rate_table *rate;
-	int timeout = 100;
 
 	rate = rockchip_get_pll_settings(pll, drate);
 	if (!rate) {
@@ -301,25 +326,12 @@ static int rk3036_pll_set_rate(struct rockchip_pll_clock *pll,
 	rk_clrreg(base + pll->con_offset + 0x4,
 		  1 << RK3036_PLLCON1_PWRDOWN_SHIT);
 
-	/* waiting for pll lock */
-	while ((timeout > 0) && !(readl(base + pll->con_offset + 0x4) & (1 << pll->lock_shift))) {
-		udelay(1);
-		timeout--;
+	if (pll->pll_flags & ROCKCHIP_PLL_DEFER_LOCK) {
+		pll->pll_flags |= ROCKCHIP_PLL_LOCK_PENDING;
+		return 0;
 	}
 
-	if (!(readl(base + pll->con_offset + 0x4) & (1 << pll->lock_shift)))
-		printf("%s: wait pll lock timeout! pll_id=%ld\n", __func__, pll_id);
-
-	if (!(pll->pll_flags & ROCKCHIP_PLL_FIXED_MODE)) {
-		rk_clrsetreg(base + pll->mode_offset, pll->mode_mask << pll->mode_shift,
-			     RKCLK_PLL_MODE_NORMAL << pll->mode_shift);
-	}
-
-	debug("PLL at %p: con0=%x con1= %x con2= %x mode= %x\n",
-	      pll, readl(base + pll->con_offset),
-	      readl(base + pll->con_offset + 0x4),
-	      readl(base + pll->con_offset + 0x8),
-	      readl(base + pll->mode_offset));
+	rk3036_pll_finish(pll, base, pll_id);
 
 	return 0;
 }
@@ -398,6 +410,66 @@ static ulong rk3036_pll_get_rate(struct rockchip_pll_clock *pll,
 #define RK3588_CORE_B02_DIV_SHIFT	8
 #define RK3588_CORE_B13_DIV_SHIFT	0
 
+static void rk3588_pll_finish(struct rockchip_pll_clock *pll,
+			      void __iomem *base, ulong pll_id)
+{
+	/* waiting for pll lock */
+	while (!(readl(base + pll->con_offset + RK3588_PLLCON(6)) &
+		RK3588_PLLCON6_LOCK_STATUS)) {
+		udelay(1);
+		debug("%s: wait pll lock, pll_id=%ld\n", __func__, pll_id);
+	}
+
+	rk_clrsetreg(base + pll->mode_offset, pll->mode_mask << pll->mode_shift,
+		     RKCLK_PLL_MODE_NORMAL << pll->mode_shift);
+	if (pll_id == 0) {
+		rk_clrsetreg(base + RK3588_B0PLL_CLKSEL_CON(0),
+			     pll->mode_mask << 6,
+			     2 << 6);
+		rk_clrsetreg(base + RK3588_B0PLL_CLKSEL_CON(0),
+			     RK3588_CORE_DIV_MASK << RK3588_CORE_B02_DIV_SHIFT,
+			     0 << RK3588_CORE_B02_DIV_SHIFT);
+		rk_clrsetreg(base + RK3588_B0PLL_CLKSEL_CON(1),
+			     RK3588_CORE_DIV_MASK << RK3588_CORE_B13_DIV_SHIFT,
+			     0 << RK3588_CORE_B13_DIV_SHIFT);
+	} else if (pll_id == 1) {
+		rk_clrsetreg(base + RK3588_B1PLL_CLKSEL_CON(0),
+			     pll->mode_mask << 6,
+			     2 << 6);
+		rk_clrsetreg(base + RK3588_B1PLL_CLKSEL_CON(0),
+			     RK3588_CORE_DIV_MASK << RK3588_CORE_B02_DIV_SHIFT,
+			     0 << RK3588_CORE_B02_DIV_SHIFT);
+		rk_clrsetreg(base + RK3588_B1PLL_CLKSEL_CON(1),
+			     RK3588_CORE_DIV_MASK << RK3588_CORE_B13_DIV_SHIFT,
+			     0 << RK3588_CORE_B13_DIV_SHIFT);
+	} else if (pll_id == 2) {
+		rk_clrsetreg(base + RK3588_LPLL_CLKSEL_CON(5),
+			     pll->mode_mask << 14,
+			     2 << 14);
+		rk_clrsetreg(base + RK3588_LPLL_CLKSEL_CON(6),
+			     RK3588_CORE_DIV_MASK << RK3588_CORE_L13_DIV_SHIFT,
+			     0 << RK3588_CORE_L13_DIV_SHIFT);
+		rk_clrsetreg(base + RK3588_LPLL_CLKSEL_CON(6),
+			     RK3588_CORE_DIV_MASK << RK3588_CORE_L02_DIV_SHIFT,
+			     0 << RK3588_CORE_L02_DIV_SHIFT);
+		rk_clrsetreg(base + RK3588_LPLL_CLKSEL_CON(7),
+			     RK3588_CORE_DIV_MASK << RK3588_CORE_L13_DIV_SHIFT,
+			     0 << RK3588_CORE_L13_DIV_SHIFT);
+		rk_clrsetreg(base + RK3588_LPLL_CLKSEL_CON(7),
+			     RK3588_CORE_DIV_MASK << RK3588_CORE_L02_DIV_SHIFT,
+			     0 << RK3588_CORE_L02_DIV_SHIFT);
+	}
+
+	if (pll_id == 3)
+		rk_clrsetreg(base + 0x84c, 0x1 << 1, 0);
+
+	debug("PLL at %p: con0=%x con1= %x con2= %x mode= %x\n",
+	      pll, readl(base + pll->con_offset),
+	      readl(base + pll->con_offset + 0x4),
+	      readl(base + pll->con_offset + 0x8),
+	      readl(base + pll->mode_offset));
+}
+
 static int rk3588_pll_set_rate(struct rockchip_pll_clock *pll,
 			       void __iomem *base, ulong pll_id,
 			       ulong drate)
@@ -457,61 +529,12 @@ static int rk3588_pll_set_rate(struct rockchip_pll_clock *pll,
 	rk_clrreg(base + pll->con_offset + RK3588_PLLCON(1),
 		  RK3588_PLLCON1_PWRDOWN);
 
-	/* waiting for pll lock */
-	while (!(readl(base + pll->con_offset + RK3588_PLLCON(6)) &
-		RK3588_PLLCON6_LOCK_STATUS)) {
-		udelay(1);
-		debug("%s: wait pll lock, pll_id=%ld\n", __func__, pll_id);
-	}
-
-	rk_clrsetreg(base + pll->mode_offset, pll->mode_mask << pll->mode_shift,
-		     RKCLK_PLL_MODE_NORMAL << pll->mode_shift);
-	if (pll_id == 0) {
-		rk_clrsetreg(base + RK3588_B0PLL_CLKSEL_CON(0),
-			     pll->mode_mask << 6,
-			     2 << 6);
-		rk_clrsetreg(base + RK3588_B0PLL_CLKSEL_CON(0),
-			     RK3588_CORE_DIV_MASK << RK3588_CORE_B02_DIV_SHIFT,
-			     0 << RK3588_CORE_B02_DIV_SHIFT);
-		rk_clrsetreg(base + RK3588_B0PLL_CLKSEL_CON(1),
-			     RK3588_CORE_DIV_MASK << RK3588_CORE_B13_DIV_SHIFT,
-			     0 << RK3588_CORE_B13_DIV_SHIFT);
-	} else if (pll_id == 1) {
-		rk_clrsetreg(base + RK3588_B1PLL_CLKSEL_CON(0),
-			     pll->mode_mask << 6,
-			     2 << 6);
-		rk_clrsetreg(base + RK3588_B1PLL_CLKSEL_CON(0),
-			     RK3588_CORE_DIV_MASK << RK3588_CORE_B02_DIV_SHIFT,
-			     0 << RK3588_CORE_B02_DIV_SHIFT);
-		rk_clrsetreg(base + RK3588_B1PLL_CLKSEL_CON(1),
-			     RK3588_CORE_DIV_MASK << RK3588_CORE_B13_DIV_SHIFT,
-			     0 << RK3588_CORE_B13_DIV_SHIFT);
-	} else if (pll_id == 2) {
-		rk_clrsetreg(base + RK3588_LPLL_CLKSEL_CON(5),
-			     pll->mode_mask << 14,
-			     2 << 14);
-		rk_clrsetreg(base + RK3588_LPLL_CLKSEL_CON(6),
-			     RK3588_CORE_DIV_MASK << RK3588_CORE_L13_DIV_SHIFT,
-			     0 << RK3588_CORE_L13_DIV_SHIFT);
-		rk_clrsetreg(base + RK3588_LPLL_CLKSEL_CON(6),
-			     RK3588_CORE_DIV_MASK << RK3588_CORE_L02_DIV_SHIFT,
-			     0 << RK3588_CORE_L02_DIV_SHIFT);
-		rk_clrsetreg(base + RK3588_LPLL_CLKSEL_CON(7),
-			     RK3588_CORE_DIV_MASK << RK3588_CORE_L13_DIV_SHIFT,
-			     0 << RK3588_CORE_L13_DIV_SHIFT);
-		rk_clrsetreg(base + RK3588_LPLL_CLKSEL_CON(7),
-			     RK3588_CORE_DIV_MASK << RK3588_CORE_L02_DIV_SHIFT,
-			     0 << RK3588_CORE_L02_DIV_SHIFT);
+	if (pll->pll_flags & ROCKCHIP_PLL_DEFER_LOCK) {
+		pll->pll_flags |= ROCKCHIP_PLL_LOCK_PENDING;
+		return 0;
 	}
 
-	if (pll_id == 3)
-		rk_clrsetreg(base + 0x84c, 0x1 << 1, 0);
-
-	debug("PLL at %p: con0=%x con1= %x con2= %x mode= %x\n",
-	      pll, readl(base + pll->con_offset),
-	      readl(base + pll->con_offset + 0x4),
-	      readl(base + pll->con_offset + 0x8),
-	      readl(base + pll->mode_offset));
+	rk3588_pll_finish(pll, base, pll_id);
 
 	return 0;
 }
@@ -619,6 +642,30 @@ int rockchip_pll_set_rate(struct rockchip_pll_clock *pll,
 	return ret;
 }
 
+int rockchip_pll_wait_lock(struct rockchip_pll_clock *pll,
+			   void __iomem *base, ulong pll_id)
+{
+	int ret = 0;
+
+	if (pll->pll_flags & ROCKCHIP_PLL_LOCK_PENDING) {
+		switch (pll->type) {
+		case pll_rk3036:
+		case pll_rk3328:
+			rk3036_pll_finish(pll, base, pll_id);
+			break;
+		case pll_rk3588:
+			rk3588_pll_finish(pll, base, pll_id);
+			break;
+		default:
+			ret = -EINVAL;
+		}
+	}
+	pll->pll_flags &= ~(ROCKCHIP_PLL_DEFER_LOCK |
+			    ROCKCHIP_PLL_LOCK_PENDING);
+
+	return ret;
+}
+
 const struct rockchip_cpu_rate_table *
 rockchip_get_cpu_settings(struct rockchip_cpu_rate_table *cpu_table,
 			  ulong rate)
@@ -2009,9 +2009,102 @@ static int rk3588_clk_set_parent(struct clk *clk, struct clk *parent)
 }
 #endif
 
+static int rk3588_clk_pll_index(ulong clk_id)
+{
+	switch (clk_id) {
+	case PLL_CPLL:
+		return CPLL;
+	case PLL_GPLL:
+		return GPLL;
+	case PLL_NPLL:
+		return NPLL;
+	case PLL_V0PLL:
+		return V0PLL;
+	case PLL_AUPLL:
+		return AUPLL;
+	case PLL_PPLL:
+		return PPLL;
+	default:
+		return -ENOENT;
+	}
+}
+
+/*
+ * rk3588_clk_set_rate() caches a PLL's rate as soon as it is programmed,
+ * which with ROCKCHIP_PLL_DEFER_LOCK is still the slow mode rate
+ */
+static void rk3588_clk_update_pll_rate(struct rk3588_clk_priv *priv, int pll)
+{
+	ulong rate = rockchip_pll_get_rate(&rk3588_pll_clks[pll], priv->cru,
+					   pll);
+
+	switch (pll) {
+	case CPLL:
+		priv->cpll_hz = rate;
+		break;
+	case GPLL:
+		priv->gpll_hz = rate;
+		break;
+	case V0PLL:
+		priv->v0pll_hz = rate;
+		break;
+	case AUPLL:
+		priv->aupll_hz = rate;
+		break;
+	case PPLL:
+		priv->ppll_hz = rate;
+		break;
+	}
+}
+
+static int rk3588_clk_set_rates(struct clk *clks, const ulong *rates,
+				int count)
+{
+	struct rk3588_clk_priv *priv = dev_get_priv(clks[0].dev);
+	ulong rate;
+	int i, pll, ret = 0;
+
+	/*
+	 * Program all PLLs before waiting for any of them, so they lock in
+	 * parallel. The dividers below are set once their parents are stable
+	 * and their rates have been read back.
+	 */
+	for (i = 0; i < count; i++) {
+		pll = rk3588_clk_pll_index(clks[i].id);
+		if (pll < 0)
+			continue;
+
+		rk3588_pll_clks[pll].pll_flags |= ROCKCHIP_PLL_DEFER_LOCK;
+		rate = rk3588_clk_set_rate(&clks[i], rates[i]);
+		if (IS_ERR_VALUE(rate))
+			ret = rate;
+	}
+
+	for (i = 0; i < count; i++) {
+		pll = rk3588_clk_pll_index(clks[i].id);
+		if (pll < 0)
+			continue;
+
+		rockchip_pll_wait_lock(&rk3588_pll_clks[pll], priv->cru, pll);
+		rk3588_clk_update_pll_rate(priv, pll);
+	}
+
+	for (i = 0; i < count; i++) {
+		if (rk3588_clk_pll_index(clks[i].id) >= 0)
+			continue;
+
+		rate = rk3588_clk_set_rate(&clks[i], rates[i]);
+		if (IS_ERR_VALUE(rate))
+			ret = rate;
+	}
+
+	return ret;
+}
+
 static struct clk_ops rk3588_clk_ops = {
 	.get_rate = rk3588_clk_get_rate,
 	.set_rate = rk3588_clk_set_rate,
+	.set_rates = rk3588_clk_set_rates,
 	.get_phase = rk3588_clk_get_phase,
 	.set_phase = rk3588_clk_set_phase,
 #if (IS_ENABLED(OF_CONTROL)) || (!IS_ENABLED(OF_PLATDATA))
@@ -79,13 +79,39 @@ int dfu_init_env_entities(char *interface, char *devstr)
 	return 0;
 }
 
+#ifndef CONFIG_DFU_WRITE_BUFFERS
+#define CONFIG_DFU_WRITE_BUFFERS 1
+#endif
+
 static unsigned char *dfu_buf;
 static unsigned long dfu_buf_size;
 
+/*
+ * With more than one write buffer, dfu_buf holds dfu_buf_cnt buffers of
+ * dfu_buf_size bytes each, used as a ring. A buffer which fills up is queued
+ * and written to the medium by dfu_write_poll(), called from the USB gadget
+ * loops, while the next one is being filled.
+ */
+static unsigned int dfu_buf_cnt = 1;
+static long *dfu_buf_len;		/* bytes queued in each buffer */
+static unsigned int dfu_buf_fill;	/* buffer being filled */
+static unsigned int dfu_buf_queued;	/* full buffers not yet written */
+static struct dfu_entity *dfu_buf_entity; /* entity the queue is for */
+static int dfu_buf_err;			/* first error from a queued write */
+
+static unsigned char *dfu_buf_at(unsigned int i)
+{
+	return dfu_buf + i * dfu_buf_size;
+}
+
 unsigned char *dfu_free_buf(void)
 {
 	free(dfu_buf);
 	dfu_buf = NULL;
+	free(dfu_buf_len);
+	dfu_buf_len = NULL;
+	dfu_buf_fill = 0;
+	dfu_buf_queued = 0;
 	return dfu_buf;
 }
 
@@ -111,6 +137,24 @@ unsigned char *dfu_get_buf(struct dfu_entity *dfu)
 	if (dfu->max_buf_size && dfu_buf_size > dfu->max_buf_size)
 		dfu_buf_size = dfu->max_buf_size;
 
+	s = env_get("dfu_bufcnt");
+	if (s)
+		dfu_buf_cnt = simple_strtoul(s, NULL, 0);
+	else
+		dfu_buf_cnt = CONFIG_DFU_WRITE_BUFFERS;
+
+	if (dfu_buf_cnt > 1) {
+		dfu_buf_len = calloc(dfu_buf_cnt, sizeof(*dfu_buf_len));
+		dfu_buf = memalign(CONFIG_SYS_CACHELINE_SIZE,
+				   dfu_buf_size * dfu_buf_cnt);
+		if (dfu_buf && dfu_buf_len)
+			return dfu_buf;
+
+		/* Fall back to a single buffer */
+		dfu_free_buf();
+	}
+	dfu_buf_cnt = 1;
+
 	dfu_buf = memalign(CONFIG_SYS_CACHELINE_SIZE, dfu_buf_size);
 	if (dfu_buf == NULL)
 		printf("%s: Could not memalign 0x%lx bytes\n",
@@ -136,27 +180,19 @@ static char *dfu_get_hash_algo(void)
 	return NULL;
 }
 
-static int dfu_write_buffer_drain(struct dfu_entity *dfu)
+static int dfu_write_buffer_out(struct dfu_entity *dfu, void *buf,
+				long w_size)
 {
-	long w_size;
 	int ret;
 
-	/* flush size? */
-	w_size = dfu->i_buf - dfu->i_buf_start;
-	if (w_size == 0)
-		return 0;
-
 	if (dfu_hash_algo)
 		dfu_hash_algo->hash_update(dfu_hash_algo, &dfu->crc,
-					   dfu->i_buf_start, w_size, 0);
+					   buf, w_size, 0);
 
-	ret = dfu->write_medium(dfu, dfu->offset, dfu->i_buf_start, &w_size);
+	ret = dfu->write_medium(dfu, dfu->offset, buf, &w_size);
 	if (ret)
 		debug("%s: Write error!\n", __func__);
 
-	/* point back */
-	dfu->i_buf = dfu->i_buf_start;
-
 	/* update offset */
 	dfu->offset += w_size;
 
@@ -165,6 +201,84 @@ static int dfu_write_buffer_drain(struct dfu_entity *dfu)
 	return ret;
 }
 
+/* Write the oldest queued buffer, or drop it after an earlier error */
+static int dfu_write_queued(void)
+{
+	unsigned int i;
+	int ret;
+
+	i = (dfu_buf_fill + dfu_buf_cnt - dfu_buf_queued) % dfu_buf_cnt;
+	dfu_buf_queued--;
+
+	if (dfu_buf_err)
+		return dfu_buf_err;
+
+	ret = dfu_write_buffer_out(dfu_buf_entity, dfu_buf_at(i),
+				   dfu_buf_len[i]);
+	if (ret)
+		dfu_buf_err = ret;
+
+	return ret;
+}
+
+int dfu_write_poll(void)
+{
+	if (!dfu_buf_queued)
+		return 0;
+
+	return dfu_write_queued();
+}
+
+/* Write everything still queued and return the first error, if any */
+static int dfu_write_wait(void)
+{
+	int ret;
+
+	while (dfu_buf_queued)
+		dfu_write_queued();
+
+	ret = dfu_buf_err;
+	dfu_buf_err = 0;
+
+	return ret;
+}
+
+static int dfu_write_buffer_drain(struct dfu_entity *dfu)
+{
+	long w_size;
+	int ret;
+
+	/* flush size? */
+	w_size = dfu->i_buf - dfu->i_buf_start;
+	if (w_size == 0)
+		return 0;
+
+	if (dfu_buf_cnt == 1) {
+		ret = dfu_write_buffer_out(dfu, dfu->i_buf_start, w_size);
+
+		/* point back */
+		dfu->i_buf = dfu->i_buf_start;
+
+		return ret;
+	}
+
+	/* Queue this buffer and go on filling the next one */
+	dfu_buf_entity = dfu;
+	dfu_buf_len[dfu_buf_fill] = w_size;
+	dfu_buf_queued++;
+	dfu_buf_fill = (dfu_buf_fill + 1) % dfu_buf_cnt;
+
+	/* The next buffer has not been written out yet */
+	if (dfu_buf_queued == dfu_buf_cnt)
+		dfu_write_queued();
+
+	dfu->i_buf_start = dfu_buf_at(dfu_buf_fill);
+	dfu->i_buf_end = dfu->i_buf_start + dfu_buf_size;
+	dfu->i_buf = dfu->i_buf_start;
+
+	return dfu_buf_err;
+}
+
 void dfu_transaction_cleanup(struct dfu_entity *dfu)
 {
 	/* clear everything */
@@ -179,6 +293,11 @@ void dfu_transaction_cleanup(struct dfu_entity *dfu)
 	dfu->bad_skip = 0;
 
 	dfu->inited = 0;
+
+	/* drop whatever was still queued */
+	dfu_buf_fill = 0;
+	dfu_buf_queued = 0;
+	dfu_buf_err = 0;
 }
 
 int dfu_transaction_initiate(struct dfu_entity *dfu, bool read)
@@ -207,11 +326,21 @@ int dfu_transaction_initiate(struct dfu_entity *dfu, bool read)
 	return 0;
 }
 
+unsigned char *dfu_get_write_buf(struct dfu_entity *dfu)
+{
+	if (dfu_transaction_initiate(dfu, false))
+		return NULL;
+
+	return dfu->i_buf;
+}
+
 int dfu_flush(struct dfu_entity *dfu, void *buf, int size, int blk_seq_num)
 {
 	int ret = 0;
 
 	ret = dfu_write_buffer_drain(dfu);
+	if (!ret)
+		ret = dfu_write_wait();
 	if (ret)
 		return ret;
 
@@ -239,6 +368,13 @@ int dfu_write(struct dfu_entity *dfu, void *buf, int size, int blk_seq_num)
 	if (ret < 0)
 		return ret;
 
+	/* a queued write failed since the last call */
+	if (dfu_buf_err) {
+		ret = dfu_buf_err;
+		dfu_transaction_cleanup(dfu);
+		return ret;
+	}
+
 	if (dfu->i_blk_seq_num != blk_seq_num) {
 		printf("%s: Wrong sequence number! [%d] [%d]\n",
 		       __func__, dfu->i_blk_seq_num, blk_seq_num);
@@ -279,7 +415,9 @@ int dfu_write(struct dfu_entity *dfu, void *buf, int size, int blk_seq_num)
 		return -1;
 	}
 
-	memcpy(dfu->i_buf, buf, size);
+	/* the data may have been received in place (see dfu_get_write_buf()) */
+	if (buf != dfu->i_buf)
+		memcpy(dfu->i_buf, buf, size);
 	dfu->i_buf += size;
 
 	/* if end or if buffer full flush */
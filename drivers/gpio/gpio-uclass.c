@@ -751,20 +751,143 @@ int gpio_get_values_as_int(const int *gpio_list)
 
 int dm_gpio_get_values_as_int(const struct gpio_desc *desc_list, int count)
 {
-	unsigned bitmask = 1;
-	unsigned vector = 0;
-	int ret, i;
+	ulong values;
+	int ret;
+
+	if (count > sizeof(int) * 8 - 1)
+		return -EINVAL;
+
+	ret = dm_gpio_get_values(desc_list, count, &values);
+	if (ret)
+		return ret;
+
+	return values;
+}
+
+/*
+ * Collect the GPIOs of @desc_list that live on the same device as entry
+ * @first, as a mask of their offsets. Entries are marked in @donep.
+ */
+static int gpio_bank_mask(const struct gpio_desc *desc_list, int count,
+			  int first, const char *func, ulong *donep,
+			  ulong *maskp)
+{
+	struct udevice *dev = desc_list[first].dev;
+	ulong mask = 0;
+	int i, ret;
+
+	for (i = first; i < count; i++) {
+		if (desc_list[i].dev != dev)
+			continue;
+
+		ret = check_reserved(&desc_list[i], func);
+		if (ret)
+			return ret;
+		if (desc_list[i].offset >= BITS_PER_LONG)
+			return -EINVAL;
+
+		mask |= BIT(desc_list[i].offset);
+		*donep |= BIT(i);
+	}
+	*maskp = mask;
+
+	return 0;
+}
+
+int dm_gpio_get_values(const struct gpio_desc *desc_list, int count,
+		       ulong *valuesp)
+{
+	const struct gpio_desc *desc;
+	struct dm_gpio_ops *ops;
+	ulong done = 0, values = 0;
+	ulong mask, bank;
+	int i, j, ret;
+
+	if (count > BITS_PER_LONG)
+		return -EINVAL;
 
 	for (i = 0; i < count; i++) {
-		ret = dm_gpio_get_value(&desc_list[i]);
-		if (ret < 0)
+		if (done & BIT(i))
+			continue;
+
+		ops = gpio_get_ops(desc_list[i].dev);
+		if (!ops->get_values) {
+			ret = dm_gpio_get_value(&desc_list[i]);
+			if (ret < 0)
+				return ret;
+			if (ret)
+				values |= BIT(i);
+			continue;
+		}
+
+		ret = gpio_bank_mask(desc_list, count, i, "get_values", &done,
+				     &mask);
+		if (ret)
 			return ret;
-		else if (ret)
-			vector |= bitmask;
-		bitmask <<= 1;
+
+		ret = ops->get_values(desc_list[i].dev, mask, &bank);
+		if (ret)
+			return ret;
+
+		for (j = i; j < count; j++) {
+			desc = &desc_list[j];
+			if (desc->dev != desc_list[i].dev)
+				continue;
+			if (!(bank & BIT(desc->offset)) !=
+			    !(desc->flags & GPIOD_ACTIVE_LOW))
+				values |= BIT(j);
+		}
 	}
+	*valuesp = values;
 
-	return vector;
+	return 0;
+}
+
+int dm_gpio_set_values(const struct gpio_desc *desc_list, int count,
+		       ulong values)
+{
+	const struct gpio_desc *desc;
+	struct dm_gpio_ops *ops;
+	ulong done = 0;
+	ulong mask, bank;
+	int i, j, ret;
+
+	if (count > BITS_PER_LONG)
+		return -EINVAL;
+
+	for (i = 0; i < count; i++) {
+		if (done & BIT(i))
+			continue;
+
+		ops = gpio_get_ops(desc_list[i].dev);
+		if (!ops->set_values) {
+			ret = dm_gpio_set_value(&desc_list[i],
+						!!(values & BIT(i)));
+			if (ret)
+				return ret;
+			continue;
+		}
+
+		ret = gpio_bank_mask(desc_list, count, i, "set_values", &done,
+				     &mask);
+		if (ret)
+			return ret;
+
+		bank = 0;
+		for (j = i; j < count; j++) {
+			desc = &desc_list[j];
+			if (desc->dev != desc_list[i].dev)
+				continue;
+			if (!(values & BIT(j)) != !(desc->flags & GPIOD_ACTIVE_LOW))
+				bank |= BIT(desc->offset);
+		}
+
+		ret = ops->set_values(desc_list[i].dev, mask, bank);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
 }
 
 /**
@@ -97,6 +97,39 @@ static int rockchip_gpio_set_value(struct udevice *dev, unsigned offset,
 	return 0;
 }
 
+static int rockchip_gpio_get_values(struct udevice *dev, ulong mask,
+				    ulong *valuesp)
+{
+	struct rockchip_gpio_priv *priv = dev_get_priv(dev);
+	struct rockchip_gpio_regs *regs = priv->regs;
+
+	*valuesp = readl(&regs->ext_port) & mask;
+
+	return 0;
+}
+
+static int rockchip_gpio_set_values(struct udevice *dev, ulong mask,
+				    ulong values)
+{
+	struct rockchip_gpio_priv *priv = dev_get_priv(dev);
+	struct rockchip_gpio_regs *regs = priv->regs;
+
+	values &= mask;
+#ifdef CONFIG_ROCKCHIP_GPIO_V2
+	/* The write enables in the upper half leave other pins untouched */
+	if (mask & 0xffff)
+		writel((mask & 0xffff) << 16 | (values & 0xffff),
+		       &regs->swport_dr_l);
+	if (mask >> 16)
+		writel((mask >> 16) << 16 | (values >> 16),
+		       &regs->swport_dr_h);
+#else
+	clrsetbits_le32(&regs->swport_dr, mask, values);
+#endif
+
+	return 0;
+}
+
 static int rockchip_gpio_get_function(struct udevice *dev, unsigned offset)
 {
 #ifdef CONFIG_SPL_BUILD
@@ -179,6 +212,8 @@ static const struct dm_gpio_ops gpio_rockchip_ops = {
 	.direction_output	= rockchip_gpio_direction_output,
 	.get_value		= rockchip_gpio_get_value,
 	.set_value		= rockchip_gpio_set_value,
+	.get_values		= rockchip_gpio_get_values,
+	.set_values		= rockchip_gpio_set_values,
 	.get_function		= rockchip_gpio_get_function,
 };
 
@@ -23,11 +23,16 @@ struct gpio_state {
 	u8 flags;		/* flags (GPIOF_...) */
 };
 
+struct gpio_sandbox_priv {
+	uint reads;		/* input register reads by the driver ops */
+	struct gpio_state state[];
+};
+
 /* Access routines for GPIO state */
 static u8 *get_gpio_flags(struct udevice *dev, unsigned offset)
 {
 	struct gpio_dev_priv *uc_priv = dev_get_uclass_priv(dev);
-	struct gpio_state *state = dev_get_priv(dev);
+	struct gpio_sandbox_priv *priv = dev_get_priv(dev);
 
 	if (offset >= uc_priv->gpio_count) {
 		static u8 invalid_flags;
@@ -35,7 +40,7 @@ static u8 *get_gpio_flags(struct udevice *dev, unsigned offset)
 		return &invalid_flags;
 	}
 
-	return &state[offset].flags;
+	return &priv->state[offset].flags;
 }
 
 static int get_gpio_flag(struct udevice *dev, unsigned offset, int flag)
@@ -92,6 +97,13 @@ int sandbox_gpio_set_direction(struct udevice *dev, unsigned offset, int output)
 	return set_gpio_flag(dev, offset, GPIOF_OUTPUT, output);
 }
 
+uint sandbox_gpio_get_read_count(struct udevice *dev)
+{
+	struct gpio_sandbox_priv *priv = dev_get_priv(dev);
+
+	return priv->reads;
+}
+
 /*
  * These functions implement the public interface within U-Boot
  */
@@ -117,11 +129,33 @@ static int sb_gpio_direction_output(struct udevice *dev, unsigned offset,
 /* read GPIO IN value of port 'offset' */
 static int sb_gpio_get_value(struct udevice *dev, unsigned offset)
 {
+	struct gpio_sandbox_priv *priv = dev_get_priv(dev);
+
 	debug("%s: offset:%u\n", __func__, offset);
+	priv->reads++;
 
 	return sandbox_gpio_get_value(dev, offset);
 }
 
+/* read the GPIO IN values of all ports in 'mask' */
+static int sb_gpio_get_values(struct udevice *dev, ulong mask, ulong *valuesp)
+{
+	struct gpio_sandbox_priv *priv = dev_get_priv(dev);
+	ulong values = 0;
+	unsigned offset;
+
+	debug("%s: mask:%lx\n", __func__, mask);
+	priv->reads++;
+
+	for (offset = 0; offset < BITS_PER_LONG; offset++) {
+		if ((mask & BIT(offset)) && sandbox_gpio_get_value(dev, offset))
+			values |= BIT(offset);
+	}
+	*valuesp = values;
+
+	return 0;
+}
+
 /* write GPIO OUT value to port 'offset' */
 static int sb_gpio_set_value(struct udevice *dev, unsigned offset, int value)
 {
@@ -136,6 +170,26 @@ static int sb_gpio_set_value(struct udevice *dev, unsigned offset, int value)
 	return sandbox_gpio_set_value(dev, offset, value);
 }
 
+/* write the GPIO OUT values of all ports in 'mask' */
+static int sb_gpio_set_values(struct udevice *dev, ulong mask, ulong values)
+{
+	unsigned offset;
+	int ret;
+
+	debug("%s: mask:%lx, values = %lx\n", __func__, mask, values);
+
+	for (offset = 0; offset < BITS_PER_LONG; offset++) {
+		if (!(mask & BIT(offset)))
+			continue;
+
+		ret = sb_gpio_set_value(dev, offset, !!(values & BIT(offset)));
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+
 /* read GPIO ODR value of port 'offset' */
 static int sb_gpio_get_open_drain(struct udevice *dev, unsigned offset)
 {
@@ -188,6 +242,8 @@ static const struct dm_gpio_ops gpio_sandbox_ops = {
 	.direction_output	= sb_gpio_direction_output,
 	.get_value		= sb_gpio_get_value,
 	.set_value		= sb_gpio_set_value,
+	.get_values		= sb_gpio_get_values,
+	.set_values		= sb_gpio_set_values,
 	.get_open_drain		= sb_gpio_get_open_drain,
 	.set_open_drain		= sb_gpio_set_open_drain,
 	.get_function		= sb_gpio_get_function,
@@ -212,7 +268,8 @@ static int gpio_sandbox_probe(struct udevice *dev)
 		/* Tell the uclass how many GPIOs we have */
 		uc_priv->gpio_count = CONFIG_SANDBOX_GPIO_COUNT;
 
-	dev->priv = calloc(sizeof(struct gpio_state), uc_priv->gpio_count);
+	dev->priv = calloc(1, sizeof(struct gpio_sandbox_priv) +
+			   sizeof(struct gpio_state) * uc_priv->gpio_count);
 
 	return 0;
 }
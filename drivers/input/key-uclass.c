@@ -17,6 +17,24 @@
 #define KEY_ERR(fmt, args...)	printf("Key Error: "fmt, ##args)
 #define KEY_DBG(fmt, args...)	 debug("Key Debug: "fmt, ##args)
 
+/*
+ * GPIO keys are sampled all together, with one read per GPIO bank, and the
+ * result is reused by key_read() calls made within this many ms. The boot
+ * path checks several keys in a row, far quicker than a key press changes.
+ * ADC keys are scanned the same way, all their channels in one sequence.
+ */
+#define KEY_SCAN_VALID_MS	20
+
+/* Conversions averaged per ADC key scan, to reduce noise */
+#define KEY_ADC_SAMPLES		4
+
+struct key_uclass_priv {
+	bool scanned;
+	ulong scan_time;
+	bool adc_scanned;
+	ulong adc_scan_time;
+};
+
 static inline uint64_t arch_counter_get_cntpct(void)
 {
 	uint64_t cval = 0;
@@ -73,17 +91,164 @@ static int key_adc_event(struct udevice *dev,
 	return (val <= uc_key->max && val >= uc_key->min) ?
 		KEY_PRESS_DOWN : KEY_PRESS_NONE;
 }
+
+static bool key_adc_channel_valid(struct udevice *adc,
+				  struct dm_key_uclass_platdata *uc_key)
+{
+	struct adc_uclass_platdata *uc_pdata = dev_get_uclass_platdata(adc);
+
+	return uc_key->type == ADC_KEY && uc_key->channel <= ADC_MAX_CHANNEL &&
+	       (uc_pdata->channel_mask & BIT(uc_key->channel));
+}
+
+static int key_adc_scan(struct udevice *adc, struct key_uclass_priv *priv)
+{
+	struct adc_channel channels[ADC_MAX_CHANNEL + 1];
+	struct dm_key_uclass_platdata *uc_key;
+	unsigned int channel_mask = 0;
+	struct udevice *dev;
+	int i, count, ret;
+
+	/*
+	 * Keys on a resistor ladder share a channel. A key with a channel
+	 * the saradc does not have would fail the whole scan, so leave it
+	 * out; key_adc_read() reports it as not existing.
+	 */
+	for (uclass_first_device(UCLASS_KEY, &dev);
+	     dev;
+	     uclass_next_device(&dev)) {
+		uc_key = dev_get_uclass_platdata(dev);
+		if (key_adc_channel_valid(adc, uc_key))
+			channel_mask |= BIT(uc_key->channel);
+	}
+
+	if (!channel_mask)
+		return -EINVAL;
+
+	ret = adc_channels_average(adc, channel_mask, KEY_ADC_SAMPLES,
+				   channels);
+	if (ret)
+		return ret;
+
+	count = hweight32(channel_mask);
+	for (uclass_first_device(UCLASS_KEY, &dev);
+	     dev;
+	     uclass_next_device(&dev)) {
+		uc_key = dev_get_uclass_platdata(dev);
+		if (!key_adc_channel_valid(adc, uc_key))
+			continue;
+
+		for (i = 0; i < count; i++) {
+			if (channels[i].id == uc_key->channel) {
+				uc_key->adc_value = channels[i].data;
+				break;
+			}
+		}
+	}
+
+	priv->adc_scanned = true;
+	priv->adc_scan_time = get_timer(0);
+
+	return 0;
+}
+
+static int key_adc_read(struct dm_key_uclass_platdata *uc_key)
+{
+	struct key_uclass_priv *priv;
+	struct udevice *dev;
+	struct uclass *uc;
+	int ret;
+
+	ret = uclass_get_device_by_name(UCLASS_ADC, "saradc", &dev);
+	if (ret) {
+		KEY_ERR("%s: No saradc\n", uc_key->name);
+		return KEY_NOT_EXIST;
+	}
+
+	if (!key_adc_channel_valid(dev, uc_key)) {
+		KEY_ERR("%s: Invalid saradc channel %d\n",
+			uc_key->name, uc_key->channel);
+		return KEY_NOT_EXIST;
+	}
+
+	if (uclass_get(UCLASS_KEY, &uc))
+		return KEY_NOT_EXIST;
+
+	priv = uc->priv;
+	if (!priv->adc_scanned ||
+	    get_timer(priv->adc_scan_time) >= KEY_SCAN_VALID_MS) {
+		ret = key_adc_scan(dev, priv);
+		if (ret) {
+			KEY_ERR("%s: Failed to read saradc, %d\n",
+				uc_key->name, ret);
+			return KEY_NOT_EXIST;
+		}
+	}
+
+	return key_adc_event(dev, uc_key, uc_key->adc_value);
+}
 #endif
 
+static bool key_is_gpio_level(struct dm_key_uclass_platdata *uc_key)
+{
+	return uc_key->type != ADC_KEY && uc_key->code != KEY_POWER &&
+	       dm_gpio_is_valid(&uc_key->gpio);
+}
+
+static void key_gpio_scan(struct key_uclass_priv *priv)
+{
+	struct dm_key_uclass_platdata *keys[BITS_PER_LONG];
+	struct gpio_desc descs[BITS_PER_LONG];
+	struct dm_key_uclass_platdata *uc_key;
+	struct udevice *dev;
+	ulong values;
+	int i, count = 0;
+
+	for (uclass_first_device(UCLASS_KEY, &dev);
+	     dev && count < ARRAY_SIZE(descs);
+	     uclass_next_device(&dev)) {
+		uc_key = dev_get_uclass_platdata(dev);
+		if (!key_is_gpio_level(uc_key))
+			continue;
+
+		keys[count] = uc_key;
+		descs[count++] = uc_key->gpio;
+	}
+
+	if (dm_gpio_get_values(descs, count, &values)) {
+		/* Fall back to reading the keys one by one */
+		values = 0;
+		for (i = 0; i < count; i++) {
+			if (dm_gpio_get_value(&descs[i]) > 0)
+				values |= BIT(i);
+		}
+	}
+
+	for (i = 0; i < count; i++)
+		keys[i]->gpio_value = !!(values & BIT(i));
+
+	priv->scanned = true;
+	priv->scan_time = get_timer(0);
+}
+
 static int key_gpio_event(struct dm_key_uclass_platdata *uc_key)
 {
+	struct key_uclass_priv *priv;
+	struct uclass *uc;
+
 	if (!dm_gpio_is_valid(&uc_key->gpio)) {
 		KEY_ERR("'%s' Invalid gpio\n", uc_key->name);
 		return KEY_PRESS_NONE;
 	}
 
-	return dm_gpio_get_value(&uc_key->gpio) ?
-	       KEY_PRESS_DOWN : KEY_PRESS_NONE;
+	if (uclass_get(UCLASS_KEY, &uc))
+		return KEY_PRESS_NONE;
+
+	priv = uc->priv;
+	if (!priv->scanned || get_timer(priv->scan_time) >= KEY_SCAN_VALID_MS)
+		key_gpio_scan(priv);
+
+	return uc_key->gpio_value ? KEY_PRESS_DOWN : KEY_PRESS_NONE;
 }
 
 static int key_gpio_interrupt_event(struct dm_key_uclass_platdata *uc_key)
@@ -142,29 +307,7 @@ static int key_core_read(struct dm_key_uclass_platdata *uc_key)
 {
 	if (uc_key->type == ADC_KEY) {
 #ifdef CONFIG_ADC
-		struct udevice *dev;
-		unsigned int adcval;
-		int ret;
-
-		ret = uclass_get_device_by_name(UCLASS_ADC, "saradc", &dev);
-		if (ret) {
-			KEY_ERR("%s: No saradc\n", uc_key->name);
-			return KEY_NOT_EXIST;
-		}
-
-		ret = adc_start_channel(dev, uc_key->channel);
-		if (ret) {
-			KEY_ERR("%s: Failed to start saradc\n", uc_key->name);
-			return KEY_NOT_EXIST;
-		}
-
-		ret = adc_channel_data(dev, uc_key->channel, &adcval);
-		if (ret) {
-			KEY_ERR("%s: Failed to read saradc, %d\n", uc_key->name, ret);
-			return KEY_NOT_EXIST;
-		}
-
-		return key_adc_event(dev, uc_key, adcval);
+		return key_adc_read(uc_key);
 #else
 		return KEY_NOT_EXIST;
 #endif
@@ -400,6 +543,7 @@ UCLASS_DRIVER(key) = {
 	.id		= UCLASS_KEY,
 	.name		= "key",
 	.post_probe	= key_post_probe,
+	.priv_auto_alloc_size = sizeof(struct key_uclass_priv),
 	.per_device_platdata_auto_alloc_size =
 			sizeof(struct dm_key_uclass_platdata),
 };
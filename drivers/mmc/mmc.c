@@ -13,6 +13,7 @@
 #include <dm.h>
 #include <dm/device-internal.h>
 #include <errno.h>
+#include <event_loop.h>
 #include <mmc.h>
 #include <part.h>
 #include <power/regulator.h>
@@ -712,7 +713,7 @@ static int mmc_poll_for_busy(struct mmc *mmc, u8 send_status)
 	start = get_timer(0);
 
 	if (!send_status && !mmc_can_card_busy(mmc)) {
-		mdelay(timeout);
+		event_loop_sleep(timeout);
 		return 0;
 	}
 
@@ -733,6 +734,9 @@ static int mmc_poll_for_busy(struct mmc *mmc, u8 send_status)
 
 		if (get_timer(start) > timeout && busy)
 			return -ETIMEDOUT;
+
+		if (busy)
+			event_loop_run();
 	} while (busy);
 
 	return 0;
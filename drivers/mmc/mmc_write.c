@@ -11,6 +11,7 @@
 #include <common.h>
 #include <dm.h>
 #include <part.h>
+#include <watchdog.h>
 #include <div64.h>
 #include <linux/math64.h>
 #include "mmc_private.h"
@@ -154,6 +155,7 @@ ulong mmc_berase(struct blk_desc *block_dev, lbaint_t start, lbaint_t blkcnt)
 			/* Waiting for the ready status */
 			if (mmc_send_status(mmc, timeout))
 				return 0;
+			watchdog_progress();
 		}
 		return blk;
 	}
@@ -254,6 +256,7 @@ ulong mmc_bwrite(struct blk_desc *block_dev, lbaint_t start, lbaint_t blkcnt,
 		blocks_todo -= cur;
 		start += cur;
 		src += cur * mmc->write_bl_len;
+		watchdog_progress();
 	} while (blocks_todo > 0);
 
 	return blkcnt;
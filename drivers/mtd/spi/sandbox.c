@@ -15,6 +15,7 @@
 #include <malloc.h>
 #include <spi.h>
 #include <os.h>
+#include <sandboxblockdev.h>
 
 #include <spi_flash.h>
 #include "sf_internal.h"
@@ -97,11 +98,14 @@ struct sandbox_spi_flash {
 	const struct flash_info *data;
 	/* The file on disk to serv up data from */
 	int fd;
+	/* Timing model and statistics */
+	struct sandbox_storage storage;
 };
 
 struct sandbox_spi_flash_plat_data {
 	const char *filename;
 	const char *device_name;
+	const char *model;
 	int bus;
 	int cs;
 };
@@ -184,6 +188,14 @@ static int sandbox_sf_probe(struct udevice *dev)
 
 	sbsf->data = data;
 	sbsf->cs = cs;
+	sbsf->storage.name = dev->name;
+	if (pdata->model) {
+		sbsf->storage.model = sandbox_storage_find_model(pdata->model);
+		if (!sbsf->storage.model)
+			printf("%s: unknown storage model '%s'\n", __func__,
+			       pdata->model);
+	}
+	sandbox_storage_register(&sbsf->storage);
 
 	return 0;
 
@@ -196,6 +208,7 @@ static int sandbox_sf_remove(struct udevice *dev)
 {
 	struct sandbox_spi_flash *sbsf = dev_get_priv(dev);
 
+	sandbox_storage_unregister(&sbsf->storage);
 	os_close(sbsf->fd);
 
 	return 0;
@@ -323,6 +336,7 @@ static int sandbox_sf_xfer(struct udevice *dev, unsigned int bitlen,
 	uint8_t *tx = txp;
 	uint cnt, pos = 0;
 	int bytes = bitlen / 8;
+	off_t off;
 	int ret;
 
 	log_content("sandbox_sf: state:%x(%s) bytes:%u\n", sbsf->state,
@@ -406,11 +420,14 @@ static int sandbox_sf_xfer(struct udevice *dev, unsigned int bitlen,
 			cnt = bytes - pos;
 			log_content(" tx: read(%u)\n", cnt);
 			assert(tx);
+			off = os_lseek(sbsf->fd, 0, OS_SEEK_CUR);
 			ret = os_read(sbsf->fd, tx + pos, cnt);
 			if (ret < 0) {
 				puts("sandbox_sf: os_read() failed\n");
 				return -EIO;
 			}
+			sandbox_storage_account(&sbsf->storage,
+						SANDBOX_STORAGE_READ, off, ret);
 			pos += ret;
 			break;
 		case SF_READ_STATUS:
@@ -445,11 +462,14 @@ static int sandbox_sf_xfer(struct udevice *dev, unsigned int bitlen,
 			log_content(" rx: write(%u)\n", cnt);
 			if (tx)
 				sandbox_spi_tristate(&tx[pos], cnt);
+			off = os_lseek(sbsf->fd, 0, OS_SEEK_CUR);
 			ret = os_write(sbsf->fd, rx + pos, cnt);
 			if (ret < 0) {
 				puts("sandbox_spi: os_write() failed\n");
 				return -EIO;
 			}
+			sandbox_storage_account(&sbsf->storage,
+						SANDBOX_STORAGE_WRITE, off, ret);
 			pos += ret;
 			sbsf->status &= ~STAT_WEL;
 			break;
@@ -483,6 +503,11 @@ static int sandbox_sf_xfer(struct udevice *dev, unsigned int bitlen,
 			 */
 			ret = sandbox_erase_part(sbsf, sbsf->erase_size);
 			sbsf->status &= ~STAT_WEL;
+			if (!ret)
+				sandbox_storage_account(&sbsf->storage,
+							SANDBOX_STORAGE_ERASE,
+							sbsf->off,
+							sbsf->erase_size);
 			if (ret) {
 				log_content("sandbox_sf: Erase failed\n");
 				goto done;
@@ -507,6 +532,7 @@ int sandbox_sf_ofdata_to_platdata(struct udevice *dev)
 
 	pdata->filename = dev_read_string(dev, "sandbox,filename");
 	pdata->device_name = dev_read_string(dev, "compatible");
+	pdata->model = dev_read_string(dev, "sandbox,storage-model");
 	if (!pdata->filename || !pdata->device_name) {
 		debug("%s: Missing properties, filename=%s, device_name=%s\n",
 		      __func__, pdata->filename, pdata->device_name);
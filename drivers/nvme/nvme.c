@@ -12,9 +12,10 @@
 #include <memalign.h>
 #include <pci.h>
 #include <dm/device-internal.h>
+#include <linux/log2.h>
 #include "nvme.h"
 
-#define NVME_Q_DEPTH		2
+#define NVME_Q_DEPTH		16
 #define NVME_AQ_DEPTH		2
 #define NVME_SQ_SIZE(depth)	(depth * sizeof(struct nvme_command))
 #define NVME_CQ_SIZE(depth)	(depth * sizeof(struct nvme_completion))
@@ -22,7 +23,6 @@
 				      ARCH_DMA_MINALIGN)
 #define ADMIN_TIMEOUT		60
 #define IO_TIMEOUT		30
-#define MAX_PRP_POOL		512
 
 enum nvme_queue_id {
 	NVME_ADMIN_Q,
@@ -69,16 +69,28 @@ static int nvme_wait_ready(struct nvme_dev *dev, bool enabled)
 	return -ETIME;
 }
 
-static int nvme_setup_prps(struct nvme_dev *dev, u64 *prp2,
+/**
+ * nvme_setup_prps() - set up the PRPs for a transfer
+ *
+ * A transfer which spans more than two pages needs a PRP list. Transfers
+ * are limited so that the list fits in a single page, see
+ * nvme_get_info_from_identify().
+ *
+ * @dev:	NVMe device
+ * @prp_list:	Page to use for the PRP list, if one is needed
+ * @prp2:	Returns the value for the PRP2 field of the command
+ * @total_len:	Length of the transfer in bytes
+ * @dma_addr:	Start address of the transfer
+ * @return 0 if OK, -EINVAL if the transfer is too large
+ */
+static int nvme_setup_prps(struct nvme_dev *dev, u64 *prp_list, u64 *prp2,
 			   int total_len, u64 dma_addr)
 {
 	u32 page_size = dev->page_size;
 	int offset = dma_addr & (page_size - 1);
-	u64 *prp_pool;
 	int length = total_len;
-	int i, nprps;
 	u32 prps_per_page = page_size >> 3;
-	u32 num_pages;
+	int i, nprps;
 
 	length -= (page_size - offset);
 
@@ -96,40 +108,17 @@ static int nvme_setup_prps(struct nvme_dev *dev, u64 *prp2,
 	}
 
 	nprps = DIV_ROUND_UP(length, page_size);
-	num_pages = DIV_ROUND_UP(nprps + 1, prps_per_page);
+	if (nprps > prps_per_page)
+		return -EINVAL;
 
-	if (nprps > dev->prp_entry_num) {
-		free(dev->prp_pool);
-		/*
-		 * Always increase in increments of pages.  It doesn't waste
-		 * much memory and reduces the number of allocations.
-		 */
-		dev->prp_pool = memalign(page_size, num_pages * page_size);
-		if (!dev->prp_pool) {
-			printf("Error: malloc prp_pool fail\n");
-			return -ENOMEM;
-		}
-		dev->prp_entry_num = prps_per_page * num_pages;
-	}
-
-	prp_pool = dev->prp_pool;
-	i = 0;
-	while (nprps) {
-		if (i == prps_per_page) {
-			*(prp_pool + i) = *(prp_pool + i - 1);
-			*(prp_pool + i - 1) = cpu_to_le64((ulong)prp_pool +
-					page_size);
-			i = 1;
-			prp_pool += page_size;
-		}
-		*(prp_pool + i++) = cpu_to_le64(dma_addr);
+	for (i = 0; i < nprps; i++) {
+		prp_list[i] = cpu_to_le64(dma_addr);
 		dma_addr += page_size;
-		nprps--;
 	}
-	*prp2 = (ulong)dev->prp_pool;
+	*prp2 = (ulong)prp_list;
 
-	flush_dcache_range((ulong)dev->prp_pool, (ulong)dev->prp_pool +
-			   dev->prp_entry_num * sizeof(u64));
+	flush_dcache_range((ulong)prp_list, (ulong)prp_list +
+			   roundup(nprps * sizeof(u64), ARCH_DMA_MINALIGN));
 
 	return 0;
 }
@@ -158,12 +147,15 @@ static u16 nvme_read_completion_status(struct nvme_queue *nvmeq, u16 index)
 }
 
 /**
- * nvme_submit_cmd() - copy a command into a queue and ring the doorbell
+ * nvme_queue_cmd() - copy a command into a queue
+ *
+ * The command is not seen by the controller until nvme_ring_sq() is called,
+ * so several commands can be handed over with one doorbell write.
  *
  * @nvmeq:	The queue to use
  * @cmd:	The command to send
  */
-static void nvme_submit_cmd(struct nvme_queue *nvmeq, struct nvme_command *cmd)
+static void nvme_queue_cmd(struct nvme_queue *nvmeq, struct nvme_command *cmd)
 {
 	u16 tail = nvmeq->sq_tail;
 
@@ -173,10 +165,31 @@ static void nvme_submit_cmd(struct nvme_queue *nvmeq, struct nvme_command *cmd)
 
 	if (++tail == nvmeq->q_depth)
 		tail = 0;
-	writel(tail, nvmeq->q_db);
 	nvmeq->sq_tail = tail;
 }
 
+/**
+ * nvme_ring_sq() - tell the controller about the commands in a queue
+ *
+ * @nvmeq:	The queue to use
+ */
+static void nvme_ring_sq(struct nvme_queue *nvmeq)
+{
+	writel(nvmeq->sq_tail, nvmeq->q_db);
+}
+
+/**
+ * nvme_submit_cmd() - copy a command into a queue and ring the doorbell
+ *
+ * @nvmeq:	The queue to use
+ * @cmd:	The command to send
+ */
+static void nvme_submit_cmd(struct nvme_queue *nvmeq, struct nvme_command *cmd)
+{
+	nvme_queue_cmd(nvmeq, cmd);
+	nvme_ring_sq(nvmeq);
+}
+
 static int nvme_submit_sync_cmd(struct nvme_queue *nvmeq,
 				struct nvme_command *cmd,
 				u32 *result, unsigned timeout)
@@ -231,6 +244,69 @@ static int nvme_submit_sync_cmd(struct nvme_queue *nvmeq,
 	return status;
 }
 
+/**
+ * nvme_wait_cmds() - wait for a batch of commands to complete
+ *
+ * The commands must have IDs 0 to @count - 1. They may complete in any
+ * order. The completion queue doorbell is written once, when all of them
+ * have been seen.
+ *
+ * @nvmeq:	The queue the commands were sent on
+ * @count:	Number of commands
+ * @timeout:	Timeout, in the same units as nvme_submit_sync_cmd()
+ * @failed:	Returns the lowest ID of a command which did not complete
+ *		successfully, or @count if all did
+ * @return 0 if OK, -EIO if a command failed, -ETIMEDOUT on timeout
+ */
+static int nvme_wait_cmds(struct nvme_queue *nvmeq, int count,
+			  unsigned timeout, int *failed)
+{
+	u16 head = nvmeq->cq_head;
+	u16 phase = nvmeq->cq_phase;
+	ulong timeout_us = timeout * 100000;
+	ulong start_time;
+	int ret = 0;
+	u16 status;
+	int id;
+
+	*failed = count;
+	start_time = timer_get_us();
+	while (count) {
+		status = nvme_read_completion_status(nvmeq, head);
+		if ((status & 0x01) != phase) {
+			if (timeout_us > 0 && (timer_get_us() - start_time)
+			    >= timeout_us) {
+				*failed = 0;
+				ret = -ETIMEDOUT;
+				break;
+			}
+			continue;
+		}
+
+		id = readw(&(nvmeq->cqes[head].command_id));
+		status >>= 1;
+		if (status) {
+			printf("ERROR: status = %x, phase = %d, head = %d\n",
+			       status, phase, head);
+			if (id < *failed)
+				*failed = id;
+			ret = -EIO;
+		}
+
+		if (++head == nvmeq->q_depth) {
+			head = 0;
+			phase = !phase;
+		}
+		count--;
+	}
+
+	writel(head, nvmeq->q_db + nvmeq->dev->db_stride);
+	nvmeq->cq_head = head;
+	nvmeq->cq_phase = phase;
+
+	return ret;
+}
+
 static int nvme_submit_admin_cmd(struct nvme_dev *dev, struct nvme_command *cmd,
 				 u32 *result)
 {
@@ -654,6 +730,14 @@ static int nvme_get_info_from_identify(struct nvme_dev *dev)
 		dev->max_transfer_shift = 20;
 	}
 
+	/*
+	 * Each I/O command gets one page for its PRP list, which limits it to
+	 * that many pages of data
+	 */
+	shift = ilog2(dev->page_size);
+	dev->max_transfer_shift = min_t(u32, dev->max_transfer_shift,
+					2 * shift - 3);
+
 	free(ctrl);
 	return 0;
 }
@@ -735,17 +819,18 @@ static ulong nvme_blk_rw(struct udevice *udev, lbaint_t blknr,
 {
 	struct nvme_ns *ns = dev_get_priv(udev);
 	struct nvme_dev *dev = ns->dev;
+	struct nvme_queue *nvmeq = dev->queues[NVME_IO_Q];
 	struct nvme_command c;
 	struct blk_desc *desc = dev_get_uclass_platdata(udev);
-	int status;
 	u64 prp2;
 	u64 total_len = blkcnt << desc->log2blksz;
-	u64 temp_len = total_len;
 	uintptr_t temp_buffer;
 
-	u64 slba = blknr;
-	u16 lbas = 1 << (dev->max_transfer_shift - ns->lba_shift);
-	u64 total_lbas = blkcnt;
+	/* The command's block count field is 16 bits wide */
+	u32 lbas = min(1 << (dev->max_transfer_shift - ns->lba_shift),
+		       1 << 16);
+	u32 prps_per_page = dev->page_size >> 3;
+	lbaint_t done = 0;
 
 	struct bounce_buffer bb;
 	unsigned int bb_flags;
@@ -761,47 +846,56 @@ static ulong nvme_blk_rw(struct udevice *udev, lbaint_t blknr,
 		return -ENOMEM;
 	temp_buffer = (unsigned long)bb.bounce_buffer;
 
+	memset(&c, 0, sizeof(c));
 	c.rw.opcode = read ? nvme_cmd_read : nvme_cmd_write;
-	c.rw.flags = 0;
 	c.rw.nsid = cpu_to_le32(ns->ns_id);
-	c.rw.control = 0;
-	c.rw.dsmgmt = 0;
-	c.rw.reftag = 0;
-	c.rw.apptag = 0;
-	c.rw.appmask = 0;
-	c.rw.metadata = 0;
 
 	/* Enable FUA for data integrity if vwc is enabled */
 	if (dev->vwc)
 		c.rw.control |= NVME_RW_FUA;
 
-	while (total_lbas) {
-		if (total_lbas < lbas) {
-			lbas = (u16)total_lbas;
-			total_lbas = 0;
-		} else {
-			total_lbas -= lbas;
+	/*
+	 * Split the transfer into commands of at most 'lbas' blocks, queue
+	 * up to one per I/O slot and ring the doorbell once, then wait for
+	 * the whole batch before reusing the slots' PRP lists.
+	 */
+	while (done < blkcnt) {
+		lbaint_t queued = 0;
+		int n, failed;
+
+		for (n = 0; n < dev->io_slots && done + queued < blkcnt; n++) {
+			u32 cnt = min_t(lbaint_t, blkcnt - done - queued, lbas);
+			uintptr_t addr = temp_buffer +
+					 ((done + queued) << ns->lba_shift);
+
+			if (nvme_setup_prps(dev,
+					    dev->prp_pool + n * prps_per_page,
+					    &prp2, cnt << ns->lba_shift, addr))
+				break;
+			c.rw.command_id = n;
+			c.rw.slba = cpu_to_le64(blknr + done + queued);
+			c.rw.length = cpu_to_le16(cnt - 1);
+			c.rw.prp1 = cpu_to_le64(addr);
+			c.rw.prp2 = cpu_to_le64(prp2);
+			nvme_queue_cmd(nvmeq, &c);
+			queued += cnt;
 		}
+		if (!n)
+			break;
 
-		if (nvme_setup_prps(dev, &prp2,
-				    lbas << ns->lba_shift, temp_buffer))
-			return -EIO;
-		c.rw.slba = cpu_to_le64(slba);
-		slba += lbas;
-		c.rw.length = cpu_to_le16(lbas - 1);
-		c.rw.prp1 = cpu_to_le64(temp_buffer);
-		c.rw.prp2 = cpu_to_le64(prp2);
-		status = nvme_submit_sync_cmd(dev->queues[NVME_IO_Q],
-				&c, NULL, IO_TIMEOUT);
-		if (status)
+		nvme_ring_sq(nvmeq);
+		ret = nvme_wait_cmds(nvmeq, n, IO_TIMEOUT, &failed);
+		if (ret) {
+			/* Count the blocks before the first failed command */
+			done += min_t(lbaint_t, (lbaint_t)failed * lbas, queued);
 			break;
-		temp_len -= (u32)lbas << ns->lba_shift;
-		temp_buffer += lbas << ns->lba_shift;
+		}
+		done += queued;
 	}
 
 	bounce_buffer_stop(&bb);
 
-	return (total_len - temp_len) >> desc->log2blksz;
+	return done;
 }
 
 static ulong nvme_blk_read(struct udevice *udev, lbaint_t blknr,
@@ -873,14 +967,18 @@ static int nvme_probe(struct udevice *udev)
 	if (ret)
 		goto free_queue;
 
-	/* Allocate after the page size is known */
-	ndev->prp_pool = memalign(ndev->page_size, MAX_PRP_POOL);
+	/*
+	 * Allocate after the page size is known: one page of PRP list for
+	 * each I/O command which can be in flight
+	 */
+	ndev->io_slots = ndev->q_depth - 1;
+	ndev->prp_pool = memalign(ndev->page_size,
+				  ndev->io_slots * ndev->page_size);
 	if (!ndev->prp_pool) {
 		ret = -ENOMEM;
 		printf("Error: %s: Out of memory!\n", udev->name);
 		goto free_nvme;
 	}
-	ndev->prp_entry_num = MAX_PRP_POOL >> 3;
 
 	ret = nvme_setup_io_queues(ndev);
 	if (ret)
@@ -626,7 +626,7 @@ struct nvme_dev {
 	u32 page_size;
 	u8 vwc;
 	u64 *prp_pool;
-	u32 prp_entry_num;
+	u32 io_slots;
 	u32 nn;
 };
 
@@ -671,6 +671,45 @@ error:
 	return ret;
 }
 
+/*
+ * The far end of a PCIe link is a single device, so there is no need to
+ * look for devices 1-31 on the secondary bus of a Root Port or Downstream
+ * Port. With some controllers, config accesses to absent devices are slow.
+ */
+static bool pci_bus_only_one_child(struct udevice *bus)
+{
+	ulong status, pos, id, flags;
+	int ttl = 48;
+
+	/* Only bridges are on a PCI bus themselves */
+	if (device_get_uclass_id(bus->parent) != UCLASS_PCI)
+		return false;
+
+	dm_pci_read_config(bus, PCI_STATUS, &status, PCI_SIZE_16);
+	if (!(status & PCI_STATUS_CAP_LIST))
+		return false;
+
+	dm_pci_read_config(bus, PCI_CAPABILITY_LIST, &pos, PCI_SIZE_8);
+	while (ttl-- && pos >= 0x40) {
+		pos &= ~3;
+		dm_pci_read_config(bus, pos + PCI_CAP_LIST_ID, &id,
+				   PCI_SIZE_8);
+		if (id == 0xff)
+			break;
+		if (id == PCI_CAP_ID_EXP) {
+			dm_pci_read_config(bus, pos + PCI_EXP_FLAGS, &flags,
+					   PCI_SIZE_16);
+			flags = (flags & PCI_EXP_FLAGS_TYPE) >> 4;
+			return flags == PCI_EXP_TYPE_ROOT_PORT ||
+			       flags == PCI_EXP_TYPE_DOWNSTREAM;
+		}
+		dm_pci_read_config(bus, pos + PCI_CAP_LIST_NEXT, &pos,
+				   PCI_SIZE_8);
+	}
+
+	return false;
+}
+
 int pci_bind_bus_devices(struct udevice *bus)
 {
 	ulong vendor, device;
@@ -680,8 +719,8 @@ int pci_bind_bus_devices(struct udevice *bus)
 	int ret;
 
 	found_multi = false;
-	end = PCI_BDF(bus->seq, PCI_MAX_PCI_DEVICES - 1,
-		      PCI_MAX_PCI_FUNCTIONS - 1);
+	end = PCI_BDF(bus->seq, pci_bus_only_one_child(bus) ? 0 :
+		      PCI_MAX_PCI_DEVICES - 1, PCI_MAX_PCI_FUNCTIONS - 1);
 	for (bdf = PCI_BDF(bus->seq, 0, 0); bdf <= end;
 	     bdf += PCI_BDF(0, 0, 1)) {
 		struct pci_child_platdata *pplat;
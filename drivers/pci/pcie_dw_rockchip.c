@@ -70,8 +70,22 @@ struct rk_pcie {
 	struct pci_region	mem;
 	bool		is_bifurcation;
 	u32 gen;
+	struct list_head	node;	/* in rk_pcie_started, until probed */
+	ulong		power_time;	/* when the slot was powered up */
+	ulong		link_time;	/* when training started / link came up */
+	bool		link_started;
+	bool		link_up;
+	bool		slot_empty;	/* in the 'pcie_empty' list */
 };
 
+/*
+ * Link training is slow, and slower still when a slot turns out to be
+ * empty. So when the first controller is probed, all the others are powered
+ * up and start training too. Their state waits here for them to be probed.
+ */
+static LIST_HEAD(rk_pcie_started);
+static bool rk_pcie_started_all;
+
 enum {
 	PCIBIOS_SUCCESSFUL = 0x0000,
 	PCIBIOS_UNSUPPORTED = -ENODEV,
@@ -80,6 +94,16 @@ enum {
 
 #define msleep(a)		udelay((a) * 1000)
 
+/* T_PVPERL: power stable to PERST# inactive */
+#define RK_PCIE_PERST_DELAY_MS		200
+/* Time allowed for link training */
+#define RK_PCIE_LINK_TIMEOUT_MS		500
+/* Time to leave the link for Gen switch recovery after it comes up */
+#define RK_PCIE_LINK_SETTLE_MS		1000
+/* Time for a receiver to be detected, if the slot was empty last time */
+#define RK_PCIE_DETECT_MS		50
+#define RK_PCIE_LTSSM_DETECT_ACT	0x01
+
 /* Parameters for the waiting for iATU enabled routine */
 #define PCIE_CLIENT_GENERAL_DEBUG	0x104
 #define PCIE_CLIENT_HOT_RESET_CTRL	0x180
@@ -542,67 +566,56 @@ static int is_link_up(struct rk_pcie *priv)
 	return 0;
 }
 
-static int rk_pcie_link_up(struct rk_pcie *priv, u32 cap_speed)
+/*
+ * The 'pcie_empty' environment variable lists the controllers which had no
+ * link last time, e.g. "pcie@fe150000 pcie@fe170000". Training on these gives
+ * up early unless a receiver is detected. The variable is updated when this
+ * changes, and can be saved with 'saveenv' so it is used on the next boot.
+ */
+static bool rk_pcie_cached_empty(struct rk_pcie *priv)
 {
-	int retries;
-
-	if (is_link_up(priv)) {
-		printf("PCI Link already up before configuration!\n");
-		return 1;
+	const char *list = env_get("pcie_empty");
+	const char *name = priv->dev->name;
+	int len = strlen(name);
+	const char *p;
+
+	for (p = list; p && (p = strstr(p, name)); p += len) {
+		if ((p == list || p[-1] == ' ') && (!p[len] || p[len] == ' '))
+			return true;
 	}
 
-	/* DW pre link configurations */
-	rk_pcie_configure(priv, cap_speed);
-
-	/* Release the device */
-	if (dm_gpio_is_valid(&priv->rst_gpio)) {
-		/*
-		 * T_PVPERL (Power stable to PERST# inactive) should be a minimum of 100ms.
-		 * We add a 200ms by default for sake of hoping everthings
-		 * work fine.
-		 */
-		msleep(200);
-		dm_gpio_set_value(&priv->rst_gpio, 1);
-		/*
-		 * Add this 20ms delay because we observe link is always up stably after it and
-		 * could help us save 20ms for scanning devices.
-		 */
-		msleep(20);
-	}
-
-	rk_pcie_disable_ltssm(priv);
-	rk_pcie_link_status_clear(priv);
-	rk_pcie_enable_debug(priv);
-
-	/* Enable LTSSM */
-	rk_pcie_enable_ltssm(priv);
-
-	for (retries = 0; retries < 50; retries++) {
-		if (is_link_up(priv)) {
-			dev_info(priv->dev, "PCIe Link up, LTSSM is 0x%x\n",
-				 rk_pcie_readl_apb(priv, PCIE_CLIENT_LTSSM_STATUS));
-			rk_pcie_debug_dump(priv);
-			/* Link maybe in Gen switch recovery but we need to wait more 1s */
-			msleep(1000);
-			return 0;
-		}
+	return false;
+}
 
-		dev_info(priv->dev, "PCIe Linking... LTSSM is 0x%x\n",
-			 rk_pcie_readl_apb(priv, PCIE_CLIENT_LTSSM_STATUS));
-		rk_pcie_debug_dump(priv);
-		msleep(10);
+static void rk_pcie_update_cache(struct rk_pcie *priv, bool empty)
+{
+	const char *name = priv->dev->name;
+	char buf[256], out[256];
+	char *tok, *p;
+	int len = 0;
+
+	if (empty == priv->slot_empty)
+		return;
+
+	strlcpy(buf, env_get("pcie_empty") ? : "", sizeof(buf));
+	p = buf;
+	while ((tok = strsep(&p, " "))) {
+		if (!*tok || !strcmp(tok, name) ||
+		    len + strlen(tok) + 2 > sizeof(out))
+			continue;
+		len += sprintf(out + len, "%s%s", len ? " " : "", tok);
 	}
-
-	dev_err(priv->dev, "PCIe-%d Link Fail\n", priv->dev->seq);
-	return -EINVAL;
+	if (empty && len + strlen(name) + 2 <= sizeof(out))
+		len += sprintf(out + len, "%s%s", len ? " " : "", name);
+	env_set("pcie_empty", len ? out : NULL);
 }
 
-static int rockchip_pcie_init_port(struct udevice *dev)
+static int rk_pcie_power_up(struct rk_pcie *priv)
 {
+	struct udevice *dev = priv->dev;
+	union phy_configure_opts phy_cfg;
 	int ret;
 	u32 val;
-	struct rk_pcie *priv = dev_get_priv(dev);
-	union phy_configure_opts phy_cfg;
 
 	/* Rest the device */
 	if (dm_gpio_is_valid(&priv->rst_gpio))
@@ -617,6 +630,7 @@ static int rockchip_pcie_init_port(struct udevice *dev)
 			return ret;
 		}
 	}
+	priv->power_time = get_timer(0);
 
 	if (priv->is_bifurcation) {
 		phy_cfg.pcie.is_bifurcation = true;
@@ -658,13 +672,7 @@ static int rockchip_pcie_init_port(struct udevice *dev)
 	rk_pcie_writel_apb(priv, 0x0, 0xf00040);
 	rk_pcie_setup_host(priv);
 
-	ret = rk_pcie_link_up(priv, priv->gen);
-	if (ret < 0)
-		goto err_link_up;
-
 	return 0;
-err_link_up:
-	clk_disable_bulk(&priv->clks);
 err_deassert_bulk:
 	reset_assert_bulk(&priv->rsts);
 err_power_off_phy:
@@ -674,9 +682,113 @@ err_exit_phy:
 	return ret;
 }
 
-static int rockchip_pcie_parse_dt(struct udevice *dev)
+static void rk_pcie_power_down(struct rk_pcie *priv)
+{
+	clk_disable_bulk(&priv->clks);
+	reset_assert_bulk(&priv->rsts);
+	generic_phy_power_off(&priv->phy);
+	generic_phy_exit(&priv->phy);
+}
+
+/* Release the device from reset and start link training, without waiting */
+static void rk_pcie_start_link(struct rk_pcie *priv)
+{
+	ulong elapsed;
+
+	priv->link_started = true;
+	priv->slot_empty = rk_pcie_cached_empty(priv);
+	if (is_link_up(priv)) {
+		printf("PCI Link already up before configuration!\n");
+		priv->link_up = true;
+		priv->link_time = get_timer(0);
+		return;
+	}
+
+	/* DW pre link configurations */
+	rk_pcie_configure(priv, priv->gen);
+
+	/* Release the device */
+	if (dm_gpio_is_valid(&priv->rst_gpio)) {
+		/*
+		 * T_PVPERL (Power stable to PERST# inactive) should be a minimum of 100ms.
+		 * We add a 200ms by default for sake of hoping everthings
+		 * work fine. This counts from power-up, so it overlaps with
+		 * other controllers being set up.
+		 */
+		elapsed = get_timer(priv->power_time);
+		if (elapsed < RK_PCIE_PERST_DELAY_MS)
+			msleep(RK_PCIE_PERST_DELAY_MS - elapsed);
+		dm_gpio_set_value(&priv->rst_gpio, 1);
+	}
+
+	rk_pcie_disable_ltssm(priv);
+	rk_pcie_link_status_clear(priv);
+	rk_pcie_enable_debug(priv);
+
+	/* Enable LTSSM */
+	rk_pcie_enable_ltssm(priv);
+	priv->link_time = get_timer(0);
+}
+
+/* Note when the link comes up, so its settling time starts from there */
+static void rk_pcie_check_link(struct rk_pcie *priv)
+{
+	if (!priv->link_up && is_link_up(priv)) {
+		priv->link_up = true;
+		priv->link_time = get_timer(0);
+	}
+}
+
+/* Controllers started before their own probe have no sequence number yet */
+static int rk_pcie_seq(struct rk_pcie *priv)
+{
+	return priv->dev->seq >= 0 ? priv->dev->seq : priv->dev->req_seq;
+}
+
+static int rk_pcie_wait_link(struct rk_pcie *priv)
+{
+	struct rk_pcie *other;
+	ulong elapsed;
+	u32 ltssm;
+
+	for (;;) {
+		rk_pcie_check_link(priv);
+		list_for_each_entry(other, &rk_pcie_started, node)
+			rk_pcie_check_link(other);
+		if (priv->link_up)
+			break;
+
+		ltssm = rk_pcie_readl_apb(priv, PCIE_CLIENT_LTSSM_STATUS);
+		elapsed = get_timer(priv->link_time);
+		if (elapsed >= RK_PCIE_LINK_TIMEOUT_MS ||
+		    (priv->slot_empty && elapsed >= RK_PCIE_DETECT_MS &&
+		     (ltssm & GENMASK(5, 0)) <= RK_PCIE_LTSSM_DETECT_ACT)) {
+			dev_err(priv->dev, "PCIe-%d Link Fail\n",
+				rk_pcie_seq(priv));
+			rk_pcie_update_cache(priv, true);
+			return -EINVAL;
+		}
+
+		dev_dbg(priv->dev, "PCIe Linking... LTSSM is 0x%x\n", ltssm);
+		rk_pcie_debug_dump(priv);
+		msleep(10);
+	}
+
+	dev_info(priv->dev, "PCIe Link up, LTSSM is 0x%x\n",
+		 rk_pcie_readl_apb(priv, PCIE_CLIENT_LTSSM_STATUS));
+	rk_pcie_debug_dump(priv);
+	rk_pcie_update_cache(priv, false);
+
+	/* Link maybe in Gen switch recovery but we need to wait more 1s */
+	elapsed = get_timer(priv->link_time);
+	if (elapsed < RK_PCIE_LINK_SETTLE_MS)
+		msleep(RK_PCIE_LINK_SETTLE_MS - elapsed);
+
+	return 0;
+}
+
+static int rockchip_pcie_parse_dt(struct udevice *dev, struct rk_pcie *priv)
 {
-	struct rk_pcie *priv = dev_get_priv(dev);
 	u32 max_link_speed;
 	int ret;
 	struct resource res;
@@ -703,26 +815,26 @@ static int rockchip_pcie_parse_dt(struct udevice *dev)
 	ret = reset_get_bulk(dev, &priv->rsts);
 	if (ret) {
 		dev_err(dev, "Can't get reset: %d\n", ret);
-		return ret;
+		goto err_free_gpio;
 	}
 
 	ret = clk_get_bulk(dev, &priv->clks);
 	if (ret) {
 		dev_err(dev, "Can't get clock: %d\n", ret);
-		return ret;
+		goto err_release_resets;
 	}
 
 	ret = device_get_supply_regulator(dev, "vpcie3v3-supply",
 					  &priv->vpcie3v3);
 	if (ret && ret != -ENOENT) {
 		dev_err(dev, "failed to get vpcie3v3 supply (ret=%d)\n", ret);
-		return ret;
+		goto err_release_clks;
 	}
 
 	ret = generic_phy_get_by_index(dev, 0, &priv->phy);
 	if (ret) {
 		dev_err(dev, "failed to get pcie phy (ret=%d)\n", ret);
-		return ret;
+		goto err_release_clks;
 	}
 
 	if (dev_read_bool(dev, "rockchip,bifurcation"))
@@ -735,6 +847,131 @@ static int rockchip_pcie_parse_dt(struct udevice *dev)
 		priv->gen = max_link_speed;
 
 	return 0;
+err_release_clks:
+	clk_release_bulk(&priv->clks);
+err_release_resets:
+	reset_release_bulk(&priv->rsts);
+err_free_gpio:
+	dm_gpio_free(dev, &priv->rst_gpio);
+	return ret;
+}
+
+/*
+ * Give back what rockchip_pcie_parse_dt() claimed, so that the controller
+ * can claim it again when it is probed
+ */
+static void rockchip_pcie_release_dt(struct rk_pcie *priv)
+{
+	clk_release_bulk(&priv->clks);
+	reset_release_bulk(&priv->rsts);
+	dm_gpio_free(priv->dev, &priv->rst_gpio);
+}
+
+/* Undo rk_pcie_power_up() and rk_pcie_start_link(), and release the rest */
+static void rk_pcie_shutdown(struct rk_pcie *priv)
+{
+	if (dm_gpio_is_valid(&priv->rst_gpio))
+		dm_gpio_set_value(&priv->rst_gpio, 0);
+	rk_pcie_disable_ltssm(priv);
+	rk_pcie_power_down(priv);
+	if (priv->vpcie3v3)
+		regulator_set_enable(priv->vpcie3v3, false);
+	rockchip_pcie_release_dt(priv);
+}
+
+/* Shut down the controllers started early which were never probed */
+static void rk_pcie_stop_others(void)
+{
+	struct rk_pcie *pcie, *tmp;
+
+	list_for_each_entry_safe(pcie, tmp, &rk_pcie_started, node) {
+		list_del(&pcie->node);
+		rk_pcie_shutdown(pcie);
+		free(pcie);
+	}
+	rk_pcie_started_all = false;
+}
+
+/*
+ * Power up the other controllers which have not been probed yet and start
+ * link training on all of them, so that their delays overlap
+ */
+static void rk_pcie_start_others(struct udevice *self)
+{
+	struct rk_pcie *pcie;
+	struct udevice *dev;
+	struct uclass *uc;
+
+	if (uclass_get(UCLASS_PCI, &uc))
+		return;
+
+	uclass_foreach_dev(dev, uc) {
+		if (dev == self || dev->driver != self->driver ||
+		    device_active(dev))
+			continue;
+
+		pcie = calloc(1, sizeof(*pcie));
+		if (!pcie)
+			break;
+		pcie->dev = dev;
+		if (rockchip_pcie_parse_dt(dev, pcie)) {
+			free(pcie);
+			continue;
+		}
+		if (rk_pcie_power_up(pcie)) {
+			rockchip_pcie_release_dt(pcie);
+			free(pcie);
+			continue;
+		}
+		list_add_tail(&pcie->node, &rk_pcie_started);
+	}
+
+	list_for_each_entry(pcie, &rk_pcie_started, node)
+		rk_pcie_start_link(pcie);
+}
+
+static int rockchip_pcie_init_port(struct udevice *dev)
+{
+	struct rk_pcie *priv = dev_get_priv(dev);
+	struct rk_pcie *pcie;
+	int ret;
+
+	list_for_each_entry(pcie, &rk_pcie_started, node) {
+		if (pcie->dev == dev) {
+			/* Already set up while probing another controller */
+			list_del(&pcie->node);
+			memcpy(priv, pcie, sizeof(*priv));
+			free(pcie);
+			break;
+		}
+	}
+
+	if (!priv->link_started) {
+		priv->dev = dev;
+		ret = rockchip_pcie_parse_dt(dev, priv);
+		if (ret)
+			return ret;
+
+		ret = rk_pcie_power_up(priv);
+		if (ret) {
+			rockchip_pcie_release_dt(priv);
+			return ret;
+		}
+
+		if (!rk_pcie_started_all) {
+			rk_pcie_started_all = true;
+			rk_pcie_start_others(dev);
+		}
+		rk_pcie_start_link(priv);
+	}
+
+	ret = rk_pcie_wait_link(priv);
+	if (ret) {
+		rk_pcie_power_down(priv);
+		rockchip_pcie_release_dt(priv);
+	}
+
+	return ret;
 }
 
 static int rockchip_pcie_probe(struct udevice *dev)
@@ -744,17 +981,12 @@ static int rockchip_pcie_probe(struct udevice *dev)
 	struct pci_controller *hose = dev_get_uclass_priv(ctlr);
 	int ret;
 
-	priv->first_busno = dev->seq;
-	priv->dev = dev;
-
-	ret = rockchip_pcie_parse_dt(dev);
-	if (ret)
-		return ret;
-
 	ret = rockchip_pcie_init_port(dev);
 	if (ret)
 		return ret;
 
+	priv->first_busno = dev->seq;
+
 	dev_info(dev, "PCIE-%d: Link up (Gen%d-x%d, Bus%d)\n",
 		 dev->seq, rk_pcie_get_link_speed(priv),
 		 rk_pcie_get_link_width(priv),
@@ -817,11 +1049,27 @@ static const struct udevice_id rockchip_pcie_ids[] = {
 	{ }
 };
 
+/*
+ * Called before the OS starts too, which is the last chance to shut down
+ * controllers that were started early but never probed
+ */
+static int rockchip_pcie_remove(struct udevice *dev)
+{
+	struct rk_pcie *priv = dev_get_priv(dev);
+
+	rk_pcie_shutdown(priv);
+	rk_pcie_stop_others();
+
+	return 0;
+}
+
 U_BOOT_DRIVER(rockchip_pcie) = {
 	.name			= "pcie_dw_rockchip",
 	.id			= UCLASS_PCI,
 	.of_match		= rockchip_pcie_ids,
 	.ops			= &rockchip_pcie_ops,
 	.probe			= rockchip_pcie_probe,
+	.remove			= rockchip_pcie_remove,
+	.flags			= DM_FLAG_OS_PREPARE,
 	.priv_auto_alloc_size	= sizeof(struct rk_pcie),
 };
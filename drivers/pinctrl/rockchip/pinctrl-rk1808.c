@@ -86,7 +86,7 @@ static int rk1808_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 
 	data = (mask << (bit + 16));
 	data |= (mux & mask) << bit;
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -192,7 +192,7 @@ static int rk1808_set_pull(struct rockchip_pin_bank *bank,
 	data = ((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << (bit + 16);
 
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -211,7 +211,7 @@ static int rk1808_set_drive(struct rockchip_pin_bank *bank,
 	data = ((1 << ROCKCHIP_DRV_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (strength << bit);
 
-	return regmap_write(regmap, reg, data);
+	return rockchip_pinctrl_write(bank, regmap, reg, data);
 }
 
 static int rk1808_set_schmitt(struct rockchip_pin_bank *bank,
@@ -226,7 +226,7 @@ static int rk1808_set_schmitt(struct rockchip_pin_bank *bank,
 	/* enable the write to the equivalent lower bits */
 	data = BIT(bit + 16) | (enable << bit);
 
-	return regmap_write(regmap, reg, data);
+	return rockchip_pinctrl_write(bank, regmap, reg, data);
 }
 
 static struct rockchip_pin_bank rk1808_pin_banks[] = {
@@ -30,7 +30,7 @@ static int rk3036_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 
 	data = (mask << (bit + 16));
 	data |= (mux & mask) << bit;
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -69,7 +69,7 @@ static int rk3036_set_pull(struct rockchip_pin_bank *bank,
 	data = BIT(bit + 16);
 	if (pull == PIN_CONFIG_BIAS_DISABLE)
 		data |= BIT(bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -30,7 +30,7 @@ static int rk3188_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 
 	data = (mask << (bit + 16));
 	data |= (mux & mask) << bit;
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -93,7 +93,7 @@ static int rk3188_set_pull(struct rockchip_pin_bank *bank,
 	/* enable the write to the equivalent lower bits */
 	data = ((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
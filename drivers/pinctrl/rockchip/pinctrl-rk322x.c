@@ -160,7 +160,7 @@ static int rk3228_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 
 	data = (mask << (bit + 16));
 	data |= (mux & mask) << bit;
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -204,7 +204,7 @@ static int rk3228_set_pull(struct rockchip_pin_bank *bank,
 	/* enable the write to the equivalent lower bits */
 	data = ((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -245,7 +245,7 @@ static int rk3228_set_drive(struct rockchip_pin_bank *bank,
 	/* enable the write to the equivalent lower bits */
 	data = ((1 << ROCKCHIP_DRV_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 	return ret;
 }
 
@@ -46,16 +46,15 @@ static int rk3288_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 	reg += rockchip_get_mux_data(mux_type, pin, &bit, &mask);
 
 	/* bank0 is special, there are no higher 16 bit writing bits. */
-	if (bank->bank_num == 0) {
-		regmap_read(regmap, reg, &data);
-		data &= ~(mask << bit);
-	} else {
-		/* enable the write to the equivalent lower bits */
-		data = (mask << (bit + 16));
-	}
+	if (bank->bank_num == 0)
+		return rockchip_pinctrl_update_bits(bank, regmap, reg,
+						    mask << bit,
+						    (mux & mask) << bit);
 
+	/* enable the write to the equivalent lower bits */
+	data = (mask << (bit + 16));
 	data |= (mux & mask) << bit;
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -108,16 +107,15 @@ static int rk3288_set_pull(struct rockchip_pin_bank *bank,
 	}
 
 	/* bank0 is special, there are no higher 16 bit writing bits */
-	if (bank->bank_num == 0) {
-		regmap_read(regmap, reg, &data);
-		data &= ~(((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << bit);
-	} else {
-		/* enable the write to the equivalent lower bits */
-		data = ((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << (bit + 16);
-	}
+	if (bank->bank_num == 0)
+		return rockchip_pinctrl_update_bits(bank, regmap, reg,
+				((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << bit,
+				ret << bit);
 
+	/* enable the write to the equivalent lower bits */
+	data = ((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -166,16 +164,15 @@ static int rk3288_set_drive(struct rockchip_pin_bank *bank,
 	}
 
 	/* bank0 is special, there are no higher 16 bit writing bits. */
-	if (bank->bank_num == 0) {
-		regmap_read(regmap, reg, &data);
-		data &= ~(((1 << ROCKCHIP_DRV_BITS_PER_PIN) - 1) << bit);
-	} else {
-		/* enable the write to the equivalent lower bits */
-		data = ((1 << ROCKCHIP_DRV_BITS_PER_PIN) - 1) << (bit + 16);
-	}
+	if (bank->bank_num == 0)
+		return rockchip_pinctrl_update_bits(bank, regmap, reg,
+				((1 << ROCKCHIP_DRV_BITS_PER_PIN) - 1) << bit,
+				ret << bit);
 
+	/* enable the write to the equivalent lower bits */
+	data = ((1 << ROCKCHIP_DRV_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 	return ret;
 }
 
@@ -484,7 +484,7 @@ static int rk3308_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 
 	data = (mask << (bit + 16));
 	data |= (mux & mask) << bit;
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -573,7 +573,7 @@ static int rk3308_set_pull(struct rockchip_pin_bank *bank,
 	data = ((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << (bit + 16);
 
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -592,7 +592,7 @@ static int rk3308_set_drive(struct rockchip_pin_bank *bank,
 	data = ((1 << ROCKCHIP_DRV_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (strength << bit);
 
-	return regmap_write(regmap, reg, data);
+	return rockchip_pinctrl_write(bank, regmap, reg, data);
 }
 
 static int rk3308_set_schmitt(struct rockchip_pin_bank *bank,
@@ -607,7 +607,7 @@ static int rk3308_set_schmitt(struct rockchip_pin_bank *bank,
 	/* enable the write to the equivalent lower bits */
 	data = BIT(bit + 16) | (enable << bit);
 
-	return regmap_write(regmap, reg, data);
+	return rockchip_pinctrl_write(bank, regmap, reg, data);
 }
 
 static struct rockchip_pin_bank rk3308_pin_banks[] = {
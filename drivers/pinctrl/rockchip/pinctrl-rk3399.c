@@ -69,7 +69,7 @@ static int rk3399_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 
 	data = (mask << (bit + 16));
 	data |= (mux & mask) << bit;
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -126,7 +126,7 @@ static int rk3399_set_pull(struct rockchip_pin_bank *bank,
 	/* enable the write to the equivalent lower bits */
 	data = ((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -186,13 +186,13 @@ static int rk3399_set_drive(struct rockchip_pin_bank *bank,
 			temp = (ret >> 0x1) & 0x3;
 
 			data |= BIT(31);
-			ret = regmap_write(regmap, reg, data);
+			ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 			if (ret)
 				return ret;
 
 			temp |= (0x3 << 16);
 			reg += 0x4;
-			ret = regmap_write(regmap, reg, temp);
+			ret = rockchip_pinctrl_write(bank, regmap, reg, temp);
 
 			return ret;
 		case 18 ... 21:
@@ -220,7 +220,7 @@ static int rk3399_set_drive(struct rockchip_pin_bank *bank,
 	/* enable the write to the equivalent lower bits */
 	data = ((1 << rmask_bits) - 1) << (bit + 16);
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
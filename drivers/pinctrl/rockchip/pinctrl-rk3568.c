@@ -130,7 +130,7 @@ static int rk3568_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 
 	data = (mask << (bit + 16));
 	data |= (mux & mask) << bit;
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -240,7 +240,7 @@ static int rk3568_set_pull(struct rockchip_pin_bank *bank,
 	data = ((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << (bit + 16);
 
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -261,7 +261,7 @@ static int rk3568_set_drive(struct rockchip_pin_bank *bank,
 	data = ((1 << RK3568_DRV_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (drv << bit);
 
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 	if (ret)
 		return ret;
 
@@ -283,7 +283,7 @@ static int rk3568_set_drive(struct rockchip_pin_bank *bank,
 	data = ((1 << RK3568_DRV_BITS_PER_PIN) - 1) << 16;
 	data |= drv;
 
-	return regmap_write(regmap, reg, data);
+	return rockchip_pinctrl_write(bank, regmap, reg, data);
 }
 
 static int rk3568_set_schmitt(struct rockchip_pin_bank *bank,
@@ -300,7 +300,7 @@ static int rk3568_set_schmitt(struct rockchip_pin_bank *bank,
 	data = ((1 << RK3568_SCHMITT_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (enable << bit);
 
-	return regmap_write(regmap, reg, data);
+	return rockchip_pinctrl_write(bank, regmap, reg, data);
 }
 static struct rockchip_pin_bank rk3568_pin_banks[] = {
 	PIN_BANK_IOMUX_FLAGS(0, 32, "gpio0", IOMUX_SOURCE_PMU | IOMUX_WIDTH_4BIT,
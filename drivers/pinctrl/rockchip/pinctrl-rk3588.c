@@ -37,30 +37,32 @@ static int rk3588_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 				reg0 = reg + 0x4000 - 0xC; /* PMU2_IOC_BASE */
 				data = (mask << (bit + 16));
 				data |= (mux & mask) << bit;
-				ret = regmap_write(regmap, reg0, data);
+				ret = rockchip_pinctrl_write(bank, regmap,
+							     reg0, data);
 
 				reg0 = reg + 0x8000; /* BUS_IOC_BASE */
 				data = (mask << (bit + 16));
 				regmap = priv->regmap_base;
-				regmap_write(regmap, reg0, data);
+				rockchip_pinctrl_write(bank, regmap, reg0, data);
 			} else {
 				u32 reg0 = 0;
 
 				reg0 = reg + 0x4000 - 0xC; /* PMU2_IOC_BASE */
 				data = (mask << (bit + 16));
 				data |= 8 << bit;
-				ret = regmap_write(regmap, reg0, data);
+				ret = rockchip_pinctrl_write(bank, regmap,
+							     reg0, data);
 
 				reg0 = reg + 0x8000; /* BUS_IOC_BASE */
 				data = (mask << (bit + 16));
 				data |= mux << bit;
 				regmap = priv->regmap_base;
-				regmap_write(regmap, reg0, data);
+				rockchip_pinctrl_write(bank, regmap, reg0, data);
 			}
 		} else {
 			data = (mask << (bit + 16));
 			data |= (mux & mask) << bit;
-			ret = regmap_write(regmap, reg, data);
+			ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 		}
 		return ret;
 	} else if (bank->bank_num > 0) {
@@ -70,7 +72,7 @@ static int rk3588_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 	data = (mask << (bit + 16));
 	data |= (mux & mask) << bit;
 
-	return regmap_write(regmap, reg, data);
+	return rockchip_pinctrl_write(bank, regmap, reg, data);
 }
 
 #define rk3588_DRV_PMU_OFFSET		0x70
@@ -277,7 +279,7 @@ static int rk3588_set_pull(struct rockchip_pin_bank *bank,
 	data = ((1 << ROCKCHIP_PULL_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (pull << bit);
 
-	return regmap_write(regmap, reg, data);
+	return rockchip_pinctrl_write(bank, regmap, reg, data);
 }
 
 static int rk3588_set_drive(struct rockchip_pin_bank *bank,
@@ -294,7 +296,7 @@ static int rk3588_set_drive(struct rockchip_pin_bank *bank,
 	data = ((1 << rk3588_DRV_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (strength << bit);
 
-	return regmap_write(regmap, reg, data);
+	return rockchip_pinctrl_write(bank, regmap, reg, data);
 }
 
 static int rk3588_set_schmitt(struct rockchip_pin_bank *bank,
@@ -311,7 +313,7 @@ static int rk3588_set_schmitt(struct rockchip_pin_bank *bank,
 	data = ((1 << RK3588_SMT_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (enable << bit);
 
-	return regmap_write(regmap, reg, data);
+	return rockchip_pinctrl_write(bank, regmap, reg, data);
 }
 
 static struct rockchip_pin_bank rk3588_pin_banks[] = {
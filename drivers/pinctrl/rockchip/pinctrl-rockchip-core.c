@@ -9,6 +9,7 @@
 #include <regmap.h>
 #include <syscon.h>
 #include <fdtdec.h>
+#include <malloc.h>
 
 #include "pinctrl-rockchip.h"
 
@@ -16,6 +17,114 @@
 #define MAX_ROCKCHIP_GPIO_PER_BANK      32
 #define RK_FUNC_GPIO                    0
 
+#if CONFIG_IS_ENABLED(PINCTRL_ROCKCHIP_STATE_CACHE)
+#define MAX_ROCKCHIP_PIN_WRITES		(MAX_ROCKCHIP_PINS_ENTRIES * 8)
+
+/**
+ * struct rockchip_pin_write - one register write of a compiled pin state
+ *
+ * @regmap: GRF or PMUGRF
+ * @reg: register offset
+ * @mask: bits to change
+ * @val: new value of the bits in @mask
+ * @hiword: the upper 16 bits of the register are write enables for the
+ *	    lower 16 bits, otherwise the register is read-modify-written
+ */
+struct rockchip_pin_write {
+	struct regmap	*regmap;
+	u32		reg;
+	u32		mask;
+	u32		val;
+	bool		hiword;
+};
+
+/**
+ * struct rockchip_pin_state - a pin configuration node compiled to writes
+ *
+ * @list: entry in rockchip_pinctrl_priv.states
+ * @node: the pin configuration node
+ * @count: number of entries in @writes
+ * @writes: register writes, in the order they must be done
+ */
+struct rockchip_pin_state {
+	struct list_head		list;
+	ofnode				node;
+	int				count;
+	struct rockchip_pin_write	writes[];
+};
+
+static int rockchip_pinctrl_record(struct rockchip_pinctrl_priv *priv,
+				   struct regmap *regmap, uint reg, uint mask,
+				   uint val, bool hiword)
+{
+	struct rockchip_pin_write *w;
+	int i;
+
+	/*
+	 * Fold the write into the last one to the same register. Pins are
+	 * independent fields, so only the order of writes to one register
+	 * matters.
+	 */
+	for (i = priv->nwrites - 1; i >= 0; i--) {
+		w = &priv->writes[i];
+		if (w->regmap != regmap || w->reg != reg)
+			continue;
+		if (w->hiword != hiword)
+			break;
+
+		w->mask |= mask;
+		w->val = (w->val & ~mask) | (val & mask);
+		return 0;
+	}
+
+	if (priv->nwrites == MAX_ROCKCHIP_PIN_WRITES)
+		return -ENOSPC;
+
+	w = &priv->writes[priv->nwrites++];
+	w->regmap = regmap;
+	w->reg = reg;
+	w->mask = mask;
+	w->val = val & mask;
+	w->hiword = hiword;
+
+	return 0;
+}
+#endif
+
+/*
+ * Write a GRF register whose upper 16 bits are write enables for the lower
+ * 16 bits. While a pin state is being compiled the write is only recorded.
+ */
+int rockchip_pinctrl_write(struct rockchip_pin_bank *bank,
+			   struct regmap *regmap, uint reg, uint val)
+{
+#if CONFIG_IS_ENABLED(PINCTRL_ROCKCHIP_STATE_CACHE)
+	struct rockchip_pinctrl_priv *priv = bank->priv;
+
+	if (priv->writes)
+		return rockchip_pinctrl_record(priv, regmap, reg, val >> 16,
+					       val & 0xffff, true);
+#endif
+
+	return regmap_write(regmap, reg, val);
+}
+
+/* Same as rockchip_pinctrl_write() for registers without write enables */
+int rockchip_pinctrl_update_bits(struct rockchip_pin_bank *bank,
+				 struct regmap *regmap, uint reg, uint mask,
+				 uint val)
+{
+#if CONFIG_IS_ENABLED(PINCTRL_ROCKCHIP_STATE_CACHE)
+	struct rockchip_pinctrl_priv *priv = bank->priv;
+
+	if (priv->writes)
+		return rockchip_pinctrl_record(priv, regmap, reg, mask, val,
+					       false);
+#endif
+
+	return regmap_update_bits(regmap, reg, mask, val);
+}
+
 static int rockchip_verify_config(struct udevice *dev, u32 bank, u32 pin)
 {
 	struct rockchip_pinctrl_priv *priv = dev_get_priv(dev);
@@ -229,13 +338,16 @@ static int rockchip_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 			else
 				regmap = priv->regmap_base;
 
-			regmap_write(regmap, route_reg, route_val);
+			rockchip_pinctrl_write(bank, regmap, route_reg,
+					       route_val);
 			break;
 		case ROUTE_TYPE_TOPGRF:
-			regmap_write(priv->regmap_base, route_reg, route_val);
+			rockchip_pinctrl_write(bank, priv->regmap_base,
+					       route_reg, route_val);
 			break;
 		case ROUTE_TYPE_PMUGRF:
-			regmap_write(priv->regmap_pmu, route_reg, route_val);
+			rockchip_pinctrl_write(bank, priv->regmap_pmu,
+					       route_reg, route_val);
 			break;
 		case ROUTE_TYPE_INVALID: /* Fall through */
 		default:
@@ -415,8 +527,8 @@ static int rockchip_pinconf_prop_name_to_param(const char *property,
 	return -EPERM;
 }
 
-static int rockchip_pinctrl_set_state(struct udevice *dev,
-				      struct udevice *config)
+static int rockchip_pinctrl_config_pins(struct udevice *dev,
+					struct udevice *config)
 {
 	struct rockchip_pinctrl_priv *priv = dev_get_priv(dev);
 	struct rockchip_pin_ctrl *ctrl = priv->ctrl;
@@ -505,6 +617,87 @@ static int rockchip_pinctrl_set_state(struct udevice *dev,
 	return 0;
 }
 
+#if CONFIG_IS_ENABLED(PINCTRL_ROCKCHIP_STATE_CACHE)
+/*
+ * Find the compiled form of a pin configuration node, compiling it on first
+ * use by running the normal per-pin code with the register writes recorded
+ * instead of done.
+ */
+static struct rockchip_pin_state *
+rockchip_pinctrl_get_state(struct udevice *dev, struct udevice *config)
+{
+	struct rockchip_pinctrl_priv *priv = dev_get_priv(dev);
+	struct rockchip_pin_state *state;
+	ofnode node = dev_ofnode(config);
+	int ret;
+
+	list_for_each_entry(state, &priv->states, list) {
+		if (ofnode_equal(state->node, node))
+			return state;
+	}
+
+	priv->writes = calloc(MAX_ROCKCHIP_PIN_WRITES, sizeof(*priv->writes));
+	if (!priv->writes)
+		return NULL;
+	priv->nwrites = 0;
+
+	ret = rockchip_pinctrl_config_pins(dev, config);
+	state = NULL;
+	if (!ret)
+		state = malloc(sizeof(*state) +
+			       priv->nwrites * sizeof(*priv->writes));
+	if (state) {
+		state->node = node;
+		state->count = priv->nwrites;
+		memcpy(state->writes, priv->writes,
+		       priv->nwrites * sizeof(*priv->writes));
+		list_add_tail(&state->list, &priv->states);
+		debug("%s: %s compiled to %d writes\n", __func__, config->name,
+		      state->count);
+	}
+
+	free(priv->writes);
+	priv->writes = NULL;
+
+	return state;
+}
+
+static int rockchip_pinctrl_apply_state(struct rockchip_pin_state *state)
+{
+	struct rockchip_pin_write *w;
+	int i, ret;
+
+	for (i = 0; i < state->count; i++) {
+		w = &state->writes[i];
+		if (w->hiword)
+			ret = regmap_write(w->regmap, w->reg,
+					   (w->mask << 16) | w->val);
+		else
+			ret = regmap_update_bits(w->regmap, w->reg, w->mask,
+						 w->val);
+		if (ret)
+			return ret;
+	}
+
+	return 0;
+}
+#endif
+
+static int rockchip_pinctrl_set_state(struct udevice *dev,
+				      struct udevice *config)
+{
+#if CONFIG_IS_ENABLED(PINCTRL_ROCKCHIP_STATE_CACHE)
+	struct rockchip_pin_state *state;
+
+	/* Fall back to the per-pin path if the state cannot be compiled */
+	state = rockchip_pinctrl_get_state(dev, config);
+	if (state)
+		return rockchip_pinctrl_apply_state(state);
+#endif
+
+	return rockchip_pinctrl_config_pins(dev, config);
+}
+
 static int rockchip_pinctrl_get_pins_count(struct udevice *dev)
 {
 	struct rockchip_pinctrl_priv *priv = dev_get_priv(dev);
@@ -634,10 +827,9 @@ static struct rockchip_pin_ctrl *rockchip_pinctrl_get_soc_data(struct udevice *d
 	return ctrl;
 }
 
-int rockchip_pinctrl_probe(struct udevice *dev)
+static int rockchip_pinctrl_get_regmaps(struct udevice *dev)
 {
 	struct rockchip_pinctrl_priv *priv = dev_get_priv(dev);
-	struct rockchip_pin_ctrl *ctrl;
 	struct udevice *syscon;
 	struct regmap *regmap;
 	int ret = 0;
@@ -671,6 +863,22 @@ int rockchip_pinctrl_probe(struct udevice *dev)
 		priv->regmap_pmu = regmap;
 	}
 
+	return 0;
+}
+
+int rockchip_pinctrl_probe(struct udevice *dev)
+{
+	struct rockchip_pinctrl_priv *priv = dev_get_priv(dev);
+	struct rockchip_pin_ctrl *ctrl;
+	int ret;
+
+	/* The driver may have set up the GRF regmaps itself */
+	if (!priv->regmap_base) {
+		ret = rockchip_pinctrl_get_regmaps(dev);
+		if (ret)
+			return ret;
+	}
+
 	ctrl = rockchip_pinctrl_get_soc_data(dev);
 	if (!ctrl) {
 		debug("driver data not available\n");
@@ -678,5 +886,8 @@ int rockchip_pinctrl_probe(struct udevice *dev)
 	}
 
 	priv->ctrl = ctrl;
+#if CONFIG_IS_ENABLED(PINCTRL_ROCKCHIP_STATE_CACHE)
+	INIT_LIST_HEAD(&priv->states);
+#endif
 	return 0;
 }
@@ -7,6 +7,7 @@
 #define __DRIVERS_PINCTRL_ROCKCHIP_H
 
 #include <dt-bindings/pinctrl/rockchip.h>
+#include <linux/list.h>
 #include <linux/types.h>
 
 #define RK_GPIO0_A0	0
@@ -552,12 +553,25 @@ struct rockchip_pin_ctrl {
 			       int pin_num, int enable);
 };
 
+struct rockchip_pin_write;
+
 /**
+ * @ctrl: SoC description
+ * @regmap_base: GRF registers
+ * @regmap_pmu: PMUGRF registers, if the SoC has them
+ * @states: pin states already compiled to register writes
+ * @writes: register writes of the state being compiled, NULL otherwise
+ * @nwrites: number of entries used in @writes
  */
 struct rockchip_pinctrl_priv {
 	struct rockchip_pin_ctrl	*ctrl;
 	struct regmap			*regmap_base;
 	struct regmap			*regmap_pmu;
+#if CONFIG_IS_ENABLED(PINCTRL_ROCKCHIP_STATE_CACHE)
+	struct list_head		states;
+	struct rockchip_pin_write	*writes;
+	int				nwrites;
+#endif
 };
 
 extern const struct pinctrl_ops rockchip_pinctrl_ops;
@@ -567,5 +581,10 @@ void rockchip_get_recalced_mux(struct rockchip_pin_bank *bank, int pin,
 int rockchip_get_mux_data(int mux_type, int pin, u8 *bit, int *mask);
 int rockchip_translate_drive_value(int type, int strength);
 int rockchip_translate_pull_value(int type, int pull);
+int rockchip_pinctrl_write(struct rockchip_pin_bank *bank,
+			   struct regmap *regmap, uint reg, uint val);
+int rockchip_pinctrl_update_bits(struct rockchip_pin_bank *bank,
+				 struct regmap *regmap, uint reg, uint mask,
+				 uint val);
 
 #endif /* __DRIVERS_PINCTRL_ROCKCHIP_H */
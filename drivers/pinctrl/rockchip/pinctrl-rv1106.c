@@ -38,7 +38,7 @@ static int rv1106_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
 
 	debug("iomux write reg = %x data = %x\n", reg, data);
 
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -110,7 +110,7 @@ static int rv1106_set_drive(struct rockchip_pin_bank *bank,
 	/* enable the write to the equivalent lower bits */
 	data = ((1 << RV1106_DRV_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (drv << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -191,7 +191,7 @@ static int rv1106_set_pull(struct rockchip_pin_bank *bank,
 	data = ((1 << RV1106_PULL_BITS_PER_PIN) - 1) << (bit + 16);
 
 	data |= (ret << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -265,7 +265,7 @@ static int rv1106_set_schmitt(struct rockchip_pin_bank *bank,
 	/* enable the write to the equivalent lower bits */
 	data = ((1 << RV1106_SMT_BITS_PER_PIN) - 1) << (bit + 16);
 	data |= (enable << bit);
-	ret = regmap_write(regmap, reg, data);
+	ret = rockchip_pinctrl_write(bank, regmap, reg, data);
 
 	return ret;
 }
@@ -0,0 +1,187 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * A made-up Rockchip SoC for testing the common pinctrl code on sandbox.
+ * The GRF and PMUGRF are the two ranges of the node's "reg" property.
+ *
+ * gpio0 lives in the PMUGRF, which has no write enable bits, like bank 0 of
+ * the RK3288. gpio1 lives in the GRF and uses 4-bit iomuxes with write
+ * enables in the upper 16 bits, like the RK3568. Both banks have 2-bit pull
+ * and drive fields, 8 pins per register.
+ */
+
+#include <common.h>
+#include <dm.h>
+#include <dm/pinctrl.h>
+#include <regmap.h>
+
+#include "pinctrl-rockchip.h"
+
+#define SANDBOX_PULL_PMU_OFFSET		0x10
+#define SANDBOX_PULL_GRF_OFFSET		0x20
+#define SANDBOX_DRV_PMU_OFFSET		0x20
+#define SANDBOX_DRV_GRF_OFFSET		0x30
+#define SANDBOX_BITS_PER_PIN		2
+#define SANDBOX_PINS_PER_REG		8
+
+struct sandbox_rockchip_pinctrl_priv {
+	struct rockchip_pinctrl_priv	pinctrl;	/* must be first */
+	struct regmap			grf;
+	struct regmap			pmugrf;
+};
+
+static int sandbox_set_mux(struct rockchip_pin_bank *bank, int pin, int mux)
+{
+	struct rockchip_pinctrl_priv *priv = bank->priv;
+	int iomux_num = (pin / 8);
+	int reg, mask, mux_type;
+	u8 bit;
+	u32 data;
+
+	mux_type = bank->iomux[iomux_num].type;
+	reg = bank->iomux[iomux_num].offset;
+	reg += rockchip_get_mux_data(mux_type, pin, &bit, &mask);
+
+	if (bank->bank_num == 0)
+		return rockchip_pinctrl_update_bits(bank, priv->regmap_pmu, reg,
+						    mask << bit,
+						    (mux & mask) << bit);
+
+	data = (mask << (bit + 16));
+	data |= (mux & mask) << bit;
+
+	return rockchip_pinctrl_write(bank, priv->regmap_base, reg, data);
+}
+
+static int sandbox_set_field(struct rockchip_pin_bank *bank, int pin_num,
+			     int pmu_offset, int grf_offset, u32 value)
+{
+	struct rockchip_pinctrl_priv *priv = bank->priv;
+	u32 mask = (1 << SANDBOX_BITS_PER_PIN) - 1;
+	int reg;
+	u8 bit;
+
+	reg = (pin_num / SANDBOX_PINS_PER_REG) * 4;
+	bit = (pin_num % SANDBOX_PINS_PER_REG) * SANDBOX_BITS_PER_PIN;
+
+	if (bank->bank_num == 0)
+		return rockchip_pinctrl_update_bits(bank, priv->regmap_pmu,
+						    pmu_offset + reg,
+						    mask << bit, value << bit);
+
+	return rockchip_pinctrl_write(bank, priv->regmap_base,
+				      grf_offset + reg,
+				      (mask << (bit + 16)) | (value << bit));
+}
+
+static int sandbox_set_pull(struct rockchip_pin_bank *bank,
+			    int pin_num, int pull)
+{
+	int ret;
+
+	if (pull == PIN_CONFIG_BIAS_PULL_PIN_DEFAULT)
+		return -ENOTSUPP;
+
+	ret = rockchip_translate_pull_value(bank->pull_type[pin_num / 8],
+					    pull);
+	if (ret < 0) {
+		debug("unsupported pull setting %d\n", pull);
+		return ret;
+	}
+
+	return sandbox_set_field(bank, pin_num, SANDBOX_PULL_PMU_OFFSET,
+				 SANDBOX_PULL_GRF_OFFSET, ret);
+}
+
+static int sandbox_set_drive(struct rockchip_pin_bank *bank,
+			     int pin_num, int strength)
+{
+	int ret;
+
+	ret = rockchip_translate_drive_value(bank->drv[pin_num / 8].drv_type,
+					     strength);
+	if (ret < 0) {
+		debug("unsupported driver strength %d\n", strength);
+		return ret;
+	}
+
+	return sandbox_set_field(bank, pin_num, SANDBOX_DRV_PMU_OFFSET,
+				 SANDBOX_DRV_GRF_OFFSET, ret);
+}
+
+static struct rockchip_pin_bank sandbox_pin_banks[] = {
+	PIN_BANK_IOMUX_FLAGS(0, 32, "gpio0",
+			     IOMUX_SOURCE_PMU | IOMUX_WRITABLE_32BIT,
+			     IOMUX_SOURCE_PMU | IOMUX_WRITABLE_32BIT,
+			     IOMUX_SOURCE_PMU | IOMUX_WRITABLE_32BIT,
+			     IOMUX_SOURCE_PMU | IOMUX_WRITABLE_32BIT),
+	PIN_BANK_IOMUX_FLAGS(1, 32, "gpio1", IOMUX_WIDTH_4BIT,
+			     IOMUX_WIDTH_4BIT,
+			     IOMUX_WIDTH_4BIT,
+			     IOMUX_WIDTH_4BIT),
+};
+
+static struct rockchip_pin_ctrl sandbox_pin_ctrl = {
+	.pin_banks		= sandbox_pin_banks,
+	.nr_banks		= ARRAY_SIZE(sandbox_pin_banks),
+	.nr_pins		= 64,
+	.grf_mux_offset		= 0x0,
+	.pmu_mux_offset		= 0x0,
+	.set_mux		= sandbox_set_mux,
+	.set_pull		= sandbox_set_pull,
+	.set_drive		= sandbox_set_drive,
+};
+
+static int sandbox_rockchip_regmap_init(struct udevice *dev, int index,
+					struct regmap *map)
+{
+	fdt_addr_t addr;
+
+	addr = dev_read_addr_index(dev, index);
+	if (addr == FDT_ADDR_T_NONE)
+		return -EINVAL;
+
+	map->base = addr;
+	map->range = &map->base_range;
+	map->range_count = 1;
+	map->base_range.start = addr;
+
+	return 0;
+}
+
+static int sandbox_rockchip_pinctrl_probe(struct udevice *dev)
+{
+	struct sandbox_rockchip_pinctrl_priv *priv = dev_get_priv(dev);
+	int ret;
+
+	ret = sandbox_rockchip_regmap_init(dev, 0, &priv->grf);
+	if (ret)
+		return ret;
+
+	ret = sandbox_rockchip_regmap_init(dev, 1, &priv->pmugrf);
+	if (ret)
+		return ret;
+
+	priv->pinctrl.regmap_base = &priv->grf;
+	priv->pinctrl.regmap_pmu = &priv->pmugrf;
+
+	return rockchip_pinctrl_probe(dev);
+}
+
+static const struct udevice_id sandbox_rockchip_pinctrl_ids[] = {
+	{
+		.compatible = "sandbox,rockchip-pinctrl",
+		.data = (ulong)&sandbox_pin_ctrl
+	},
+	{ }
+};
+
+U_BOOT_DRIVER(sandbox_rockchip_pinctrl) = {
+	.name		= "sandbox_rockchip_pinctrl",
+	.id		= UCLASS_PINCTRL,
+	.of_match	= sandbox_rockchip_pinctrl_ids,
+	.priv_auto_alloc_size = sizeof(struct sandbox_rockchip_pinctrl_priv),
+	.ops		= &rockchip_pinctrl_ops,
+	.probe		= sandbox_rockchip_pinctrl_probe,
+};
@@ -10,6 +10,7 @@
 #include <console.h>
 #include <dm.h>
 #include <errno.h>
+#include <event_loop.h>
 #include <key.h>
 #include <led.h>
 #include <rtc.h>
@@ -914,7 +915,7 @@ show_images:
 			system_suspend_enter(dev);
 		}
 
-		mdelay(5);
+		event_loop_sleep(5);
 
 		/* It's time to show next image ? */
 		if (get_timer(show_start) > image[show_idx].period) {
@@ -11,6 +11,7 @@
 #include <i2c.h>
 #include <power/pmic.h>
 #include <power/sandbox_pmic.h>
+#include <asm/test.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -19,12 +20,25 @@ DECLARE_GLOBAL_DATA_PTR;
  *
  * @rw_reg: PMICs register of the chip I/O transaction
  * @reg:    PMICs registers array
+ * @xfers:  number of bus transactions seen
  */
 struct sandbox_i2c_pmic_plat_data {
 	u8 rw_reg;
 	u8 reg[SANDBOX_PMIC_REG_COUNT];
+	int xfers;
 };
 
+int sandbox_i2c_pmic_xfer_count(struct udevice *emul, bool reset)
+{
+	struct sandbox_i2c_pmic_plat_data *plat = dev_get_platdata(emul);
+	int xfers = plat->xfers;
+
+	if (reset)
+		plat->xfers = 0;
+
+	return xfers;
+}
+
 static int sandbox_i2c_pmic_read_data(struct udevice *emul, uchar chip,
 				      uchar *buffer, int len)
 {
@@ -80,8 +94,11 @@ static int sandbox_i2c_pmic_write_data(struct udevice *emul, uchar chip,
 static int sandbox_i2c_pmic_xfer(struct udevice *emul, struct i2c_msg *msg,
 				 int nmsgs)
 {
+	struct sandbox_i2c_pmic_plat_data *plat = dev_get_platdata(emul);
 	int ret = 0;
 
+	plat->xfers++;
+
 	for (; nmsgs > 0; nmsgs--, msg++) {
 		bool next_is_read = nmsgs > 1 && (msg[1].flags & I2C_M_RD);
 		if (msg->flags & I2C_M_RD) {
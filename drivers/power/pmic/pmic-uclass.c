@@ -14,6 +14,7 @@
 #include <dm/device-internal.h>
 #include <dm/uclass-internal.h>
 #include <dm/of_access.h>
+#include <malloc.h>
 #include <power/pmic.h>
 #include <linux/ctype.h>
 
@@ -126,9 +127,173 @@ int pmic_reg_count(struct udevice *dev)
 	return ops->reg_count(dev);
 }
 
+/**
+ * struct pmic_cache - per-device register cache
+ *
+ * @info:	volatile registers and burst size given by the driver
+ * @count:	number of registers covered
+ * @val:	cached register values
+ * @valid:	non-zero if val[reg] holds the device's value
+ * @defer:	hold back writes, see pmic_cache_defer()
+ * @burst_reg:	first register of the held-back write
+ * @burst_len:	number of registers held back
+ * @burst:	held-back register values
+ */
+struct pmic_cache {
+	const struct pmic_cache_info *info;
+	int count;
+	u8 *val;
+	u8 *valid;
+	bool defer;
+	uint burst_reg;
+	int burst_len;
+	u8 *burst;
+};
+
+#if CONFIG_IS_ENABLED(PMIC_REG_CACHE)
+static struct pmic_cache *pmic_get_cache(struct udevice *dev)
+{
+	struct pmic_cache *cache = dev_get_uclass_priv(dev);
+
+	return cache && cache->val ? cache : NULL;
+}
+
+static bool pmic_cache_volatile(struct pmic_cache *cache, uint reg, int len)
+{
+	const struct pmic_reg_range *range;
+	int i;
+
+	if (reg + len > cache->count)
+		return true;
+
+	for (i = 0; i < cache->info->num_volatile; i++) {
+		range = &cache->info->volatile_regs[i];
+		if (reg <= range->max && reg + len - 1 >= range->min)
+			return true;
+	}
+
+	return false;
+}
+
+static int pmic_cache_flush(struct udevice *dev, struct pmic_cache *cache)
+{
+	const struct dm_pmic_ops *ops = dev_get_driver_ops(dev);
+	int len = cache->burst_len;
+	int ret;
+
+	if (!len)
+		return 0;
+
+	cache->burst_len = 0;
+	debug("%s: reg=%x, len=%d\n", __func__, cache->burst_reg, len);
+
+	ret = ops->write(dev, cache->burst_reg, cache->burst, len);
+	if (ret)	/* The device may not hold what we cached */
+		memset(cache->valid + cache->burst_reg, 0, len);
+
+	return ret;
+}
+
+static int pmic_cache_hold(struct udevice *dev, struct pmic_cache *cache,
+			   uint reg, const uint8_t *buffer, int len)
+{
+	int max_burst = max(cache->info->max_burst, 1);
+	uint end = cache->burst_reg + cache->burst_len;
+	int ret;
+
+	/* Merge with the held-back write if it stays one burst */
+	if (cache->burst_len && reg >= cache->burst_reg && reg <= end &&
+	    reg + len <= cache->burst_reg + max_burst) {
+		memcpy(cache->burst + reg - cache->burst_reg, buffer, len);
+		cache->burst_len = max(end, reg + len) - cache->burst_reg;
+		return 0;
+	}
+
+	ret = pmic_cache_flush(dev, cache);
+	if (ret)
+		return ret;
+
+	cache->burst_reg = reg;
+	cache->burst_len = len;
+	memcpy(cache->burst, buffer, len);
+
+	return 0;
+}
+
+int pmic_cache_init(struct udevice *dev, const struct pmic_cache_info *info)
+{
+	struct pmic_cache *cache = dev_get_uclass_priv(dev);
+	int count;
+
+	count = pmic_reg_count(dev);
+	if (count <= 0)
+		return count ? count : -EINVAL;
+
+	free(cache->val);
+	cache->val = calloc(2 * count + max(info->max_burst, 1), 1);
+	if (!cache->val)
+		return -ENOMEM;
+
+	cache->valid = cache->val + count;
+	cache->burst = cache->valid + count;
+	cache->info = info;
+	cache->count = count;
+	cache->defer = false;
+	cache->burst_len = 0;
+
+	return 0;
+}
+
+void pmic_cache_defer(struct udevice *dev)
+{
+	struct pmic_cache *cache = pmic_get_cache(dev);
+
+	if (cache)
+		cache->defer = true;
+}
+
+int pmic_cache_sync(struct udevice *dev)
+{
+	struct pmic_cache *cache = pmic_get_cache(dev);
+
+	if (!cache)
+		return 0;
+
+	cache->defer = false;
+
+	return pmic_cache_flush(dev, cache);
+}
+#else
+static inline struct pmic_cache *pmic_get_cache(struct udevice *dev)
+{
+	return NULL;
+}
+
+static inline bool pmic_cache_volatile(struct pmic_cache *cache, uint reg,
+				       int len)
+{
+	return true;
+}
+
+static inline int pmic_cache_flush(struct udevice *dev,
+				   struct pmic_cache *cache)
+{
+	return 0;
+}
+
+static inline int pmic_cache_hold(struct udevice *dev,
+				  struct pmic_cache *cache, uint reg,
+				  const uint8_t *buffer, int len)
+{
+	return -ENOSYS;
+}
+#endif
+
 int pmic_read(struct udevice *dev, uint reg, uint8_t *buffer, int len)
 {
 	const struct dm_pmic_ops *ops = dev_get_driver_ops(dev);
+	struct pmic_cache *cache;
+	int i, ret;
 
 	if (!buffer)
 		return -EFAULT;
@@ -136,12 +301,40 @@ int pmic_read(struct udevice *dev, uint reg, uint8_t *buffer, int len)
 	if (!ops || !ops->read)
 		return -ENOSYS;
 
-	return ops->read(dev, reg, buffer, len);
+	cache = pmic_get_cache(dev);
+	if (!cache)
+		return ops->read(dev, reg, buffer, len);
+
+	if (!pmic_cache_volatile(cache, reg, len) &&
+	    !memchr(cache->valid + reg, 0, len)) {
+		memcpy(buffer, cache->val + reg, len);
+		return 0;
+	}
+
+	/* Going to the bus: let held-back writes go first */
+	ret = pmic_cache_flush(dev, cache);
+	if (ret)
+		return ret;
+
+	ret = ops->read(dev, reg, buffer, len);
+	if (ret)
+		return ret;
+
+	for (i = 0; i < len; i++) {
+		if (pmic_cache_volatile(cache, reg + i, 1))
+			continue;
+		cache->val[reg + i] = buffer[i];
+		cache->valid[reg + i] = 1;
+	}
+
+	return 0;
 }
 
 int pmic_write(struct udevice *dev, uint reg, const uint8_t *buffer, int len)
 {
 	const struct dm_pmic_ops *ops = dev_get_driver_ops(dev);
+	struct pmic_cache *cache;
+	int i, ret;
 
 	if (!buffer)
 		return -EFAULT;
@@ -149,7 +342,29 @@ int pmic_write(struct udevice *dev, uint reg, const uint8_t *buffer, int len)
 	if (!ops || !ops->write)
 		return -ENOSYS;
 
-	return ops->write(dev, reg, buffer, len);
+	cache = pmic_get_cache(dev);
+	if (!cache)
+		return ops->write(dev, reg, buffer, len);
+
+	if (cache->defer && !pmic_cache_volatile(cache, reg, len) &&
+	    len <= max(cache->info->max_burst, 1)) {
+		ret = pmic_cache_hold(dev, cache, reg, buffer, len);
+	} else {
+		ret = pmic_cache_flush(dev, cache);
+		if (!ret)
+			ret = ops->write(dev, reg, buffer, len);
+	}
+	if (ret)
+		return ret;
+
+	for (i = 0; i < len; i++) {
+		if (pmic_cache_volatile(cache, reg + i, 1))
+			continue;
+		cache->val[reg + i] = buffer[i];
+		cache->valid[reg + i] = 1;
+	}
+
+	return 0;
 }
 
 int pmic_reg_read(struct udevice *dev, uint reg)
@@ -178,6 +393,7 @@ int pmic_reg_write(struct udevice *dev, uint reg, uint value)
 
 int pmic_clrsetbits(struct udevice *dev, uint reg, uint clr, uint set)
 {
+	struct pmic_cache *cache;
 	u8 byte;
 	int ret;
 
@@ -186,6 +402,11 @@ int pmic_clrsetbits(struct udevice *dev, uint reg, uint clr, uint set)
 		return ret;
 	byte = (ret & ~clr) | set;
 
+	/* A cached register already holds this value, skip the bus */
+	cache = pmic_get_cache(dev);
+	if (cache && byte == ret && !pmic_cache_volatile(cache, reg, 1))
+		return 0;
+
 	return pmic_reg_write(dev, reg, byte);
 }
 
@@ -193,6 +414,7 @@ int pmic_suspend(struct udevice *dev)
 {
 	const struct dm_pmic_ops *ops = dev_get_driver_ops(dev);
 
+	pmic_cache_sync(dev);
 	if (!ops || !ops->suspend)
 		return -ENOSYS;
 
@@ -213,13 +435,27 @@ int pmic_shutdown(struct udevice *dev)
 {
 	const struct dm_pmic_ops *ops = dev_get_driver_ops(dev);
 
+	pmic_cache_sync(dev);
 	if (!ops || !ops->shutdown)
 		return -ENOSYS;
 
 	return ops->shutdown(dev);
 }
 
+static int pmic_pre_remove(struct udevice *dev)
+{
+	struct pmic_cache *cache = dev_get_uclass_priv(dev);
+
+	pmic_cache_sync(dev);
+	free(cache->val);
+	cache->val = NULL;
+
+	return 0;
+}
+
 UCLASS_DRIVER(pmic) = {
 	.id		= UCLASS_PMIC,
 	.name		= "pmic",
+	.pre_remove	= pmic_pre_remove,
+	.per_device_auto_alloc_size = sizeof(struct pmic_cache),
 };
@@ -164,6 +164,36 @@ static struct reg_data rk818_init_current[] = {
 	{ REG_USB_CTRL, 0x07, 0x0f}, /* 2A */
 };
 
+/*
+ * Registers that change on their own or have write-enable mask bits (the
+ * RK805/RK816 and RK817/RK809 POWER_EN registers do not read back what was
+ * written), so they can't be served from the register cache.
+ */
+static const struct pmic_reg_range rk808_volatile_regs[] = {
+	{ REG_SECONDS, 0x1f },			/* RTC, ID */
+	{ RK816_REG_DCDC_EN1, RK816_REG_DCDC_EN2 },
+	{ REG_DCDC_UV_STS, REG_LDO_PG },
+	{ RK816_INT_STS_REG1, RK816_INT_STS_MSK_REG3 },	/* DEVCTRL, INT */
+	{ REG_DCDC_ILMAX, 0xff },		/* charger, fuel gauge */
+};
+
+static const struct pmic_reg_range rk817_volatile_regs[] = {
+	{ 0x00, RK817_POWER_EN3 },		/* RTC, codec, fuel gauge */
+	{ 0xe4, 0xff },				/* charger, SYS_CFG, INT */
+};
+
+static const struct pmic_cache_info rk808_cache_info = {
+	.volatile_regs = rk808_volatile_regs,
+	.num_volatile = ARRAY_SIZE(rk808_volatile_regs),
+	.max_burst = 8,
+};
+
+static const struct pmic_cache_info rk817_cache_info = {
+	.volatile_regs = rk817_volatile_regs,
+	.num_volatile = ARRAY_SIZE(rk817_volatile_regs),
+	.max_burst = 8,
+};
+
 static const struct pmic_child_info pmic_children_info[] = {
 	{ .prefix = "DCDC", .driver = "rk8xx_buck"},
 	{ .prefix = "LDO", .driver = "rk8xx_ldo"},
@@ -479,6 +509,7 @@ static inline int rk8xx_irq_chip_init(struct udevice *dev) { return 0; }
 static int rk8xx_probe(struct udevice *dev)
 {
 	struct rk8xx_priv *priv = dev_get_priv(dev);
+	const struct pmic_cache_info *cache_info = &rk808_cache_info;
 	struct reg_data *init_current = NULL;
 	struct reg_data *init_data = NULL;
 	int init_current_num = 0;
@@ -555,6 +586,7 @@ static int rk8xx_probe(struct udevice *dev)
 		lp_act_msk = RK8XX_LP_ACTION_MSK;
 		init_data = rk817_init_reg;
 		init_data_num = ARRAY_SIZE(rk817_init_reg);
+		cache_info = &rk817_cache_info;
 
 		/* whether the system voltage can be shutdown in PWR_off mode */
 		if (priv->sys_can_sd) {
@@ -601,6 +633,10 @@ static int rk8xx_probe(struct udevice *dev)
 		return -EINVAL;
 	}
 
+	ret = pmic_cache_init(dev, cache_info);
+	if (ret)
+		printf("%s: no register cache, ret=%d\n", __func__, ret);
+
 	/* common init */
 	for (i = 0; i < init_data_num; i++) {
 		ret = pmic_clrsetbits(dev,
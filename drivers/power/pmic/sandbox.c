@@ -22,6 +22,17 @@ static const struct pmic_child_info pmic_children_info[] = {
 	{ },
 };
 
+/* The padding registers stand in for status registers in the tests */
+static const struct pmic_reg_range sandbox_pmic_volatile_regs[] = {
+	{ SANDBOX_PMIC_REG_LDO2_OM + 1, SANDBOX_PMIC_REG_COUNT - 1 },
+};
+
+static const struct pmic_cache_info sandbox_pmic_cache_info = {
+	.volatile_regs = sandbox_pmic_volatile_regs,
+	.num_volatile = ARRAY_SIZE(sandbox_pmic_volatile_regs),
+	.max_burst = OUT_REG_COUNT,
+};
+
 static int sandbox_pmic_reg_count(struct udevice *dev)
 {
 	return SANDBOX_PMIC_REG_COUNT;
@@ -59,6 +70,11 @@ static int sandbox_pmic_bind(struct udevice *dev)
 	return 0;
 }
 
+static int sandbox_pmic_probe(struct udevice *dev)
+{
+	return pmic_cache_init(dev, &sandbox_pmic_cache_info);
+}
+
 static struct dm_pmic_ops sandbox_pmic_ops = {
 	.reg_count = sandbox_pmic_reg_count,
 	.read = sandbox_pmic_read,
@@ -75,5 +91,6 @@ U_BOOT_DRIVER(sandbox_pmic) = {
 	.id = UCLASS_PMIC,
 	.of_match = sandbox_pmic_ids,
 	.bind = sandbox_pmic_bind,
+	.probe = sandbox_pmic_probe,
 	.ops = &sandbox_pmic_ops,
 };
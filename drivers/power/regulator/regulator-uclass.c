@@ -14,6 +14,30 @@
 
 DECLARE_GLOBAL_DATA_PTR;
 
+/**
+ * struct regulator_uc_priv - regulator uclass private data
+ *
+ * @ramp_batch:	collect ramp delays instead of waiting, see
+ *		regulator_ramp_batch_begin()
+ * @ramp_us:	longest ramp delay collected so far
+ * @ramp_gen:	bumped whenever the collected delays have been waited for
+ */
+struct regulator_uc_priv {
+	bool ramp_batch;
+	u32 ramp_us;
+	u32 ramp_gen;
+};
+
+/**
+ * struct regulator_dev_priv - regulator per-device uclass private data
+ *
+ * @ramp_gen:	value of regulator_uc_priv.ramp_gen when this rail was last
+ *		set up in a batch, so it may still be ramping if they match
+ */
+struct regulator_dev_priv {
+	u32 ramp_gen;
+};
+
 int regulator_mode(struct udevice *dev, struct dm_regulator_mode **modep)
 {
 	struct dm_regulator_uclass_platdata *uc_pdata;
@@ -65,8 +89,13 @@ int regulator_set_value(struct udevice *dev, int uV)
 	ret = ops->set_value(dev, uV);
 
 	if (!ret && (old_uV != -ENODATA) && (old_uV != uV)) {
+		struct regulator_uc_priv *priv = dev->uclass->priv;
+
 		us = DIV_ROUND_UP(abs(uV - old_uV), uc_pdata->ramp_delay);
-		udelay(us);
+		if (priv->ramp_batch)
+			priv->ramp_us = max(priv->ramp_us, us);
+		else
+			udelay(us);
 		debug("%s: ramp=%d, old_uV=%d, uV=%d, us=%d\n",
 		      uc_pdata->name, uc_pdata->ramp_delay, old_uV, uV, us);
 	}
@@ -498,19 +527,115 @@ int regulators_enable_state_mem(bool verbose)
 	return ret;
 }
 
+void regulator_ramp_batch_begin(void)
+{
+	struct regulator_uc_priv *priv;
+	struct uclass *uc;
+
+	if (uclass_get(UCLASS_REGULATOR, &uc))
+		return;
+
+	priv = uc->priv;
+	priv->ramp_batch = true;
+	priv->ramp_us = 0;
+	priv->ramp_gen++;
+}
+
+u32 regulator_ramp_batch_end(void)
+{
+	struct regulator_uc_priv *priv;
+	struct uclass *uc;
+	u32 us;
+
+	if (uclass_get(UCLASS_REGULATOR, &uc))
+		return 0;
+
+	priv = uc->priv;
+	us = priv->ramp_us;
+	priv->ramp_batch = false;
+	priv->ramp_us = 0;
+	udelay(us);
+
+	return us;
+}
+
+/* Send the PMIC register writes held back by pmic_cache_defer() */
+static void regulator_pmic_sync(void)
+{
+	struct udevice *pmic;
+
+	for (uclass_find_first_device(UCLASS_PMIC, &pmic);
+	     pmic;
+	     uclass_find_next_device(&pmic)) {
+		if (device_active(pmic))
+			pmic_cache_sync(pmic);
+	}
+}
+
+/* Whether @dev was set up in the current batch and may not be up yet */
+static bool regulator_ramp_pending(struct regulator_uc_priv *priv,
+				   struct udevice *dev)
+{
+	struct regulator_dev_priv *dev_priv = dev_get_uclass_priv(dev);
+
+	return priv->ramp_batch && dev_priv &&
+	       dev_priv->ramp_gen == priv->ramp_gen;
+}
+
+/* The rail feeding @dev, if it is a regulator */
+static struct udevice *regulator_get_supply(struct udevice *dev)
+{
+	struct udevice *supply;
+
+	if (device_get_uclass_id(dev_get_parent(dev)) == UCLASS_REGULATOR)
+		return dev_get_parent(dev);
+	if (!device_get_supply_regulator(dev, "vin-supply", &supply))
+		return supply;
+
+	return NULL;
+}
+
 int regulators_enable_boot_on(bool verbose)
 {
-	struct udevice *dev;
+	struct regulator_dev_priv *dev_priv;
+	struct regulator_uc_priv *priv;
+	struct udevice *dev, *pmic, *supply;
 	struct uclass *uc;
+	ulong start;
+	u32 ramp_us = 0;
 	int ret;
 
 	ret = uclass_get(UCLASS_REGULATOR, &uc);
 	if (ret)
 		return ret;
+
+	/*
+	 * Instead of waiting for each voltage ramp in turn, wait once for the
+	 * longest. PMIC register writes are held back and sent in bursts, see
+	 * pmic_cache_defer(). A rail fed by one set up earlier in the batch
+	 * has to wait for its supply to be up before it is enabled, though.
+	 */
+	start = timer_get_us();
+	priv = uc->priv;
+	regulator_ramp_batch_begin();
 	for (uclass_first_device(UCLASS_REGULATOR, &dev);
 	     dev;
 	     uclass_next_device(&dev)) {
+		supply = regulator_get_supply(dev);
+		if (supply && regulator_ramp_pending(priv, supply)) {
+			regulator_pmic_sync();
+			ramp_us += regulator_ramp_batch_end();
+			regulator_ramp_batch_begin();
+		}
+
+		pmic = dev_get_parent(dev);
+		if (device_get_uclass_id(pmic) == UCLASS_PMIC)
+			pmic_cache_defer(pmic);
+
 		ret = regulator_autoset(dev);
+		dev_priv = dev_get_uclass_priv(dev);
+		if (dev_priv)
+			dev_priv->ramp_gen = priv->ramp_gen;
 
 		if (ret == -EMEDIUMTYPE)
 			ret = 0;
@@ -520,6 +645,14 @@ int regulators_enable_boot_on(bool verbose)
 			ret = 0;
 	}
 
+	/* The ramps start when the writes reach the PMICs */
+	regulator_pmic_sync();
+	ramp_us += regulator_ramp_batch_end();
+
+	if (verbose)
+		printf("regulators: boot-on setup %lu us, ramp wait %u us\n",
+		       timer_get_us() - start, ramp_us);
+
 	return ret;
 }
 
@@ -528,6 +661,8 @@ UCLASS_DRIVER(regulator) = {
 	.name		= "regulator",
 	.post_bind	= regulator_post_bind,
 	.pre_probe	= regulator_pre_probe,
+	.priv_auto_alloc_size	= sizeof(struct regulator_uc_priv),
+	.per_device_auto_alloc_size = sizeof(struct regulator_dev_priv),
 	.per_device_platdata_auto_alloc_size =
 				sizeof(struct dm_regulator_uclass_platdata),
 };
@@ -23,6 +23,17 @@ int scsi_exec(struct udevice *dev, struct scsi_cmd *pccb)
 	return ops->exec(dev, pccb);
 }
 
+int scsi_read_blocks(struct udevice *dev, struct blk_desc *desc,
+		     lbaint_t start, lbaint_t blkcnt, void *buffer)
+{
+	struct scsi_ops *ops = scsi_get_ops(dev);
+
+	if (!ops->read)
+		return -ENOSYS;
+
+	return ops->read(dev, desc, start, blkcnt, buffer);
+}
+
 int scsi_bus_reset(struct udevice *dev)
 {
 	struct scsi_ops *ops = scsi_get_ops(dev);
@@ -160,6 +160,9 @@ static ulong scsi_read(struct blk_desc *block_dev, lbaint_t blknr,
 	uintptr_t buf_addr;
 	unsigned short smallblks = 0;
 	struct scsi_cmd *pccb = (struct scsi_cmd *)&tempccb;
+#if defined(CONFIG_DM_SCSI) && defined(CONFIG_BLK)
+	int ret;
+#endif
 
 	/* Setup device */
 	pccb->target = block_dev->target;
@@ -170,6 +173,11 @@ static ulong scsi_read(struct blk_desc *block_dev, lbaint_t blknr,
 	debug("\nscsi_read: dev %d startblk " LBAF
 	      ", blccnt " LBAF " buffer %lx\n",
 	      block_dev->devnum, start, blks, (unsigned long)buffer);
+#if defined(CONFIG_DM_SCSI) && defined(CONFIG_BLK)
+	ret = scsi_read_blocks(bdev, block_dev, blknr, blkcnt, buffer);
+	if (ret != -ENOSYS)
+		return ret ? 0 : blkcnt;
+#endif
 	do {
 		pccb->pdata = (unsigned char *)buf_addr;
 		pccb->dma_dir = DMA_FROM_DEVICE;
@@ -51,6 +51,8 @@ DECLARE_GLOBAL_DATA_PTR;
 #define CONFIG_SYS_NS16550_IER  0x00
 #endif /* CONFIG_SYS_NS16550_IER */
 
+#define NS16550_FIFO_SIZE	16
+
 static inline void serial_out_shift(void *addr, int shift, int value)
 {
 #ifdef CONFIG_SYS_NS16550_PORT_MAPPED
@@ -282,8 +284,21 @@ static inline void _debug_uart_putc(int ch)
 	else
 		com_port = (struct NS16550 *)CONFIG_DEBUG_UART_BASE;
 
+#ifdef CONFIG_ARCH_ROCKCHIP
+	/*
+	 * Only wait for room in the TX FIFO, not for it to drain, so the
+	 * FIFO can fill up while the CPU carries on.
+	 *
+	 * UART_USR: bit1 trans_fifo_not_full:
+	 *	0 = Transmit FIFO is full;
+	 *	1 = Transmit FIFO is not full;
+	 */
+	while (!(serial_din(&com_port->rbr + 0x1f) & 0x02))
+		;
+#else
 	while (!(serial_din(&com_port->lsr) & UART_LSR_THRE))
 		;
+#endif
 	serial_dout(&com_port->thr, ch);
 }
 
@@ -460,6 +475,31 @@ static int ns16550_serial_putc(struct udevice *dev, const char ch)
 	return 0;
 }
 
+#if CONFIG_IS_ENABLED(SERIAL_PUTS)
+static int ns16550_serial_puts(struct udevice *dev, const char *s, size_t len)
+{
+	struct NS16550 *const com_port = dev_get_priv(dev);
+	struct ns16550_platdata *plat = com_port->plat;
+	size_t i;
+
+	/*
+	 * With the FIFOs enabled, THRE means the whole TX FIFO is empty, so
+	 * one status read is enough for a full FIFO load.
+	 */
+	if (!(serial_in(&com_port->lsr) & UART_LSR_THRE))
+		return -EAGAIN;
+
+	len = min_t(size_t, len, plat->fifo_size ?: NS16550_FIFO_SIZE);
+	for (i = 0; i < len; i++) {
+		serial_out(s[i], &com_port->thr);
+		if (s[i] == '\n')
+			WATCHDOG_RESET();
+	}
+
+	return len;
+}
+#endif
+
 static int ns16550_serial_pending(struct udevice *dev, bool input)
 {
 	struct NS16550 *const com_port = dev_get_priv(dev);
@@ -589,6 +629,7 @@ int ns16550_serial_ofdata_to_platdata(struct udevice *dev)
 		return -EINVAL;
 	}
 
+	plat->fifo_size = dev_read_u32_default(dev, "fifo-size", 0);
 	plat->fcr = UART_FCR_DEFVAL;
 	if (port_type == PORT_JZ4780)
 		plat->fcr |= UART_FCR_UME;
@@ -599,6 +640,9 @@ int ns16550_serial_ofdata_to_platdata(struct udevice *dev)
 
 const struct dm_serial_ops ns16550_serial_ops = {
 	.putc = ns16550_serial_putc,
+#if CONFIG_IS_ENABLED(SERIAL_PUTS)
+	.puts = ns16550_serial_puts,
+#endif
 	.pending = ns16550_serial_pending,
 	.getc = ns16550_serial_getc,
 	.setbrg = ns16550_serial_setbrg,
@@ -19,6 +19,7 @@
 #include <video.h>
 #include <linux/compiler.h>
 #include <asm/state.h>
+#include <asm/test.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
@@ -39,8 +40,17 @@ struct sandbox_serial_platdata {
 	int colour;	/* Text colour to use for output, -1 for none */
 };
 
+/*
+ * Output is modelled as a UART with a TX FIFO of this size which drains
+ * immediately. Each putc()/puts() call reads the status register once and
+ * writes the data register once per character.
+ */
+#define SANDBOX_SERIAL_FIFO_SIZE	16
+
 struct sandbox_serial_priv {
 	bool start_of_line;
+	uint status_reads;
+	uint data_writes;
 };
 
 /**
@@ -93,6 +103,8 @@ static int sandbox_serial_putc(struct udevice *dev, const char ch)
 		output_ansi_colour(plat->colour);
 	}
 
+	priv->status_reads++;
+	priv->data_writes++;
 	os_write(1, &ch, 1);
 	if (ch == '\n')
 		priv->start_of_line = true;
@@ -100,6 +112,35 @@ static int sandbox_serial_putc(struct udevice *dev, const char ch)
 	return 0;
 }
 
+static int sandbox_serial_puts(struct udevice *dev, const char *s, size_t len)
+{
+	struct sandbox_serial_priv *priv = dev_get_priv(dev);
+	struct sandbox_serial_platdata *plat = dev->platdata;
+
+	if (priv->start_of_line && plat->colour != -1) {
+		priv->start_of_line = false;
+		output_ansi_colour(plat->colour);
+	}
+
+	len = min_t(size_t, len, SANDBOX_SERIAL_FIFO_SIZE);
+	priv->status_reads++;
+	priv->data_writes += len;
+	os_write(1, s, len);
+	if (s[len - 1] == '\n')
+		priv->start_of_line = true;
+
+	return len;
+}
+
+void sandbox_serial_get_access_counts(struct udevice *dev, uint *status_readsp,
+				      uint *data_writesp)
+{
+	struct sandbox_serial_priv *priv = dev_get_priv(dev);
+
+	*status_readsp = priv->status_reads;
+	*data_writesp = priv->data_writes;
+}
+
 static unsigned int increment_buffer_index(unsigned int index)
 {
 	return (index + 1) % ARRAY_SIZE(serial_buf);
@@ -168,6 +209,7 @@ static int sandbox_serial_ofdata_to_platdata(struct udevice *dev)
 
 static const struct dm_serial_ops sandbox_serial_ops = {
 	.putc = sandbox_serial_putc,
+	.puts = sandbox_serial_puts,
 	.pending = sandbox_serial_pending,
 	.getc = sandbox_serial_getc,
 };
@@ -159,8 +159,50 @@ static void _serial_putc(struct udevice *dev, char ch)
 	} while (err == -EAGAIN);
 }
 
+#if CONFIG_IS_ENABLED(SERIAL_PUTS)
+static int __serial_puts(struct udevice *dev, const char *str, size_t len)
+{
+	struct dm_serial_ops *ops = serial_get_ops(dev);
+	int written;
+
+	while (len) {
+		written = ops->puts(dev, str, len);
+		if (written == -EAGAIN)
+			continue;
+		if (written < 0)
+			return written;
+
+		str += written;
+		len -= written;
+	}
+
+	return 0;
+}
+#endif
+
 static void _serial_puts(struct udevice *dev, const char *str)
 {
+#if CONFIG_IS_ENABLED(SERIAL_PUTS)
+	struct dm_serial_ops *ops = serial_get_ops(dev);
+	const char *newline;
+	size_t len;
+
+	if (ops->puts) {
+		/* Hand over each line in one go, then its "\r\n" */
+		while (*str) {
+			newline = strchrnul(str, '\n');
+			len = newline - str;
+
+			if (len && __serial_puts(dev, str, len))
+				return;
+			if (*newline && __serial_puts(dev, "\r\n", 2))
+				return;
+
+			str = *newline ? newline + 1 : newline;
+		}
+		return;
+	}
+#endif
 	while (*str)
 		_serial_putc(dev, *str++);
 }
@@ -6,6 +6,7 @@
  */
 
 #include <common.h>
+#include <android_misc.h>
 #include <sysreset.h>
 #include <dm.h>
 #include <errno.h>
@@ -88,6 +89,7 @@ void reset_cpu(ulong addr)
 
 void reboot(const char *mode)
 {
+	android_misc_flush();
 	sysreset_walk_reboot_mode(mode);
 	flushc();
 	sysreset_walk_halt(SYSRESET_COLD);
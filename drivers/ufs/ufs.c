@@ -14,10 +14,13 @@
 #include <dm/lists.h>
 #include <dm/device-internal.h>
 #include <malloc.h>
+#include <memalign.h>
 #include <hexdump.h>
 #include <scsi.h>
+#include <ufs.h>
 #include <asm/io.h>
 #include <asm/dma-mapping.h>
+#include <asm/unaligned.h>
 #include <linux/bitops.h>
 #include <linux/delay.h>
 
@@ -36,6 +39,8 @@
 #define QUERY_REQ_RETRIES 3
 /* Query request timeout */
 #define QUERY_REQ_TIMEOUT 1500 /* 1.5 seconds */
+/* Timeout for a batch of data transfer requests */
+#define DATA_REQ_TIMEOUT 5000 /* 5 seconds */
 
 /* maximum timeout in ms for a general UIC command */
 #define UFS_UIC_CMD_TIMEOUT	1000
@@ -53,7 +58,7 @@
 #define MAX_PRDT_ENTRY	262144
 
 /* maximum bytes per request */
-#define UFS_MAX_BYTES	(128 * 256 * 1024)
+#define UFS_MAX_BYTES	(MAX_BUFF * MAX_PRDT_ENTRY)
 
 static inline bool ufshcd_is_hba_active(struct ufs_hba *hba);
 static inline void ufshcd_hba_stop(struct ufs_hba *hba);
@@ -598,21 +603,28 @@ static void ufshcd_host_memory_configure(struct ufs_hba *hba)
 	dma_addr_t cmd_desc_dma_addr;
 	u16 response_offset;
 	u16 prdt_offset;
+	int i;
 
-	utrdlp = hba->utrdl;
-	cmd_desc_dma_addr = (dma_addr_t)hba->ucdl;
+	response_offset = offsetof(struct utp_transfer_cmd_desc, response_upiu);
+	prdt_offset = offsetof(struct utp_transfer_cmd_desc, prd_table);
 
-	utrdlp->command_desc_base_addr_lo =
+	for (i = 0; i < hba->nutrs; i++) {
+		utrdlp = &hba->utrdl[i];
+		cmd_desc_dma_addr = (dma_addr_t)&hba->ucdl[i];
+
+		utrdlp->command_desc_base_addr_lo =
 				cpu_to_le32(lower_32_bits(cmd_desc_dma_addr));
-	utrdlp->command_desc_base_addr_hi =
+		utrdlp->command_desc_base_addr_hi =
 				cpu_to_le32(upper_32_bits(cmd_desc_dma_addr));
 
-	response_offset = offsetof(struct utp_transfer_cmd_desc, response_upiu);
-	prdt_offset = offsetof(struct utp_transfer_cmd_desc, prd_table);
+		utrdlp->response_upiu_offset =
+				cpu_to_le16(response_offset >> 2);
+		utrdlp->prd_table_offset = cpu_to_le16(prdt_offset >> 2);
+		utrdlp->response_upiu_length =
+				cpu_to_le16(ALIGNED_UPIU_SIZE >> 2);
+	}
 
-	utrdlp->response_upiu_offset = cpu_to_le16(response_offset >> 2);
-	utrdlp->prd_table_offset = cpu_to_le16(prdt_offset >> 2);
-	utrdlp->response_upiu_length = cpu_to_le16(ALIGNED_UPIU_SIZE >> 2);
+	/* Device management commands and SCSI passthrough use slot 0 */
 
 	hba->ucd_req_ptr = (struct utp_upiu_req *)hba->ucdl;
 	hba->ucd_rsp_ptr =
@@ -626,19 +638,21 @@ static void ufshcd_host_memory_configure(struct ufs_hba *hba)
  */
 static int ufshcd_memory_alloc(struct ufs_hba *hba)
 {
-	/* Allocate one Transfer Request Descriptor
+	/* Allocate one Transfer Request Descriptor per slot
 	 * Should be aligned to 1k boundary.
 	 */
-	hba->utrdl = memalign(1024, sizeof(struct utp_transfer_req_desc));
+	hba->utrdl = memalign(1024, hba->nutrs *
+			      sizeof(struct utp_transfer_req_desc));
 	if (!hba->utrdl) {
 		dev_err(hba->dev, "Transfer Descriptor memory allocation failed\n");
 		return -ENOMEM;
 	}
 
-	/* Allocate one Command Descriptor
+	/* Allocate one Command Descriptor per slot
 	 * Should be aligned to 1k boundary.
 	 */
-	hba->ucdl = memalign(1024, sizeof(struct utp_transfer_cmd_desc));
+	hba->ucdl = memalign(1024, hba->nutrs *
+			     sizeof(struct utp_transfer_cmd_desc));
 	if (!hba->ucdl) {
 		dev_err(hba->dev, "Command descriptor memory allocation failed\n");
 		return -ENOMEM;
@@ -839,6 +853,51 @@ static int ufshcd_send_command(struct ufs_hba *hba, unsigned int task_tag)
 	return 0;
 }
 
+/**
+ * ufshcd_send_slots() - ring the doorbell for several transfer request
+ *			 slots at once and wait until all of them complete
+ */
+static int ufshcd_send_slots(struct ufs_hba *hba, u32 slots)
+{
+	unsigned long start;
+	u32 intr_status;
+	u32 enabled_intr_status;
+	u32 pending;
+
+	ufshcd_writel(hba, slots, REG_UTP_TRANSFER_REQ_DOOR_BELL);
+
+	start = get_timer(0);
+	for (;;) {
+		intr_status = ufshcd_readl(hba, REG_INTERRUPT_STATUS);
+		enabled_intr_status = intr_status & hba->intr_mask;
+		ufshcd_writel(hba, intr_status, REG_INTERRUPT_STATUS);
+
+		if (enabled_intr_status & UFSHCD_ERROR_MASK) {
+			dev_err(hba->dev, "Error in status:%08x\n",
+				enabled_intr_status);
+
+			return -EIO;
+		}
+
+		/* The controller clears a doorbell bit once the slot is done */
+		pending = ufshcd_readl(hba, REG_UTP_TRANSFER_REQ_DOOR_BELL) &
+			  slots;
+		if (!pending)
+			break;
+
+		if (get_timer(start) > DATA_REQ_TIMEOUT) {
+			dev_err(hba->dev,
+				"Timedout waiting for slots %08x\n", pending);
+			ufshcd_writel(hba, ~pending,
+				      REG_UTP_TRANSFER_REQ_LIST_CLEAR);
+
+			return -ETIMEDOUT;
+		}
+	}
+
+	return 0;
+}
+
 /**
  * ufshcd_get_req_rsp - returns the TR response transaction type
  */
@@ -1412,13 +1471,11 @@ static inline void prepare_prdt_desc(struct ufshcd_sg_entry *entry,
 	entry->upper_addr = cpu_to_le32(upper_32_bits((unsigned long)buf));
 }
 
-static void prepare_prdt_table(struct ufs_hba *hba, struct scsi_cmd *pccb)
+static void ufshcd_fill_prdt(struct utp_transfer_req_desc *req_desc,
+			     struct ufshcd_sg_entry *prd_table, u8 *buf,
+			     ulong datalen)
 {
-	struct utp_transfer_req_desc *req_desc = hba->utrdl;
-	struct ufshcd_sg_entry *prd_table = hba->ucd_prdt_ptr;
-	ulong datalen = pccb->datalen;
 	int table_length;
-	u8 *buf;
 	int i;
 
 	if (!datalen) {
@@ -1426,8 +1483,7 @@ static void prepare_prdt_table(struct ufs_hba *hba, struct scsi_cmd *pccb)
 		return;
 	}
 
-	table_length = DIV_ROUND_UP(pccb->datalen, MAX_PRDT_ENTRY);
-	buf = pccb->pdata;
+	table_length = DIV_ROUND_UP(datalen, MAX_PRDT_ENTRY);
 	i = table_length;
 	while (--i) {
 		prepare_prdt_desc(&prd_table[table_length - i - 1], buf,
@@ -1441,27 +1497,32 @@ static void prepare_prdt_table(struct ufs_hba *hba, struct scsi_cmd *pccb)
 	req_desc->prd_table_length = table_length;
 }
 
-static int ufs_scsi_exec(struct udevice *scsi_dev, struct scsi_cmd *pccb)
+static void prepare_prdt_table(struct ufs_hba *hba, struct scsi_cmd *pccb)
 {
-	struct ufs_hba *hba = dev_get_uclass_priv(scsi_dev->parent);
-	struct utp_transfer_req_desc *req_desc = hba->utrdl;
-	u32 upiu_flags;
+	ufshcd_fill_prdt(hba->utrdl, hba->ucd_prdt_ptr, pccb->pdata,
+			 pccb->datalen);
+}
+
+/**
+ * ufshcd_get_scsi_result() - check the status of a completed SCSI command
+ * @hba: per adapter instance
+ * @slot: transfer request slot the command was sent on
+ */
+static int ufshcd_get_scsi_result(struct ufs_hba *hba, int slot)
+{
+	struct utp_transfer_req_desc *req_desc = &hba->utrdl[slot];
+	struct utp_upiu_rsp *ucd_rsp_ptr =
+		(struct utp_upiu_rsp *)&hba->ucdl[slot].response_upiu;
 	int ocs, result = 0;
 	u8 scsi_status;
 
-	ufshcd_prepare_req_desc_hdr(req_desc, &upiu_flags, pccb->dma_dir);
-	ufshcd_prepare_utp_scsi_cmd_upiu(hba, pccb, upiu_flags);
-	prepare_prdt_table(hba, pccb);
-
-	ufshcd_send_command(hba, TASK_TAG);
-
-	ocs = ufshcd_get_tr_ocs(hba);
+	ocs = le32_to_cpu(req_desc->header.dword_2) & MASK_OCS;
 	switch (ocs) {
 	case OCS_SUCCESS:
-		result = ufshcd_get_req_rsp(hba->ucd_rsp_ptr);
+		result = ufshcd_get_req_rsp(ucd_rsp_ptr);
 		switch (result) {
 		case UPIU_TRANSACTION_RESPONSE:
-			result = ufshcd_get_rsp_upiu_result(hba->ucd_rsp_ptr);
+			result = ufshcd_get_rsp_upiu_result(ucd_rsp_ptr);
 
 			scsi_status = result & MASK_SCSI_STATUS;
 			if (scsi_status)
@@ -1488,6 +1549,175 @@ static int ufs_scsi_exec(struct udevice *scsi_dev, struct scsi_cmd *pccb)
 	return 0;
 }
 
+static int ufshcd_exec_scsi(struct ufs_hba *hba, struct scsi_cmd *pccb)
+{
+	struct utp_transfer_req_desc *req_desc = hba->utrdl;
+	u32 upiu_flags;
+
+	if (pccb->datalen > UFS_MAX_BYTES)
+		return -EINVAL;
+
+	ufshcd_prepare_req_desc_hdr(req_desc, &upiu_flags, pccb->dma_dir);
+	ufshcd_prepare_utp_scsi_cmd_upiu(hba, pccb, upiu_flags);
+	prepare_prdt_table(hba, pccb);
+
+	ufshcd_send_command(hba, TASK_TAG);
+
+	return ufshcd_get_scsi_result(hba, TASK_TAG);
+}
+
+static int ufs_scsi_exec(struct udevice *scsi_dev, struct scsi_cmd *pccb)
+{
+	struct ufs_hba *hba = dev_get_uclass_priv(scsi_dev->parent);
+
+	return ufshcd_exec_scsi(hba, pccb);
+}
+
+/**
+ * ufshcd_prepare_read_slot() - build a READ command for one slot
+ *
+ * The UPIU is filled in directly instead of going through struct scsi_cmd,
+ * using READ(16) only when the range does not fit READ(10).
+ */
+static void ufshcd_prepare_read_slot(struct ufs_hba *hba, int slot, u8 lun,
+				     u64 start, u32 blkcnt, u32 blksz,
+				     u8 *buf)
+{
+	struct utp_transfer_req_desc *req_desc = &hba->utrdl[slot];
+	struct utp_transfer_cmd_desc *ucd = &hba->ucdl[slot];
+	struct utp_upiu_req *ucd_req_ptr =
+		(struct utp_upiu_req *)ucd->command_upiu;
+	ulong datalen = (ulong)blkcnt * blksz;
+	u8 *cdb = ucd_req_ptr->sc.cdb;
+	u32 upiu_flags;
+
+	ufshcd_prepare_req_desc_hdr(req_desc, &upiu_flags, DMA_FROM_DEVICE);
+
+	ucd_req_ptr->header.dword_0 =
+			UPIU_HEADER_DWORD(UPIU_TRANSACTION_COMMAND, upiu_flags,
+					  lun, slot);
+	ucd_req_ptr->header.dword_1 =
+			UPIU_HEADER_DWORD(UPIU_COMMAND_SET_TYPE_SCSI, 0, 0, 0);
+	ucd_req_ptr->header.dword_2 = 0;
+	ucd_req_ptr->sc.exp_data_transfer_len = cpu_to_be32(datalen);
+
+	memset(cdb, 0, UFS_CDB_SIZE);
+	if (start + blkcnt > U32_MAX || blkcnt > U16_MAX) {
+		cdb[0] = SCSI_READ16;
+		put_unaligned_be64(start, &cdb[2]);
+		put_unaligned_be32(blkcnt, &cdb[10]);
+	} else {
+		cdb[0] = SCSI_READ10;
+		put_unaligned_be32(start, &cdb[2]);
+		put_unaligned_be16(blkcnt, &cdb[7]);
+	}
+
+	memset(ucd->response_upiu, 0, sizeof(struct utp_upiu_rsp));
+
+	ufshcd_fill_prdt(req_desc, ucd->prd_table, buf, datalen);
+}
+
+/**
+ * ufshcd_read_blocks() - read from a logical unit using all transfer slots
+ * @hba: per adapter instance
+ * @lun: UPIU LUN to read from
+ * @start: first logical block
+ * @blkcnt: number of logical blocks
+ * @blksz: logical block size of the unit
+ * @buf: destination buffer
+ *
+ * The range is split evenly over the available slots, which are then
+ * started with a single doorbell write so that the device can work on
+ * them concurrently.
+ */
+static int ufshcd_read_blocks(struct ufs_hba *hba, u8 lun, lbaint_t start,
+			      lbaint_t blkcnt, u32 blksz, void *buf)
+{
+	lbaint_t chunk;
+	u32 slots;
+	u32 blks;
+	int slot, ret;
+
+	if (!blksz || blksz > UFS_MAX_BYTES)
+		return -EINVAL;
+
+	chunk = min_t(lbaint_t, UFS_MAX_BYTES / blksz,
+		      DIV_ROUND_UP(blkcnt, hba->nutrs));
+
+	while (blkcnt) {
+		slots = 0;
+		for (slot = 0; slot < hba->nutrs && blkcnt; slot++) {
+			blks = min_t(lbaint_t, chunk, blkcnt);
+			ufshcd_prepare_read_slot(hba, slot, lun, start, blks,
+						 blksz, buf);
+			slots |= BIT(slot);
+			start += blks;
+			blkcnt -= blks;
+			buf += (ulong)blks * blksz;
+		}
+
+		ret = ufshcd_send_slots(hba, slots);
+		if (ret)
+			return ret;
+
+		for (slot = 0; slots & BIT(slot); slot++) {
+			ret = ufshcd_get_scsi_result(hba, slot);
+			if (ret)
+				return ret;
+		}
+	}
+
+	return 0;
+}
+
+static int ufs_scsi_read(struct udevice *scsi_dev, struct blk_desc *desc,
+			 lbaint_t start, lbaint_t blkcnt, void *buffer)
+{
+	struct ufs_hba *hba = dev_get_uclass_priv(scsi_dev->parent);
+
+	return ufshcd_read_blocks(hba, desc->lun, start, blkcnt, desc->blksz,
+				  buffer);
+}
+
+static int ufshcd_get_lun_blksz(struct ufs_hba *hba, u8 lun, u32 *blksz)
+{
+	ALLOC_CACHE_ALIGN_BUFFER(u8, cap, 8);
+	struct scsi_cmd ccb = { 0 };
+	int ret;
+
+	ccb.cmd[0] = SCSI_RD_CAPAC10;
+	ccb.cmdlen = 10;
+	ccb.lun = lun;
+	ccb.pdata = cap;
+	ccb.datalen = 8;
+	ccb.dma_dir = DMA_FROM_DEVICE;
+
+	ret = ufshcd_exec_scsi(hba, &ccb);
+	if (ret)
+		return ret;
+
+	*blksz = get_unaligned_be32(&cap[4]);
+
+	return *blksz ? 0 : -EIO;
+}
+
+int ufs_read_boot_lun(struct udevice *ufs_dev, lbaint_t start,
+		      lbaint_t blkcnt, void *buffer)
+{
+	struct ufs_hba *hba = dev_get_uclass_priv(ufs_dev);
+	int ret;
+
+	if (!hba->boot_lun_blksz) {
+		ret = ufshcd_get_lun_blksz(hba, UFS_UPIU_BOOT_WLUN,
+					   &hba->boot_lun_blksz);
+		if (ret)
+			return ret;
+	}
+
+	return ufshcd_read_blocks(hba, UFS_UPIU_BOOT_WLUN, start, blkcnt,
+				  hba->boot_lun_blksz, buffer);
+}
+
 static inline int ufshcd_read_desc(struct ufs_hba *hba, enum desc_idn desc_id,
 				   int desc_index, u8 *buf, u32 size)
 {
@@ -1872,7 +2102,6 @@ int ufshcd_probe(struct udevice *ufs_dev, struct ufs_hba_ops *hba_ops)
 	scsi_plat = dev_get_uclass_platdata(scsi_dev);
 	scsi_plat->max_id = UFSHCD_MAX_ID;
 	scsi_plat->max_lun = UFS_MAX_LUNS;
-	//scsi_plat->max_bytes_per_req = UFS_MAX_BYTES;
 
 	hba->dev = ufs_dev;
 	hba->ops = hba_ops;
@@ -1885,6 +2114,8 @@ int ufshcd_probe(struct udevice *ufs_dev, struct ufs_hba_ops *hba_ops)
 
 	/* Read capabilties registers */
 	hba->capabilities = ufshcd_readl(hba, REG_CONTROLLER_CAPABILITIES);
+	hba->nutrs = min_t(int, UFS_MAX_SLOTS,
+			   (hba->capabilities & MASK_TRANSFER_REQUESTS_SLOTS) + 1);
 
 	/* Get UFS version supported by the controller */
 	hba->version = ufshcd_get_ufs_version(hba);
@@ -1940,6 +2171,7 @@ int ufs_scsi_bind(struct udevice *ufs_dev, struct udevice **scsi_devp)
 
 static struct scsi_ops ufs_ops = {
 	.exec		= ufs_scsi_exec,
+	.read		= ufs_scsi_read,
 };
 
 int ufs_probe_dev(int index)
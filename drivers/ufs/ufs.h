@@ -11,6 +11,11 @@ struct udevice;
 #define UIC_CMD_SIZE (sizeof(u32) * 4)
 #define RESPONSE_UPIU_SENSE_DATA_LENGTH	18
 #define UFS_MAX_LUNS		0x7F
+#define UFS_UPIU_WLUN_ID	(1 << 7)
+#define UFS_UPIU_BOOT_WLUN	0xB0
+
+/* Transfer request slots used for data transfers */
+#define UFS_MAX_SLOTS		8
 
 enum {
 	TASK_REQ_UPIU_SIZE_DWORDS	= 8,
@@ -302,7 +307,8 @@ struct ufshcd_sg_entry {
 	__le32    size;
 };
 
-#define MAX_BUFF	128
+/* Enough PRDT entries for the largest READ(10) transfer of 4KiB blocks */
+#define MAX_BUFF	1024
 /**
  * struct utp_transfer_cmd_desc - UFS Command Descriptor structure
  * @command_upiu: Command UPIU Frame address
@@ -707,6 +713,8 @@ struct ufs_hba {
 	struct ufs_hba_ops	*ops;
 	struct ufs_desc_size	desc_size;
 	u32			capabilities;
+	int			nutrs;
+	u32			boot_lun_blksz;
 	u32			version;
 	u32			intr_mask;
 	u32			quirks;
@@ -719,7 +727,7 @@ struct ufs_hba {
  */
 #define UFSHCD_QUIRK_BROKEN_LCC				0x1
 
-	/* Virtual memory reference */
+	/* Virtual memory reference, one entry per transfer request slot */
 	struct utp_transfer_cmd_desc *ucdl;
 	struct utp_transfer_req_desc *utrdl;
 	/* TODO: Add Task Manegement Support */
@@ -14,7 +14,9 @@
 #include <common.h>
 #include <console.h>
 #include <android_bootloader.h>
+#include <android_misc.h>
 #include <errno.h>
+#include <event_loop.h>
 #include <fastboot.h>
 #include <malloc.h>
 #include <linux/usb/ch9.h>
@@ -313,6 +315,7 @@ static int sleep_thread(void)
 		}
 
 		usb_gadget_handle_interrupts(0);
+		event_loop_run();
 	}
 	intthread_wakeup_needed = true;
 	return rc;
@@ -1823,6 +1826,8 @@ static void cb_flash(struct usb_ep *ep, struct usb_request *req)
 		}
 	}
 #endif
+	/* The image may be misc itself */
+	android_misc_invalidate();
 	fastboot_fail("no flash device defined", response);
 #ifdef CONFIG_FASTBOOT_FLASH_MMC_DEV
 	fb_mmc_flash_write(cmd, (void *)CONFIG_FASTBOOT_BUF_ADDR,
@@ -2306,6 +2311,7 @@ static void cb_erase(struct usb_ep *ep, struct usb_request *req)
 		}
 	}
 #endif
+	android_misc_invalidate();
 	fastboot_fail("no flash device defined", response);
 #ifdef CONFIG_FASTBOOT_FLASH_MMC_DEV
 	fb_mmc_erase(cmd, response);
@@ -148,16 +148,22 @@ static long long int download_head(unsigned long long total,
 {
 	long long int rcv_cnt = 0, left_to_rcv, ret_rcv;
 	struct dfu_entity *dfu_entity = dfu_get_entity(alt_setting_num);
-	void *transfer_buffer = dfu_get_buf(dfu_entity);
+	void *transfer_buffer = dfu_get_write_buf(dfu_entity);
 	void *buf = transfer_buffer;
 	int usb_pkt_cnt = 0, ret;
 
+	if (!transfer_buffer) {
+		pr_err("Transfer buffer not allocated!");
+		return -ENXIO;
+	}
+
 	/*
 	 * Files smaller than THOR_STORE_UNIT_SIZE (now 32 MiB) are stored on
 	 * the medium.
 	 * The packet response is sent on the purpose after successful data
-	 * chunk write. There is a room for improvement when asynchronous write
-	 * is performed.
+	 * chunk write. Data is received straight into the DFU write buffer;
+	 * with several DFU write buffers, dfu_write() only queues a full one
+	 * and thor_rx_data() writes it out while the next one is received.
 	 */
 	while (total - rcv_cnt >= packet_size) {
 		thor_set_dma(buf, packet_size);
@@ -178,6 +184,7 @@ static long long int download_head(unsigned long long total,
 				      ret, *cnt);
 				return ret;
 			}
+			transfer_buffer = dfu_get_write_buf(dfu_entity);
 			buf = transfer_buffer;
 		}
 		send_data_rsp(0, ++usb_pkt_cnt);
@@ -222,7 +229,7 @@ static int download_tail(long long int left, int cnt)
 		return -ENOENT;
 	}
 
-	transfer_buffer = dfu_get_buf(dfu_entity);
+	transfer_buffer = dfu_get_write_buf(dfu_entity);
 	if (!transfer_buffer) {
 		pr_err("Transfer buffer not allocated!");
 		return -ENXIO;
@@ -553,6 +560,8 @@ static int thor_rx_data(void)
 		}
 
 		while (!dev->rxdata) {
+			/* errors are reported by the next dfu_write() */
+			dfu_write_poll();
 			usb_gadget_handle_interrupts(0);
 			if (ctrlc())
 				return -1;
@@ -81,6 +81,18 @@ int submit_bulk_msg(struct usb_device *udev, unsigned long pipe, void *buffer,
 	return ops->bulk(bus, udev, pipe, buffer, length);
 }
 
+int submit_bulk_batch(struct usb_device *udev, struct usb_bulk_req *reqs,
+		      int count)
+{
+	struct udevice *bus = udev->controller_dev;
+	struct dm_usb_ops *ops = usb_get_ops(bus);
+
+	if (!ops->bulk_batch)
+		return -ENOSYS;
+
+	return ops->bulk_batch(bus, udev, reqs, count);
+}
+
 struct int_queue *create_int_queue(struct usb_device *udev,
 		unsigned long pipe, int queuesize, int elementsize,
 		void *buffer, int interval)
@@ -544,19 +544,59 @@ static void record_transfer_result(struct usb_device *udev,
 
 /**** Bulk and Control transfer methods ****/
 /**
- * Queues up the BULK Request
+ * Counts the TRBs needed for a bulk TD. A TRB buffer must not span a 64KB
+ * boundary (TABLE 49 and 6.4.1 section of XHCI Spec), so a buffer crossing
+ * such boundaries is sent with several chained TRBs.
+ *
+ * @param buffer	buffer to be read/written
+ * @param length	length of the buffer
+ * @return number of TRBs needed
+ */
+static int xhci_bulk_td_trbs(void *buffer, int length)
+{
+	u64 val_64 = (uintptr_t)buffer;
+	int running_total;
+	int num_trbs = 0;
+
+	/* How much data is (potentially) left before the 64KB boundary? */
+	running_total = TRB_MAX_BUFF_SIZE -
+			(lower_32_bits(val_64) & (TRB_MAX_BUFF_SIZE - 1));
+	running_total &= TRB_MAX_BUFF_SIZE - 1;
+
+	/*
+	 * If there's some data on this 64KB chunk, or we have to send a
+	 * zero-length transfer, we need at least one TRB
+	 */
+	if (running_total != 0 || length == 0)
+		num_trbs++;
+
+	/* How many more 64KB chunks to transfer, how many more TRBs? */
+	while (running_total < length) {
+		num_trbs++;
+		running_total += TRB_MAX_BUFF_SIZE;
+	}
+
+	return num_trbs;
+}
+
+/**
+ * Queues up a BULK TD and rings the doorbell of its endpoint, without
+ * waiting for it to complete
  *
  * @param udev		pointer to the USB device structure
  * @param pipe		contains the DIR_IN or OUT , devnum
  * @param length	length of the buffer
  * @param buffer	buffer to be read/written based on the request
- * @return returns 0 if successful else -1 on failure
+ * @param first		returns the first TRB of the TD
+ * @param last		returns the last TRB of the TD
+ * @return 0 if successful else error code on failure
  */
-int xhci_bulk_tx(struct usb_device *udev, unsigned long pipe,
-			int length, void *buffer)
+static int xhci_queue_bulk_td(struct usb_device *udev, unsigned long pipe,
+			      int length, void *buffer,
+			      union xhci_trb **first, union xhci_trb **last)
 {
-	int num_trbs = 0;
-	struct xhci_generic_trb *start_trb;
+	int num_trbs;
+	struct xhci_generic_trb *start_trb, *trb;
 	bool first_trb = false;
 	int start_cycle;
 	u32 field = 0;
@@ -567,7 +607,6 @@ int xhci_bulk_tx(struct usb_device *udev, unsigned long pipe,
 	struct xhci_virt_device *virt_dev;
 	struct xhci_ep_ctx *ep_ctx;
 	struct xhci_ring *ring;		/* EP transfer ring */
-	union xhci_trb *event;
 
 	int running_total, trb_buff_len;
 	unsigned int total_packet_count;
@@ -589,29 +628,7 @@ int xhci_bulk_tx(struct usb_device *udev, unsigned long pipe,
 	ep_ctx = xhci_get_ep_ctx(ctrl, virt_dev->out_ctx, ep_index);
 
 	ring = virt_dev->eps[ep_index].ring;
-	/*
-	 * How much data is (potentially) left before the 64KB boundary?
-	 * XHCI Spec puts restriction( TABLE 49 and 6.4.1 section of XHCI Spec)
-	 * that the buffer should not span 64KB boundary. if so
-	 * we send request in more than 1 TRB by chaining them.
-	 */
-	running_total = TRB_MAX_BUFF_SIZE -
-			(lower_32_bits(val_64) & (TRB_MAX_BUFF_SIZE - 1));
-	trb_buff_len = running_total;
-	running_total &= TRB_MAX_BUFF_SIZE - 1;
-
-	/*
-	 * If there's some data on this 64KB chunk, or we have to send a
-	 * zero-length transfer, we need at least one TRB
-	 */
-	if (running_total != 0 || length == 0)
-		num_trbs++;
-
-	/* How many more 64KB chunks to transfer, how many more TRBs? */
-	while (running_total < length) {
-		num_trbs++;
-		running_total += TRB_MAX_BUFF_SIZE;
-	}
+	num_trbs = xhci_bulk_td_trbs(buffer, length);
 
 	/*
 	 * XXX: Calling routine prepare_ring() called in place of
@@ -644,6 +661,8 @@ int xhci_bulk_tx(struct usb_device *udev, unsigned long pipe,
 	 * we send request in more than 1 TRB by chaining them.
 	 */
 	addr = val_64;
+	trb_buff_len = TRB_MAX_BUFF_SIZE -
+		       (lower_32_bits(val_64) & (TRB_MAX_BUFF_SIZE - 1));
 
 	if (trb_buff_len > length)
 		trb_buff_len = length;
@@ -699,7 +718,7 @@ int xhci_bulk_tx(struct usb_device *udev, unsigned long pipe,
 		trb_fields[2] = length_field;
 		trb_fields[3] = field | (TRB_NORMAL << TRB_TYPE_SHIFT);
 
-		queue_trb(ctrl, ring, (num_trbs > 1), trb_fields);
+		trb = queue_trb(ctrl, ring, (num_trbs > 1), trb_fields);
 
 		--num_trbs;
 
@@ -710,8 +729,36 @@ int xhci_bulk_tx(struct usb_device *udev, unsigned long pipe,
 		trb_buff_len = min((length - running_total), TRB_MAX_BUFF_SIZE);
 	} while (running_total < length);
 
+	*first = (union xhci_trb *)start_trb;
+	*last = (union xhci_trb *)trb;
 	giveback_first_trb(udev, ep_index, start_cycle, start_trb);
 
+	return 0;
+}
+
+/**
+ * Queues up the BULK Request
+ *
+ * @param udev		pointer to the USB device structure
+ * @param pipe		contains the DIR_IN or OUT , devnum
+ * @param length	length of the buffer
+ * @param buffer	buffer to be read/written based on the request
+ * @return returns 0 if successful else -1 on failure
+ */
+int xhci_bulk_tx(struct usb_device *udev, unsigned long pipe,
+			int length, void *buffer)
+{
+	struct xhci_ctrl *ctrl = xhci_get_ctrl(udev);
+	int slot_id = udev->slot_id;
+	int ep_index = usb_pipe_ep_index(pipe);
+	union xhci_trb *event, *first, *last;
+	u32 field;
+	int ret;
+
+	ret = xhci_queue_bulk_td(udev, pipe, length, buffer, &first, &last);
+	if (ret < 0)
+		return ret;
+
 	event = xhci_wait_for_event(ctrl, TRB_TRANSFER);
 	if (!event) {
 		debug("XHCI bulk transfer timed out, aborting...\n");
@@ -734,6 +781,253 @@ int xhci_bulk_tx(struct usb_device *udev, unsigned long pipe,
 	return (udev->status != USB_ST_NOT_PROC) ? 0 : -1;
 }
 
+/* State of one TD of a bulk batch */
+struct xhci_batch_td {
+	struct usb_bulk_req *req;
+	int ep_index;
+	union xhci_trb *first;		/* first TRB of the TD */
+	union xhci_trb *last;		/* last TRB of the TD */
+	bool done;
+};
+
+/**
+ * Checks whether a TRB is part of a TD. Transfer rings have one segment,
+ * so a TD which wraps around the end of the ring ends before it starts.
+ */
+static bool xhci_td_has_trb(struct xhci_batch_td *td, union xhci_trb *trb)
+{
+	if (td->first <= td->last)
+		return trb >= td->first && trb <= td->last;
+
+	return trb >= td->first || trb <= td->last;
+}
+
+/**
+ * Gets a halted or stopped endpoint going again after a failed transfer in
+ * a batch, throwing away the TDs which were queued behind it
+ *
+ * @param udev		pointer to the USB device structure
+ * @param ep_index	index of the endpoint
+ * @param halted	true if the endpoint halted (e.g. on a STALL), false
+ *			if the transfer timed out
+ */
+static void xhci_batch_cleanup_ep(struct usb_device *udev, int ep_index,
+				  bool halted)
+{
+	struct xhci_ctrl *ctrl = xhci_get_ctrl(udev);
+	struct xhci_ring *ring = ctrl->devs[udev->slot_id]->eps[ep_index].ring;
+	union xhci_trb *event;
+
+	if (!halted) {
+		abort_td(udev, ep_index);
+		return;
+	}
+
+	xhci_queue_command(ctrl, NULL, udev->slot_id, ep_index, TRB_RESET_EP);
+	event = xhci_wait_for_event(ctrl, TRB_COMPLETION);
+	BUG_ON(TRB_TO_SLOT_ID(le32_to_cpu(event->event_cmd.flags))
+		!= udev->slot_id || GET_COMP_CODE(le32_to_cpu(
+		event->event_cmd.status)) != COMP_SUCCESS);
+	xhci_acknowledge_event(ctrl);
+
+	xhci_queue_command(ctrl, (void *)((uintptr_t)ring->enqueue |
+		ring->cycle_state), udev->slot_id, ep_index, TRB_SET_DEQ);
+	event = xhci_wait_for_event(ctrl, TRB_COMPLETION);
+	BUG_ON(TRB_TO_SLOT_ID(le32_to_cpu(event->event_cmd.flags))
+		!= udev->slot_id || GET_COMP_CODE(le32_to_cpu(
+		event->event_cmd.status)) != COMP_SUCCESS);
+	xhci_acknowledge_event(ctrl);
+}
+
+/**
+ * Waits for all TDs of a batch to complete. All events which are ready are
+ * handled before the event ring dequeue pointer is handed back to the
+ * hardware, rather than doing that for each event.
+ *
+ * @param udev		pointer to the USB device structure
+ * @param tds		TDs queued
+ * @param count		number of TDs
+ * @return 0 if all TDs completed OK, -ve on error
+ */
+static int xhci_wait_bulk_batch(struct usb_device *udev,
+				struct xhci_batch_td *tds, int count)
+{
+	struct xhci_ctrl *ctrl = xhci_get_ctrl(udev);
+	u32 halted = 0, timed_out = 0;
+	unsigned long ts = get_timer(0);
+	union xhci_trb *event, *trb;
+	struct xhci_batch_td *td;
+	int pending = count;
+	bool unacked = false;
+	trb_type type;
+	u32 field;
+	int ret = 0;
+	int i, j;
+
+	while (pending) {
+		if (!event_ready(ctrl)) {
+			if (unacked) {
+				xhci_writeq(&ctrl->ir_set->erst_dequeue,
+					    (uintptr_t)ctrl->event_ring->dequeue |
+					    ERST_EHB);
+				unacked = false;
+			}
+			if (get_timer(ts) < XHCI_TIMEOUT)
+				continue;
+
+			/* Give up on whatever is left */
+			debug("XHCI bulk batch timed out, aborting...\n");
+			for (i = 0, td = tds; i < count; i++, td++) {
+				if (td->done)
+					continue;
+				td->done = true;
+				td->req->status = USB_ST_NAK_REC;
+				timed_out |= 1 << td->ep_index;
+			}
+			ret = -ETIMEDOUT;
+			break;
+		}
+
+		event = ctrl->event_ring->dequeue;
+		type = TRB_FIELD_TO_TYPE(le32_to_cpu(event->event_cmd.flags));
+		if (type != TRB_TRANSFER) {
+			if (type != TRB_PORT_STATUS)
+				printf("Unexpected XHCI event TRB, skipping... (%08x %08x %08x %08x)\n",
+				       le32_to_cpu(event->generic.field[0]),
+				       le32_to_cpu(event->generic.field[1]),
+				       le32_to_cpu(event->generic.field[2]),
+				       le32_to_cpu(event->generic.field[3]));
+			goto next;
+		}
+
+		field = le32_to_cpu(event->trans_event.flags);
+		trb = (union xhci_trb *)(uintptr_t)
+			le64_to_cpu(event->trans_event.buffer);
+		for (i = 0, td = tds; i < count; i++, td++) {
+			if (TRB_TO_SLOT_ID(field) == udev->slot_id &&
+			    TRB_TO_EP_INDEX(field) == td->ep_index &&
+			    xhci_td_has_trb(td, trb))
+				break;
+		}
+		/* e.g. the IOC event following a short packet */
+		if (i == count || td->done)
+			goto next;
+
+		record_transfer_result(udev, event, td->req->length);
+		td->req->act_len = udev->act_len;
+		td->req->status = udev->status;
+		td->done = true;
+		pending--;
+		ts = get_timer(0);
+
+		if (udev->status) {
+			/* The endpoint has halted: drop the TDs behind this */
+			halted |= 1 << td->ep_index;
+			for (j = i + 1; j < count; j++) {
+				if (tds[j].ep_index == td->ep_index &&
+				    !tds[j].done) {
+					tds[j].done = true;
+					pending--;
+				}
+			}
+			ret = -EIO;
+		}
+next:
+		inc_deq(ctrl, ctrl->event_ring);
+		unacked = true;
+	}
+	if (unacked)
+		xhci_writeq(&ctrl->ir_set->erst_dequeue,
+			    (uintptr_t)ctrl->event_ring->dequeue | ERST_EHB);
+
+	for (i = 0; i < 32; i++) {
+		if ((halted | timed_out) & (1 << i))
+			xhci_batch_cleanup_ep(udev, i, halted & (1 << i));
+	}
+
+	for (i = 0, td = tds; i < count; i++, td++) {
+		if (td->req->act_len)
+			xhci_inval_cache((uintptr_t)td->req->buffer,
+					 td->req->length);
+	}
+
+	return ret;
+}
+
+/**
+ * Queues up several BULK Requests before waiting for them, so that the
+ * controller can go from one TD to the next without a round trip through
+ * software. TDs are queued until the batch or an endpoint ring is full,
+ * then waited for, and so on.
+ *
+ * @param udev		pointer to the USB device structure
+ * @param reqs		transfers to carry out
+ * @param count		number of transfers
+ * @return 0 if all transfers completed OK, else error code
+ */
+int xhci_bulk_batch(struct usb_device *udev, struct usb_bulk_req *reqs,
+		    int count)
+{
+	struct xhci_batch_td tds[XHCI_BULK_BATCH_MAX];
+	u8 ring_used[32];
+	int n, i = 0;
+	int ret;
+
+	while (i < count) {
+		memset(ring_used, '\0', sizeof(ring_used));
+		for (n = 0; n < XHCI_BULK_BATCH_MAX && i + n < count; n++) {
+			struct usb_bulk_req *req = &reqs[i + n];
+			struct xhci_batch_td *td = &tds[n];
+			int trbs;
+
+			if (usb_pipetype(req->pipe) != PIPE_BULK) {
+				printf("non-bulk pipe (type=%lu)",
+				       usb_pipetype(req->pipe));
+				ret = -EINVAL;
+				goto out;
+			}
+
+			/* Leave room for the link TRB and one spare */
+			td->ep_index = usb_pipe_ep_index(req->pipe);
+			trbs = xhci_bulk_td_trbs(req->buffer, req->length);
+			if (n && ring_used[td->ep_index] + trbs >
+				 TRBS_PER_SEGMENT - 2)
+				break;
+			ring_used[td->ep_index] += trbs;
+
+			td->req = req;
+			td->done = false;
+			ret = xhci_queue_bulk_td(udev, req->pipe, req->length,
+						 req->buffer, &td->first,
+						 &td->last);
+			if (ret) {
+				/* Let the TDs already queued finish first */
+				xhci_wait_bulk_batch(udev, tds, n);
+				goto out;
+			}
+		}
+
+		ret = xhci_wait_bulk_batch(udev, tds, n);
+		if (ret)
+			goto out;
+		i += n;
+	}
+
+	return 0;
+
+out:
+	/* Reflect the last completed transfer, as for a single one */
+	for (n = count - 1; n >= 0; n--) {
+		if (reqs[n].status != USB_ST_NOT_PROC) {
+			udev->status = reqs[n].status;
+			udev->act_len = reqs[n].act_len;
+			break;
+		}
+	}
+
+	return ret;
+}
+
 /**
  * Queues up the Control Transfer Request
  *
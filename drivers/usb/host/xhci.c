@@ -1280,6 +1280,12 @@ int submit_bulk_msg(struct usb_device *udev, unsigned long pipe, void *buffer,
 	return _xhci_submit_bulk_msg(udev, pipe, buffer, length);
 }
 
+int submit_bulk_batch(struct usb_device *udev, struct usb_bulk_req *reqs,
+		      int count)
+{
+	return xhci_bulk_batch(udev, reqs, count);
+}
+
 int submit_int_msg(struct usb_device *udev, unsigned long pipe, void *buffer,
 		   int length, int interval, bool nonblock)
 {
@@ -1389,6 +1395,15 @@ static int xhci_submit_bulk_msg(struct udevice *dev, struct usb_device *udev,
 	return _xhci_submit_bulk_msg(udev, pipe, buffer, length);
 }
 
+static int xhci_submit_bulk_batch(struct udevice *dev,
+				  struct usb_device *udev,
+				  struct usb_bulk_req *reqs, int count)
+{
+	debug("%s: dev='%s', udev=%p, count=%d\n", __func__, dev->name, udev,
+	      count);
+	return xhci_bulk_batch(udev, reqs, count);
+}
+
 static int xhci_submit_int_msg(struct udevice *dev, struct usb_device *udev,
 			       unsigned long pipe, void *buffer, int length,
 			       int interval, bool nonblock)
@@ -1534,6 +1549,7 @@ int xhci_deregister(struct udevice *dev)
 struct dm_usb_ops xhci_usb_ops = {
 	.control = xhci_submit_control_msg,
 	.bulk = xhci_submit_bulk_msg,
+	.bulk_batch = xhci_submit_bulk_batch,
 	.interrupt = xhci_submit_int_msg,
 	.alloc_device = xhci_alloc_device,
 	.update_hub_device = xhci_update_hub_device,
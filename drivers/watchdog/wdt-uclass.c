@@ -7,30 +7,125 @@
 #include <common.h>
 #include <dm.h>
 #include <errno.h>
+#include <watchdog.h>
 #include <wdt.h>
 #include <dm/device-internal.h>
 #include <dm/lists.h>
 
 DECLARE_GLOBAL_DATA_PTR;
 
+/**
+ * struct wdt_priv - per-device uclass state
+ *
+ * @timeout_ms:	timeout passed to wdt_start(), 0 when stopped
+ */
+struct wdt_priv {
+	u64 timeout_ms;
+};
+
+#if CONFIG_IS_ENABLED(WATCHDOG_PROGRESS)
+/*
+ * Kick interval for watchdog_progress(): the configured interval, or half
+ * the shortest running timeout if that is less. 0 means nothing is running.
+ */
+static ulong wdt_kick_interval;
+static ulong wdt_next_kick;
+
+static void wdt_update_kick_interval(void)
+{
+	struct wdt_priv *priv;
+	struct udevice *dev;
+	struct uclass *uc;
+	ulong interval = 0;
+
+	if (uclass_get(UCLASS_WDT, &uc))
+		return;
+
+	uclass_foreach_dev(dev, uc) {
+		priv = dev_get_uclass_priv(dev);
+		if (!device_active(dev) || !priv->timeout_ms)
+			continue;
+
+		if (!interval)
+			interval = CONFIG_WATCHDOG_PROGRESS_INTERVAL;
+		/* 0 would mean no watchdog is running, so never go below 1 */
+		interval = min_t(u64, interval, priv->timeout_ms / 2);
+		interval = max(interval, 1UL);
+	}
+
+	wdt_kick_interval = interval;
+	wdt_next_kick = get_timer(0) + interval;
+}
+
+void watchdog_progress(void)
+{
+	struct wdt_priv *priv;
+	struct udevice *dev;
+	struct uclass *uc;
+	ulong now;
+
+	/* Boards may also have a legacy watchdog, which callers used to kick */
+	WATCHDOG_RESET();
+
+	if (!wdt_kick_interval)
+		return;
+
+	now = get_timer(0);
+	if (time_before(now, wdt_next_kick))
+		return;
+	wdt_next_kick = now + wdt_kick_interval;
+
+	if (uclass_get(UCLASS_WDT, &uc))
+		return;
+
+	uclass_foreach_dev(dev, uc) {
+		priv = dev_get_uclass_priv(dev);
+		if (device_active(dev) && priv->timeout_ms)
+			wdt_reset(dev);
+	}
+}
+#else
+static inline void wdt_update_kick_interval(void)
+{
+}
+#endif
+
 int wdt_start(struct udevice *dev, u64 timeout_ms, ulong flags)
 {
 	const struct wdt_ops *ops = device_get_ops(dev);
+	struct wdt_priv *priv = dev_get_uclass_priv(dev);
+	int ret;
 
 	if (!ops->start)
 		return -ENOSYS;
 
-	return ops->start(dev, timeout_ms, flags);
+	ret = ops->start(dev, timeout_ms, flags);
+	if (ret)
+		return ret;
+
+	priv->timeout_ms = timeout_ms;
+	wdt_update_kick_interval();
+
+	return 0;
 }
 
 int wdt_stop(struct udevice *dev)
 {
 	const struct wdt_ops *ops = device_get_ops(dev);
+	struct wdt_priv *priv = dev_get_uclass_priv(dev);
+	int ret;
 
 	if (!ops->stop)
 		return -ENOSYS;
 
-	return ops->stop(dev);
+	ret = ops->stop(dev);
+	if (ret)
+		return ret;
+
+	priv->timeout_ms = 0;
+	wdt_update_kick_interval();
+
+	return 0;
 }
 
 int wdt_reset(struct udevice *dev)
@@ -66,7 +161,20 @@ int wdt_expire_now(struct udevice *dev, ulong flags)
 	return ret;
 }
 
+static int wdt_pre_remove(struct udevice *dev)
+{
+	struct wdt_priv *priv = dev_get_uclass_priv(dev);
+
+	/* A removed device is no longer kicked, so stop counting it */
+	priv->timeout_ms = 0;
+	wdt_update_kick_interval();
+
+	return 0;
+}
+
 UCLASS_DRIVER(wdt) = {
 	.id		= UCLASS_WDT,
 	.name		= "wdt",
+	.pre_remove	= wdt_pre_remove,
+	.per_device_auto_alloc_size = sizeof(struct wdt_priv),
 };
@@ -253,6 +253,25 @@ int adc_channel_single_shot(const char *name, int channel, unsigned int *data);
 int adc_channels_single_shot(const char *name, unsigned int channel_mask,
 			     struct adc_channel *channels);
 
+/**
+ * adc_channels_average() - sample the selected device's channels several
+ * times and return the average of each. The supply is enabled and the
+ * channel mask checked once, and then every sample converts all the selected
+ * channels in one sequence: by the device's multi-channel operation if it has
+ * one, or else by the sequence start/data for each channel in turn.
+ *
+ * This suits analog keys, where a few channels are read together and a
+ * single conversion may catch a bouncing contact.
+ *
+ * @dev:          ADC device to sample
+ * @channel_mask: channel selection - a bit mask
+ * @samples:      number of conversions to average, at least 1
+ * @channels:     pointer to averaged output data for the selected channels
+ * @return:       0 if OK, -ve on error
+ */
+int adc_channels_average(struct udevice *dev, unsigned int channel_mask,
+			 unsigned int samples, struct adc_channel *channels);
+
 /**
  * adc_vdd_value() - get the ADC device's positive reference Voltage value
  *
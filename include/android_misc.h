@@ -0,0 +1,85 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:     GPL-2.0+
+ */
+
+#ifndef __ANDROID_MISC_H
+#define __ANDROID_MISC_H
+
+#include <common.h>
+#include <blk.h>
+#include <part.h>
+
+#if CONFIG_IS_ENABLED(ANDROID_MISC_CACHE)
+/** android_misc_read - Read blocks of the misc partition.
+ * The first CONFIG_ANDROID_MISC_CACHE_SIZE bytes of the partition are loaded
+ * on first use and later reads of that area are served from memory. Pending
+ * writes are always visible to reads.
+ *
+ * @dev_desc:		device holding the misc partition.
+ * @part_info:		the misc partition.
+ * @blk:		first block to read, relative to the partition start.
+ * @blkcnt:		number of blocks to read.
+ * @buf:		destination buffer.
+ * @return the number of blocks read, like blk_dread().
+ */
+ulong android_misc_read(struct blk_desc *dev_desc,
+			const disk_partition_t *part_info,
+			lbaint_t blk, lbaint_t blkcnt, void *buf);
+
+/** android_misc_write - Write blocks of the misc partition.
+ * Writes to the cached area only update memory and are written back by
+ * android_misc_flush(), in the order they were first made, or straight away
+ * if too many updates are pending and cannot be written back. Use
+ * android_misc_flush() right after a write that must survive a crash.
+ *
+ * @dev_desc:		device holding the misc partition.
+ * @part_info:		the misc partition.
+ * @blk:		first block to write, relative to the partition start.
+ * @blkcnt:		number of blocks to write.
+ * @buf:		source buffer.
+ * @return the number of blocks written, like blk_dwrite().
+ */
+ulong android_misc_write(struct blk_desc *dev_desc,
+			 const disk_partition_t *part_info,
+			 lbaint_t blk, lbaint_t blkcnt, const void *buf);
+
+/** android_misc_flush - Write pending misc updates back to disk.
+ * Called before the kernel is started and before a reset.
+ *
+ * @return 0 on success, -ve on error. Updates that failed to write stay
+ * pending.
+ */
+int android_misc_flush(void);
+
+/** android_misc_invalidate - Flush and drop the cached misc area.
+ * Used before the partition is rewritten behind the cache's back, e.g. by
+ * fastboot.
+ */
+void android_misc_invalidate(void);
+#else
+static inline ulong android_misc_read(struct blk_desc *dev_desc,
+				      const disk_partition_t *part_info,
+				      lbaint_t blk, lbaint_t blkcnt, void *buf)
+{
+	return blk_dread(dev_desc, part_info->start + blk, blkcnt, buf);
+}
+
+static inline ulong android_misc_write(struct blk_desc *dev_desc,
+				       const disk_partition_t *part_info,
+				       lbaint_t blk, lbaint_t blkcnt,
+				       const void *buf)
+{
+	return blk_dwrite(dev_desc, part_info->start + blk, blkcnt, buf);
+}
+
+static inline int android_misc_flush(void)
+{
+	return 0;
+}
+
+static inline void android_misc_invalidate(void) {}
+#endif
+
+#endif
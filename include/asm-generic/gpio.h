@@ -265,6 +265,32 @@ struct dm_gpio_ops {
 	 */
 	int (*get_function)(struct udevice *dev, unsigned offset);
 
+	/**
+	 * get_values() - Read several GPIOs of this device at once
+	 *
+	 * This method is optional. Without it, get_value() is called for
+	 * each GPIO.
+	 *
+	 * @dev:	Device to read from
+	 * @mask:	GPIOs to read, bit n for offset n
+	 * @valuesp:	Returns the GPIO levels, only bits in @mask are valid
+	 * @return 0 if OK, -ve on error
+	 */
+	int (*get_values)(struct udevice *dev, ulong mask, ulong *valuesp);
+
+	/**
+	 * set_values() - Set several output GPIOs of this device at once
+	 *
+	 * This method is optional. Without it, set_value() is called for
+	 * each GPIO.
+	 *
+	 * @dev:	Device to write to
+	 * @mask:	GPIOs to set, bit n for offset n
+	 * @values:	New GPIO levels, bits outside @mask are ignored
+	 * @return 0 if OK, -ve on error
+	 */
+	int (*set_values)(struct udevice *dev, ulong mask, ulong values);
+
 	/**
 	 * xlate() - Translate phandle arguments into a GPIO description
 	 *
@@ -402,6 +428,34 @@ int gpio_get_values_as_int(const int *gpio_list);
  */
 int dm_gpio_get_values_as_int(const struct gpio_desc *desc_list, int count);
 
+/**
+ * dm_gpio_get_values() - Read a list of GPIOs with one access per device
+ *
+ * GPIOs on the same device are read together through the driver's
+ * get_values() method, if it has one. GPIO_ACTIVE_LOW is applied to each.
+ *
+ * @desc_list: List of GPIOs to read, at most BITS_PER_LONG
+ * @count: Number of GPIOs
+ * @valuesp: Returns the value of the first GPIO in bit 0, the second in
+ *	bit 1, etc.
+ * @return 0 if OK, -ve on error
+ */
+int dm_gpio_get_values(const struct gpio_desc *desc_list, int count,
+		       ulong *valuesp);
+
+/**
+ * dm_gpio_set_values() - Set a list of GPIOs with one access per device
+ *
+ * This is the counterpart of dm_gpio_get_values() for outputs.
+ *
+ * @desc_list: List of GPIOs to set, at most BITS_PER_LONG
+ * @count: Number of GPIOs
+ * @values: Value of the first GPIO in bit 0, the second in bit 1, etc.
+ * @return 0 if OK, -ve on error
+ */
+int dm_gpio_set_values(const struct gpio_desc *desc_list, int count,
+		       ulong values);
+
 /**
  * gpio_claim_vector() - claim a number of GPIOs for input
  *
@@ -99,6 +99,9 @@ struct blk_desc {
 		uint32_t mbr_sig;	/* MBR integer signature */
 		efi_guid_t guid_sig;	/* GPT GUID Signature */
 	};
+#ifdef CONFIG_PARTITION_CACHE
+	struct part_cache *part_cache;	/* parsed partition table, or NULL */
+#endif
 #if CONFIG_IS_ENABLED(BLK)
 	/*
 	 * For now we have a few functions which take struct blk_desc as a
@@ -211,6 +214,36 @@ static inline void blkcache_invalidate(int iftype, int dev) {}
 
 #endif
 
+#if defined(CONFIG_PARTITION_CACHE) && defined(HAVE_BLOCK_DEVICE)
+/**
+ * part_cache_invalidate() - discard the cached partition table of a device
+ *
+ * This must be called after the partition table is changed by means other
+ * than blk_dwrite()/blk_derase(), e.g. by writing to the device directly.
+ *
+ * @param dev_desc - block device descriptor
+ */
+void part_cache_invalidate(struct blk_desc *dev_desc);
+
+/**
+ * part_cache_check_write() - discard the partition cache if a write may
+ * change the partition table
+ *
+ * Writes which are contained within a single partition leave the cache
+ * intact. Anything else invalidates it.
+ *
+ * @param dev_desc - block device descriptor
+ * @param start - starting block number
+ * @param blkcnt - number of blocks being written
+ */
+void part_cache_check_write(struct blk_desc *dev_desc, lbaint_t start,
+			    lbaint_t blkcnt);
+#else
+static inline void part_cache_invalidate(struct blk_desc *dev_desc) {}
+static inline void part_cache_check_write(struct blk_desc *dev_desc,
+					  lbaint_t start, lbaint_t blkcnt) {}
+#endif
+
 #if CONFIG_IS_ENABLED(BLK)
 struct udevice;
 
@@ -454,6 +487,7 @@ static inline ulong blk_dwrite(struct blk_desc *block_dev, lbaint_t start,
 			       lbaint_t blkcnt, const void *buffer)
 {
 	blkcache_invalidate(block_dev->if_type, block_dev->devnum);
+	part_cache_check_write(block_dev, start, blkcnt);
 	return block_dev->block_write(block_dev, start, blkcnt, buffer);
 }
 
@@ -461,6 +495,7 @@ static inline ulong blk_derase(struct blk_desc *block_dev, lbaint_t start,
 			       lbaint_t blkcnt)
 {
 	blkcache_invalidate(block_dev->if_type, block_dev->devnum);
+	part_cache_check_write(block_dev, start, blkcnt);
 	return block_dev->block_erase(block_dev, start, blkcnt);
 }
 
@@ -77,6 +77,18 @@ struct clk_ops {
 	 * @return new rate, or -ve error code.
 	 */
 	ulong (*set_rate)(struct clk *clk, ulong rate);
+	/**
+	 * set_rates() - Set the rates of several clocks at once.
+	 *
+	 * Optional. The driver may reorder and overlap the changes, as long as
+	 * every clock ends up at its requested rate.
+	 *
+	 * @clks:	The clocks to manipulate, all of this provider.
+	 * @rates:	New clock rates in Hz.
+	 * @count:	Number of clocks.
+	 * @return zero on success, or -ve error code.
+	 */
+	int (*set_rates)(struct clk *clks, const ulong *rates, int count);
 	/**
 	 * clk_get_phase() - Get the phase shift of a clock signal.
 	 *
@@ -246,6 +246,21 @@ ulong clk_get_rate(struct clk *clk);
  */
 ulong clk_set_rate(struct clk *clk, ulong rate);
 
+/**
+ * clk_set_rates() - Set the rates of several clocks of one provider.
+ *
+ * The provider may reorder and overlap the changes, e.g. program all PLLs
+ * before waiting for any of them to lock, as long as every clock ends up at
+ * its requested rate. Providers without a set_rates() operation get the
+ * clocks set one by one, in order.
+ *
+ * @clks:	Clocks to change, all from the same provider.
+ * @rates:	Requested rate of each clock, in Hz.
+ * @count:	Number of clocks.
+ * @return 0 on success, or -ve error code.
+ */
+int clk_set_rates(struct clk *clks, const ulong *rates, int count);
+
 /**
  * clk_get_phase() - Get the phase shift of a clock signal.
  *
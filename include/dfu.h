@@ -176,6 +176,30 @@ int dfu_read(struct dfu_entity *de, void *buf, int size, int blk_seq_num);
 int dfu_write(struct dfu_entity *de, void *buf, int size, int blk_seq_num);
 int dfu_flush(struct dfu_entity *de, void *buf, int size, int blk_seq_num);
 
+/**
+ * dfu_get_write_buf - get the buffer the next dfu_write() data is stored in
+ *
+ * Data received straight into this buffer and then passed to dfu_write()
+ * is not copied again. The buffer changes after each dfu_write() call.
+ *
+ * @param dfu - dfu entity being written
+ *
+ * @return - pointer to the buffer, NULL on error
+ */
+unsigned char *dfu_get_write_buf(struct dfu_entity *dfu);
+
+/**
+ * dfu_write_poll - write one queued buffer to the medium
+ *
+ * With CONFIG_DFU_WRITE_BUFFERS (or $dfu_bufcnt) above one, dfu_write()
+ * only queues full buffers. Loops waiting for USB data call this so that
+ * the medium is programmed while the next buffer is being received. Errors
+ * are also reported by the next dfu_write() or dfu_flush().
+ *
+ * @return - 0 if nothing was queued or the write succeeded, else error
+ */
+int dfu_write_poll(void);
+
 /*
  * dfu_defer_flush - pointer to store dfu_entity for deferred flashing.
  *		     It should be NULL when not used.
@@ -0,0 +1,189 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#ifndef _EVENT_LOOP_H
+#define _EVENT_LOOP_H
+
+#include <linux/list.h>
+
+/*
+ * A small cooperative event loop. There is only one CPU and no scheduler, so
+ * work items run from inside whichever wait the caller is blocked in:
+ * event_wait(), event_loop_sleep() and wait_for_completion_timeout(). Work
+ * items must not rely on running from any particular context and must not
+ * block for long themselves.
+ *
+ * Waits on a condition that an interrupt handler or a work item will change
+ * let the CPU idle in between (WFI on ARM, a host signal wait on sandbox).
+ * The handler calls event_loop_wakeup() or complete() to end the idle early.
+ */
+
+#define EVENT_LOOP_IDLE_FOREVER		(~0UL)
+
+struct event_work;
+
+typedef void (*event_work_func_t)(struct event_work *work);
+
+/**
+ * struct event_work - a piece of deferred work
+ *
+ * @node:	entry in the list of queued work, sorted by @due
+ * @func:	function to call when the work is due
+ * @due:	get_timer() value at which the work may run
+ * @queued:	true while the work is on the list
+ */
+struct event_work {
+	struct list_head node;
+	event_work_func_t func;
+	ulong due;
+	bool queued;
+};
+
+/**
+ * struct completion - a one-shot event that a waiter can block on
+ *
+ * @done:	set by complete(), possibly from an interrupt handler
+ */
+struct completion {
+	volatile bool done;
+};
+
+static inline void init_completion(struct completion *comp)
+{
+	comp->done = false;
+}
+
+static inline bool completion_done(struct completion *comp)
+{
+	return comp->done;
+}
+
+#if CONFIG_IS_ENABLED(EVENT_LOOP)
+/**
+ * event_work_init() - prepare a work item for queueing
+ *
+ * @work:	work item
+ * @func:	function to call when the work runs
+ */
+void event_work_init(struct event_work *work, event_work_func_t func);
+
+/**
+ * event_queue_work() - run a work item once, after a delay
+ *
+ * A work item that is already queued is moved to the new time.
+ *
+ * @work:	work item
+ * @delay_ms:	minimum time to wait before running it, 0 to run it from the
+ *		next wait
+ */
+void event_queue_work(struct event_work *work, ulong delay_ms);
+
+/**
+ * event_cancel_work() - take a work item off the queue
+ *
+ * @work:	work item, which may or may not be queued
+ * @return true if the work was queued, false if not
+ */
+bool event_cancel_work(struct event_work *work);
+
+/**
+ * event_loop_run() - run all work that is due
+ *
+ * This is called by the waits below, but drivers with their own polling
+ * loop can call it too.
+ *
+ * @return time in ms until the next work item is due, or
+ * EVENT_LOOP_IDLE_FOREVER if none is queued
+ */
+ulong event_loop_run(void);
+
+/**
+ * event_wait() - wait for a condition, running work in the meantime
+ *
+ * The condition is expected to change from an interrupt handler or a work
+ * item, so the CPU may idle between checks. Polling hardware status should
+ * call event_loop_run() in its own loop instead.
+ *
+ * @cond:	returns true when the wait is over
+ * @data:	passed to @cond
+ * @timeout_ms:	maximum time to wait
+ * @return 0 if @cond became true, -ETIMEDOUT if not
+ */
+int event_wait(bool (*cond)(void *data), void *data, ulong timeout_ms);
+
+/**
+ * event_loop_sleep() - wait for a fixed time, running work in the meantime
+ *
+ * @ms:		time to wait
+ */
+void event_loop_sleep(ulong ms);
+
+/**
+ * event_loop_wakeup() - end the current idle early
+ *
+ * This may be called from an interrupt handler.
+ */
+void event_loop_wakeup(void);
+
+/**
+ * complete() - signal a completion and wake its waiter
+ *
+ * This may be called from an interrupt handler.
+ *
+ * @comp:	completion to signal
+ */
+void complete(struct completion *comp);
+
+/**
+ * wait_for_completion_timeout() - wait for complete() to be called
+ *
+ * @comp:	completion to wait on
+ * @timeout_ms:	maximum time to wait
+ * @return 0 if the completion was signalled, -ETIMEDOUT if not
+ */
+int wait_for_completion_timeout(struct completion *comp, ulong timeout_ms);
+
+/**
+ * event_loop_woken() - check whether event_loop_wakeup() has been called
+ *
+ * Architecture idle code calls this with interrupts masked, just before
+ * stopping the CPU, so that a wakeup that raced with the idle is not lost.
+ */
+bool event_loop_woken(void);
+
+/**
+ * arch_event_idle() - idle the CPU until an interrupt or a timeout
+ *
+ * This may return early. The default returns at once, which turns every
+ * wait into a busy poll.
+ *
+ * @ms:		maximum time to idle
+ */
+void arch_event_idle(ulong ms);
+
+/**
+ * arch_event_wakeup() - make a concurrent arch_event_idle() return
+ *
+ * Only needed where an interrupt does not wake the CPU by itself.
+ */
+void arch_event_wakeup(void);
+#else
+static inline ulong event_loop_run(void)
+{
+	return EVENT_LOOP_IDLE_FOREVER;
+}
+
+static inline void event_loop_sleep(ulong ms)
+{
+	mdelay(ms);
+}
+
+static inline void event_loop_wakeup(void)
+{
+}
+#endif
+
+#endif /* _EVENT_LOOP_H */
@@ -37,11 +37,13 @@ struct dm_key_uclass_platdata {
 	int center;
 	int min;
 	int max;
+	int adc_value;	/* average from the last scan of all ADC keys */
 
 	/* GPIO key */
 	u32 irq;
 	u32 gpios[2];	/* gpios[0]: gpio controller phandle, gpios[1]: pin */
 	struct gpio_desc gpio;
+	int gpio_value;	/* level from the last scan of all GPIO keys */
 
 	u64 rise_ms;
 	u64 fall_ms;
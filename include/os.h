@@ -170,6 +170,45 @@ void os_usleep(unsigned long usec);
  */
 uint64_t os_get_nsec(void);
 
+/**
+ * Wait for a wakeup signal from os_raise_wakeup(), or for a timeout
+ *
+ * \param usec Maximum time to wait in micro seconds
+ */
+void os_wait_wakeup(unsigned long usec);
+
+/**
+ * Send ourselves a wakeup signal, ending the current or next
+ * os_wait_wakeup() early. This is safe to call from a signal handler.
+ */
+void os_raise_wakeup(void);
+
+/**
+ * Run a function in a new host thread
+ *
+ * The function must only touch memory shared with its creator: it cannot
+ * call into U-Boot drivers, the console or the allocator.
+ *
+ * \param func		Function to run
+ * \param arg		Argument passed to @func
+ * \param threadp	Returns a handle for os_thread_join()
+ * \return 0 if OK, -1 on error
+ */
+int os_thread_create(void (*func)(void *arg), void *arg, void **threadp);
+
+/**
+ * Wait for a thread started by os_thread_create() to finish
+ *
+ * \param thread	Handle from os_thread_create()
+ * \return 0 if OK, -1 on error
+ */
+int os_thread_join(void *thread);
+
+/**
+ * Let other host threads run, e.g. while spinning on shared memory
+ */
+void os_thread_yield(void);
+
 /**
  * Parse arguments and update sandbox state.
  *
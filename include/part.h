@@ -276,6 +276,22 @@ struct part_driver {
 	int (*get_info)(struct blk_desc *dev_desc, int part,
 			disk_partition_t *info);
 
+	/**
+	 * get_all() - Get information about all partitions (optional)
+	 *
+	 * This lets the partition cache parse the whole table in one go
+	 * rather than calling get_info() for each partition.
+	 *
+	 * @dev_desc:	Block device descriptor
+	 * @add:	Called for each partition, in increasing partition
+	 *		number order. Returns 0 if OK, -ve to stop
+	 * @priv:	Private data to pass to @add
+	 * @return 0 if OK, -ve on error
+	 */
+	int (*get_all)(struct blk_desc *dev_desc,
+		       int (*add)(void *priv, int part, disk_partition_t *info),
+		       void *priv);
+
 	/**
 	 * print() - Print partition information
 	 *
@@ -170,6 +170,32 @@ struct dm_pmic_ops {
 	int (*shutdown)(struct udevice *dev);
 };
 
+/**
+ * struct pmic_reg_range - an inclusive range of PMIC registers
+ *
+ * @min:	first register
+ * @max:	last register
+ */
+struct pmic_reg_range {
+	uint min;
+	uint max;
+};
+
+/**
+ * struct pmic_cache_info - register cache description, see pmic_cache_init()
+ *
+ * @volatile_regs:	registers which must always be read from the device
+ * @num_volatile:	number of entries in @volatile_regs
+ * @max_burst:		maximum number of consecutive registers the device
+ *			accepts in one write, 0 or 1 if it has no
+ *			auto-increment
+ */
+struct pmic_cache_info {
+	const struct pmic_reg_range *volatile_regs;
+	int num_volatile;
+	int max_burst;
+};
+
 /**
  * enum pmic_op_type - used for various pmic devices operation calls,
  * for reduce a number of lines with the same code for read/write or get/set.
@@ -302,6 +328,58 @@ int pmic_reg_write(struct udevice *dev, uint reg, uint value);
  */
 int pmic_clrsetbits(struct udevice *dev, uint reg, uint clr, uint set);
 
+#if CONFIG_IS_ENABLED(PMIC_REG_CACHE)
+/**
+ * pmic_cache_init() - start caching the registers of a PMIC
+ *
+ * Registers up to pmic_reg_count() which are not listed as volatile are read
+ * from the device once and then served from memory. Writes go to the device
+ * straight away unless pmic_cache_defer() is in effect.
+ *
+ * Accesses made by the driver through its own read/write functions bypass
+ * the cache, so such registers should be volatile.
+ *
+ * @dev:	PMIC device, normally called from its probe() method
+ * @info:	cache description, must stay valid while the device is bound
+ * @return 0 on success or negative value of errno.
+ */
+int pmic_cache_init(struct udevice *dev, const struct pmic_cache_info *info);
+
+/**
+ * pmic_cache_defer() - hold back writes to cached registers
+ *
+ * Until pmic_cache_sync() is called, writes to non-volatile registers only
+ * update the cache. Writes to consecutive registers are merged into one bus
+ * write of up to info->max_burst registers; anything that cannot be merged,
+ * as well as any access to a volatile or uncached register, first sends what
+ * is held back, so the device sees the writes in program order.
+ *
+ * @dev:	PMIC device
+ */
+void pmic_cache_defer(struct udevice *dev);
+
+/**
+ * pmic_cache_sync() - send held-back writes and stop deferring
+ *
+ * @dev:	PMIC device
+ * @return 0 on success or negative value of errno.
+ */
+int pmic_cache_sync(struct udevice *dev);
+#else
+static inline int pmic_cache_init(struct udevice *dev,
+				  const struct pmic_cache_info *info)
+{
+	return 0;
+}
+
+static inline void pmic_cache_defer(struct udevice *dev) {}
+
+static inline int pmic_cache_sync(struct udevice *dev)
+{
+	return 0;
+}
+#endif
+
 /**
  * pmic_suspend() - suspend of PMIC
  *
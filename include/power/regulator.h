@@ -383,6 +383,22 @@ int regulator_get_mode(struct udevice *dev);
  */
 int regulator_set_mode(struct udevice *dev, int mode_id);
 
+/**
+ * regulator_ramp_batch_begin() - start collecting voltage ramp delays
+ *
+ * Until regulator_ramp_batch_end() is called, regulator_set_value() does not
+ * wait for the new voltage to settle but only records how long it would
+ * have waited. Use this when setting up several independent rails.
+ */
+void regulator_ramp_batch_begin(void);
+
+/**
+ * regulator_ramp_batch_end() - wait once for all collected ramp delays
+ *
+ * @return the time waited, i.e. the longest collected delay, in us
+ */
+u32 regulator_ramp_batch_end(void);
+
 /**
  * regulators_enable_boot_on() - enable regulators needed for boot
  *
@@ -390,7 +406,11 @@ int regulator_set_mode(struct udevice *dev, int mode_id);
  * only works for regulators which don't have a range for voltage/current,
  * since in that case it is not possible to know which value to use.
  *
- * This effectively calls regulator_autoset() for every regulator.
+ * This effectively calls regulator_autoset() for every regulator, with the
+ * voltage ramp delays overlapped (see regulator_ramp_batch_begin()) and the
+ * PMIC register writes deferred (see pmic_cache_defer()). A regulator fed by
+ * one set up earlier in the same batch (its vin-supply or its parent) waits
+ * for that supply's writes and ramp first.
  */
 int regulators_enable_boot_on(bool verbose);
 
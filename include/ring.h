@@ -0,0 +1,163 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#ifndef _RING_H
+#define _RING_H
+
+#include <asm/cache.h>
+
+/*
+ * A lock-free ring of fixed-size elements for passing work or log records
+ * between CPU cores: one or several producers, one consumer. Unlike membuff,
+ * both sides may run at the same time on different cores.
+ *
+ * Indexes run freely and are masked on access, so the element count must be
+ * a power of two. Each side publishes its index with a store-release and
+ * reads the other side's index with a load-acquire, which is LDAR/STLR on
+ * AArch64. Elements are accessed in place: a producer reserves slots, fills
+ * them and commits them, and the consumer peeks at slots and releases them.
+ *
+ * The ring and its data must be in memory both cores see coherently. With
+ * RING_F_MP_PRODUCER, producers claim slots with an atomic compare-and-swap,
+ * which needs the data cache enabled; they also commit in the order they
+ * reserved, so a producer must not be interrupted by another producer on the
+ * same core between ring_reserve() and ring_commit().
+ */
+
+#ifdef CONFIG_SANDBOX
+#define RING_CACHELINE		64	/* the host's, not ARCH_DMA_MINALIGN */
+#else
+#define RING_CACHELINE		ARCH_DMA_MINALIGN
+#endif
+
+/* Several producers may reserve and commit at the same time */
+#define RING_F_MP_PRODUCER	BIT(0)
+
+/**
+ * struct ring - a lock-free ring
+ *
+ * Each group of fields is written by one side only and has a cache line to
+ * itself, so that the two sides do not keep stealing each other's lines.
+ *
+ * @prod_head:	next slot a producer will reserve
+ * @prod_tail:	slots before this have been committed
+ * @cons_tail:	slots before this have been released by the consumer
+ * @data:	element storage
+ * @mask:	number of elements - 1
+ * @elem_size:	size of each element in bytes
+ * @flags:	RING_F_...
+ */
+struct ring {
+	u32 prod_head __aligned(RING_CACHELINE);
+	u32 prod_tail;
+
+	u32 cons_tail __aligned(RING_CACHELINE);
+
+	char *data __aligned(RING_CACHELINE);
+	u32 mask;
+	u32 elem_size;
+	uint flags;
+};
+
+/**
+ * struct ring_span - contiguous slots handed out by the ring
+ *
+ * @ptr:	address of the first slot
+ * @start:	index of the first slot
+ * @count:	number of slots
+ */
+struct ring_span {
+	void *ptr;
+	u32 start;
+	u32 count;
+};
+
+/**
+ * ring_init() - set up an empty ring
+ *
+ * @r:		ring to set up
+ * @data:	storage for @count elements of @elem_size bytes
+ * @count:	number of elements, a power of two
+ * @elem_size:	size of each element in bytes
+ * @flags:	RING_F_...
+ * @return 0 if OK, -EINVAL if @count is not a power of two
+ */
+int ring_init(struct ring *r, void *data, u32 count, u32 elem_size,
+	      uint flags);
+
+/**
+ * ring_reserve() - claim free slots for writing
+ *
+ * The slots are contiguous, so fewer than @n may be returned when the free
+ * space wraps around the end of the storage. Calling again after committing
+ * gets the rest.
+ *
+ * @r:		ring to write to
+ * @n:		number of slots wanted
+ * @span:	returns the slots claimed
+ * @return number of slots claimed, 0 if the ring is full
+ */
+u32 ring_reserve(struct ring *r, u32 n, struct ring_span *span);
+
+/**
+ * ring_commit() - make filled slots visible to the consumer
+ *
+ * @r:		ring being written
+ * @span:	slots from ring_reserve(), all filled in
+ */
+void ring_commit(struct ring *r, const struct ring_span *span);
+
+/**
+ * ring_peek() - get committed slots for reading
+ *
+ * Like ring_reserve(), this may return fewer than @n slots at the wrap.
+ *
+ * @r:		ring to read from
+ * @n:		maximum number of slots wanted
+ * @span:	returns the slots available
+ * @return number of slots available, 0 if the ring is empty
+ */
+u32 ring_peek(struct ring *r, u32 n, struct ring_span *span);
+
+/**
+ * ring_release() - hand slots that have been read back to the producers
+ *
+ * @r:		ring being read
+ * @span:	slots from ring_peek(), possibly with a smaller count
+ */
+void ring_release(struct ring *r, const struct ring_span *span);
+
+/**
+ * ring_enqueue() - copy elements into the ring
+ *
+ * @r:		ring to write to
+ * @elems:	elements to copy
+ * @n:		number of elements
+ * @return number of elements copied, less than @n if the ring got full
+ */
+u32 ring_enqueue(struct ring *r, const void *elems, u32 n);
+
+/**
+ * ring_dequeue() - copy elements out of the ring
+ *
+ * @r:		ring to read from
+ * @elems:	buffer for up to @n elements
+ * @n:		maximum number of elements
+ * @return number of elements copied
+ */
+u32 ring_dequeue(struct ring *r, void *elems, u32 n);
+
+/**
+ * ring_count() - number of committed elements not yet released
+ *
+ * Only exact when neither side is running.
+ *
+ * @r:		ring to check
+ * @return number of elements
+ */
+u32 ring_count(struct ring *r);
+
+#endif /* _RING_H */
@@ -7,14 +7,154 @@
 #ifndef __SANDBOX_BLOCK_DEV__
 #define __SANDBOX_BLOCK_DEV__
 
+#include <linux/list.h>
+
+/**
+ * struct sandbox_storage_model - timing of an emulated storage device
+ *
+ * Requests are split into commands of at most @max_bytes. Each command costs
+ * @cmd_us, except that up to @queue_depth commands are overlapped. Data
+ * moves at the read/write bandwidth. Devices with an internal page (NAND)
+ * also pay @page_read_us or @page_prog_us for each page touched, and
+ * @erase_us for each erase unit erased.
+ *
+ * @name:		Profile name, e.g. "emmc"
+ * @cmd_us:		Fixed cost of each command in microseconds
+ * @read_kbps:		Read bandwidth in KiB/s, 0 for no limit
+ * @write_kbps:		Write bandwidth in KiB/s, 0 for no limit
+ * @max_bytes:		Largest command in bytes, 0 for no limit
+ * @queue_depth:	Number of commands which can be in flight
+ * @page_size:		Internal page size in bytes, 0 if none
+ * @page_read_us:	Time to load one page into the cache
+ * @page_prog_us:	Time to program one page
+ * @erase_size:		Erase unit in bytes, 0 if erase is free
+ * @erase_us:		Time to erase one erase unit
+ */
+struct sandbox_storage_model {
+	const char *name;
+	uint cmd_us;
+	uint read_kbps;
+	uint write_kbps;
+	uint max_bytes;
+	uint queue_depth;
+	uint page_size;
+	uint page_read_us;
+	uint page_prog_us;
+	uint erase_size;
+	uint erase_us;
+};
+
+/**
+ * struct sandbox_storage_stats - statistics for an emulated storage device
+ *
+ * @reads:		Number of read requests
+ * @writes:		Number of write requests
+ * @erases:		Number of erase requests
+ * @read_bytes:		Bytes read
+ * @write_bytes:	Bytes written
+ * @erase_bytes:	Bytes erased
+ * @time_us:		Modelled time spent on all requests
+ */
+struct sandbox_storage_stats {
+	ulong reads;
+	ulong writes;
+	ulong erases;
+	u64 read_bytes;
+	u64 write_bytes;
+	u64 erase_bytes;
+	u64 time_us;
+};
+
+enum sandbox_storage_op {
+	SANDBOX_STORAGE_READ,
+	SANDBOX_STORAGE_WRITE,
+	SANDBOX_STORAGE_ERASE,
+};
+
+/**
+ * struct sandbox_storage - an emulated storage device with a timing model
+ *
+ * @name:	Name shown by 'host stats'
+ * @model:	Timing model, NULL to add no time
+ * @stats:	Statistics since the last reset
+ * @sibling:	Entry in the list of all emulated storage devices
+ */
+struct sandbox_storage {
+	const char *name;
+	const struct sandbox_storage_model *model;
+	struct sandbox_storage_stats stats;
+	struct list_head sibling;
+};
+
 struct host_block_dev {
 #ifndef CONFIG_BLK
 	struct blk_desc blk_dev;
 #endif
 	char *filename;
 	int fd;
+	struct sandbox_storage storage;
 };
 
 int host_dev_bind(int dev, char *filename);
 
+/**
+ * host_dev_set_model() - Set the timing model of a host device
+ *
+ * @dev:	Host device number
+ * @name:	Profile name (see sandbox_storage_find_model())
+ * @return 0 if OK, -ENODEV if the device is not bound, -ENOENT if there is
+ * no such profile
+ */
+int host_dev_set_model(int dev, const char *name);
+
+/**
+ * sandbox_storage_find_model() - Look up a timing profile by name
+ *
+ * Profiles are "none", "emmc", "spi-nand", "spi-nor" and "usb-msc".
+ *
+ * @name:	Profile name
+ * @return profile, or NULL if not found
+ */
+const struct sandbox_storage_model *sandbox_storage_find_model(
+							const char *name);
+
+/**
+ * sandbox_storage_register() - Add a device to the list shown by 'host stats'
+ *
+ * @storage:	Device to add, with name and model already set up
+ */
+void sandbox_storage_register(struct sandbox_storage *storage);
+
+/**
+ * sandbox_storage_unregister() - Remove a device from the list
+ *
+ * @storage:	Device to remove; may not have been registered
+ */
+void sandbox_storage_unregister(struct sandbox_storage *storage);
+
+/**
+ * sandbox_storage_account() - Account for one request to a device
+ *
+ * This updates the statistics and advances the sandbox timer by the time the
+ * request takes in the device's timing model, so that code measuring its
+ * own throughput with get_timer() sees the modelled device.
+ *
+ * @storage:	Device the request was made to
+ * @op:		Type of request
+ * @offset:	Byte offset of the request
+ * @len:	Length of the request in bytes
+ * @return modelled time for the request in microseconds
+ */
+ulong sandbox_storage_account(struct sandbox_storage *storage,
+			      enum sandbox_storage_op op, u64 offset, u64 len);
+
+/**
+ * sandbox_storage_list() - Get the list of registered devices
+ *
+ * Use list_for_each_entry() with the @sibling member to walk it.
+ *
+ * @return list head of all registered devices
+ */
+struct list_head *sandbox_storage_list(void);
+
 #endif
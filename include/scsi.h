@@ -7,6 +7,7 @@
  #ifndef _SCSI_H
  #define _SCSI_H
 
+#include <blk.h>
 #include <asm/cache.h>
 #include <linux/dma-direction.h>
 
@@ -186,6 +187,23 @@ struct scsi_ops {
 	 */
 	int (*exec)(struct udevice *dev, struct scsi_cmd *cmd);
 
+	/**
+	 * read() - read blocks without going through exec()
+	 *
+	 * This is optional. Controllers which can build their own read
+	 * requests (e.g. spread over several hardware queue slots) implement
+	 * it to avoid the per-command SCSI translation in scsi_read().
+	 *
+	 * @dev:	SCSI bus
+	 * @desc:	Block device to read from
+	 * @start:	First block to read
+	 * @blkcnt:	Number of blocks to read
+	 * @buffer:	Destination buffer
+	 * @return 0 if OK, -ve on error
+	 */
+	int (*read)(struct udevice *dev, struct blk_desc *desc, lbaint_t start,
+		    lbaint_t blkcnt, void *buffer);
+
 	/**
 	 * bus_reset() - reset the bus
 	 *
@@ -208,6 +226,20 @@ extern struct scsi_ops scsi_ops;
  */
 int scsi_exec(struct udevice *dev, struct scsi_cmd *cmd);
 
+/**
+ * scsi_read_blocks() - read blocks using the controller's read() method
+ *
+ * @dev:	SCSI bus
+ * @desc:	Block device to read from
+ * @start:	First block to read
+ * @blkcnt:	Number of blocks to read
+ * @buffer:	Destination buffer
+ * @return 0 if OK, -ENOSYS if the controller has no read() method, other
+ *	-ve on error
+ */
+int scsi_read_blocks(struct udevice *dev, struct blk_desc *desc,
+		     lbaint_t start, lbaint_t blkcnt, void *buffer);
+
 /**
  * scsi_bus_reset() - reset the bus
  *
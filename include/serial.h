@@ -105,6 +105,24 @@ struct dm_serial_ops {
 	 * @return 0 if OK, -ve on error
 	 */
 	int (*putc)(struct udevice *dev, const char ch);
+	/**
+	 * puts() - Write a string
+	 *
+	 * Write as many characters as the hardware can take without waiting
+	 * on each one, e.g. up to the size of an empty TX FIFO. The uclass
+	 * calls this again for the rest of the string and handles '\r'
+	 * insertion, so @s never contains a '\n' that needs one.
+	 *
+	 * This method is optional. If not provided, putc() is used for each
+	 * character.
+	 *
+	 * @dev: Device pointer
+	 * @s: The string to write
+	 * @len: Number of characters to write
+	 * @return number of characters written (> 0), -EAGAIN if the device
+	 * cannot take any yet, other -ve on error
+	 */
+	int (*puts)(struct udevice *dev, const char *s, size_t len);
 	/**
 	 * pending() - Check if input/output characters are waiting
 	 *
@@ -0,0 +1,52 @@
+/* SPDX-License-Identifier: GPL-2.0+ */
+#ifndef _UFS_H
+#define _UFS_H
+
+#include <blk.h>
+
+struct udevice;
+
+/**
+ * ufs_probe() - initialize all devices in the UFS uclass
+ *
+ * @return 0 if Ok, -ve on error
+ */
+int ufs_probe(void);
+
+/**
+ * ufs_probe_dev() - initialize a particular device in the UFS uclass
+ *
+ * @index: index in the uclass sequence
+ *
+ * @return 0 if successfully probed, -ve on error
+ */
+int ufs_probe_dev(int index);
+
+/*
+ * ufs_scsi_bind() - Create a new scsi device as a child of the UFS device and
+ *		     bind it to the ufs_scsi driver
+ * @ufs_dev: UFS device
+ * @scsi_devp: Pointer to scsi device
+ *
+ * @return 0 if Ok, -ve on error
+ */
+int ufs_scsi_bind(struct udevice *ufs_dev, struct udevice **scsi_devp);
+
+/**
+ * ufs_read_boot_lun() - read from the active boot well-known LUN
+ *
+ * The read is issued straight to the host controller, skipping the SCSI
+ * block layer. The block size of the boot LUN is read from the device on
+ * first use.
+ *
+ * @ufs_dev: Probed UFS device
+ * @start: First logical block to read
+ * @blkcnt: Number of logical blocks to read
+ * @buffer: Destination buffer
+ *
+ * @return 0 if Ok, -ve on error
+ */
+int ufs_read_boot_lun(struct udevice *ufs_dev, lbaint_t start,
+		      lbaint_t blkcnt, void *buffer);
+
+#endif
@@ -182,6 +182,42 @@ int usb_reset_root_port(struct usb_device *dev);
 
 int submit_bulk_msg(struct usb_device *dev, unsigned long pipe,
 			void *buffer, int transfer_len);
+
+/**
+ * struct usb_bulk_req - One bulk transfer of a batch
+ *
+ * @pipe:	Bulk pipe to use
+ * @buffer:	Buffer to send/receive, which should be DMA-aligned
+ * @length:	Number of bytes to transfer
+ * @act_len:	Returns the number of bytes transferred
+ * @status:	Returns the USB_ST_... status of the transfer (0 if OK), or
+ *		USB_ST_NOT_PROC if it was not carried out since an earlier
+ *		transfer failed
+ */
+struct usb_bulk_req {
+	unsigned long pipe;
+	void *buffer;
+	int length;
+	int act_len;
+	unsigned long status;
+};
+
+/**
+ * submit_bulk_batch() - Queue several bulk transfers at once
+ *
+ * The transfers are all handed to the host controller before waiting for
+ * any of them, so the controller can move straight from one to the next.
+ * They are carried out in order per endpoint. If a transfer fails, the
+ * following transfers on that endpoint are not carried out.
+ *
+ * @dev:	USB device
+ * @reqs:	Transfers to carry out
+ * @count:	Number of transfers
+ * @return 0 if all transfers completed OK, -ENOSYS if the host controller
+ *	   does not support this, other -ve on error
+ */
+int submit_bulk_batch(struct usb_device *dev, struct usb_bulk_req *reqs,
+		      int count);
 int submit_control_msg(struct usb_device *dev, unsigned long pipe, void *buffer,
 			int transfer_len, struct devrequest *setup);
 int submit_int_msg(struct usb_device *dev, unsigned long pipe, void *buffer,
@@ -262,6 +298,8 @@ int usb_control_msg(struct usb_device *dev, unsigned int pipe,
 			void *data, unsigned short size, int timeout);
 int usb_bulk_msg(struct usb_device *dev, unsigned int pipe,
 			void *data, int len, int *actual_length, int timeout);
+int usb_bulk_batch(struct usb_device *dev, struct usb_bulk_req *reqs,
+		   int count, int timeout);
 int usb_int_msg(struct usb_device *dev, unsigned long pipe,
 		void *buffer, int transfer_len, int interval, bool nonblock);
 int usb_disable_asynch(int disable);
@@ -700,6 +738,13 @@ struct dm_usb_ops {
 	 */
 	int (*bulk)(struct udevice *bus, struct usb_device *udev,
 		    unsigned long pipe, void *buffer, int length);
+	/**
+	 * bulk_batch() - Queue several bulk messages at once (optional)
+	 *
+	 * See submit_bulk_batch() for details.
+	 */
+	int (*bulk_batch)(struct udevice *bus, struct usb_device *udev,
+			  struct usb_bulk_req *reqs, int count);
 	/**
 	 * interrupt() - Send an interrupt message
 	 *
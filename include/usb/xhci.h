@@ -27,6 +27,8 @@
 #define XHCI_ALIGNMENT		64
 /* Generic timeout for XHCI events */
 #define XHCI_TIMEOUT		5000
+/* Max number of bulk TDs queued at once by xhci_bulk_batch() */
+#define XHCI_BULK_BATCH_MAX	8
 /* Max number of USB devices for any host controller - limit in section 6.1 */
 #define MAX_HC_SLOTS            256
 /* Section 5.3.3 - MaxPorts */
@@ -1255,6 +1257,8 @@ void xhci_queue_command(struct xhci_ctrl *ctrl, u8 *ptr,
 			u32 slot_id, u32 ep_index, trb_type cmd);
 void xhci_acknowledge_event(struct xhci_ctrl *ctrl);
 union xhci_trb *xhci_wait_for_event(struct xhci_ctrl *ctrl, trb_type expected);
+int xhci_bulk_batch(struct usb_device *udev, struct usb_bulk_req *reqs,
+		    int count);
 int xhci_bulk_tx(struct usb_device *udev, unsigned long pipe,
 		 int length, void *buffer);
 int xhci_ctrl_tx(struct usb_device *udev, unsigned long pipe,
@@ -68,6 +68,19 @@ int init_func_watchdog_reset(void);
 	#endif /* CONFIG_WATCHDOG && !__ASSEMBLY__ */
 #endif /* CONFIG_HW_WATCHDOG */
 
+/*
+ * Progress from a long operation, e.g. for each chunk written. This is cheap
+ * to call often: with driver model, running watchdogs are kicked at most
+ * every CONFIG_WATCHDOG_PROGRESS_INTERVAL ms, and well within their timeout.
+ */
+#if !defined(__ASSEMBLY__) && !defined(USE_HOSTCC)
+#if CONFIG_IS_ENABLED(WATCHDOG_PROGRESS)
+	void watchdog_progress(void);
+#else
+	#define watchdog_progress() WATCHDOG_RESET()
+#endif
+#endif
+
 /*
  * Prototypes from $(CPU)/cpu.c.
  */
@@ -25,6 +25,7 @@
 #include <common.h>
 #include <image.h>
 #include <android_image.h>
+#include <android_misc.h>
 #include <malloc.h>
 #include <mapmem.h>
 #include <errno.h>
@@ -68,6 +69,29 @@ static void byte_to_block(int64_t *offset,
 	}
 }
 
+/* A/B metadata lives in misc, serve it from the misc cache */
+static ulong avb_blk_read(struct blk_desc *dev_desc, const char *partition,
+			  disk_partition_t *part_info, lbaint_t blk,
+			  lbaint_t blkcnt, void *buffer)
+{
+	if (!strcmp(partition, PART_MISC))
+		return android_misc_read(dev_desc, part_info, blk, blkcnt,
+					 buffer);
+
+	return blk_dread(dev_desc, part_info->start + blk, blkcnt, buffer);
+}
+
+static ulong avb_blk_write(struct blk_desc *dev_desc, const char *partition,
+			   disk_partition_t *part_info, lbaint_t blk,
+			   lbaint_t blkcnt, const void *buffer)
+{
+	if (!strcmp(partition, PART_MISC))
+		return android_misc_write(dev_desc, part_info, blk, blkcnt,
+					  buffer);
+
+	return blk_dwrite(dev_desc, part_info->start + blk, blkcnt, buffer);
+}
+
 static AvbIOResult get_size_of_partition(AvbOps *ops,
 					 const char *partition,
 					 uint64_t *out_size_in_bytes)
@@ -123,8 +147,8 @@ static AvbIOResult read_from_partition(AvbOps *ops,
 	}
 
 	if ((offset % 512 == 0) && (num_bytes % 512 == 0)) {
-		blk_dread(dev_desc, part_info.start + offset_blk,
-			  blkcnt, buffer);
+		avb_blk_read(dev_desc, partition, &part_info, offset_blk,
+			     blkcnt, buffer);
 		*out_num_read = blkcnt * 512;
 	} else {
 		char *buffer_temp;
@@ -134,8 +158,8 @@ static AvbIOResult read_from_partition(AvbOps *ops,
 			printf("malloc error!\n");
 			return AVB_IO_RESULT_ERROR_OOM;
 		}
-		blk_dread(dev_desc, part_info.start + offset_blk,
-			  blkcnt, buffer_temp);
+		avb_blk_read(dev_desc, partition, &part_info, offset_blk,
+			     blkcnt, buffer_temp);
 		memcpy(buffer, buffer_temp + (offset % 512), num_bytes);
 		*out_num_read = num_bytes;
 		free(buffer_temp);
@@ -173,12 +197,13 @@ static AvbIOResult write_to_partition(AvbOps *ops,
 		return AVB_IO_RESULT_ERROR_NO_SUCH_PARTITION;
 	}
 
-	if ((offset % 512 != 0) && (num_bytes % 512) != 0)
-		blk_dread(dev_desc, part_info.start + offset_blk,
-			  blkcnt, buffer_temp);
+	if ((offset % 512 != 0) || (num_bytes % 512) != 0)
+		avb_blk_read(dev_desc, partition, &part_info, offset_blk,
+			     blkcnt, buffer_temp);
 
-	memcpy(buffer_temp, buffer + (offset % 512), num_bytes);
-	blk_dwrite(dev_desc, part_info.start + offset_blk, blkcnt, buffer);
+	memcpy(buffer_temp + (offset % 512), buffer, num_bytes);
+	avb_blk_write(dev_desc, partition, &part_info, offset_blk,
+		      blkcnt, buffer_temp);
 	free(buffer_temp);
 
 	return AVB_IO_RESULT_OK;
@@ -13,6 +13,7 @@
 #include <mmc.h>
 #include <efi_loader.h>
 #include <inttypes.h>
+#include <malloc.h>
 #include <part.h>
 
 /* template END node: */
@@ -439,17 +440,103 @@ static void *dp_part_fill(void *buf, struct blk_desc *desc, int part)
 }
 
 
-/* Construct a device-path from a partition on a blk device: */
+/*
+ * Device-paths of partitions are asked for again each time a file is loaded
+ * (efi_set_bootdev()), and building one walks the device's parents and reads
+ * the partition table. Keep the ones built so far, and hand one out again
+ * while the block device still looks the same.
+ */
+struct dp_part_cache {
+	struct list_head link;
+	struct blk_desc *desc;
+	int part;
+	/* what the medium looked like when the path was built */
+	enum if_type if_type;
+	int devnum;
+	lbaint_t lba;
+	unsigned char part_type;
+	enum sig_type sig_type;
+	efi_guid_t guid_sig;
+	struct efi_device_path *dp;
+};
+
+static LIST_HEAD(dp_part_cache_list);
+
+static bool dp_part_cache_valid(struct dp_part_cache *ent,
+				struct blk_desc *desc)
+{
+	return ent->if_type == desc->if_type &&
+	       ent->devnum == desc->devnum &&
+	       ent->lba == desc->lba &&
+	       ent->part_type == desc->part_type &&
+	       ent->sig_type == desc->sig_type &&
+	       !guidcmp(&ent->guid_sig, &desc->guid_sig);
+}
+
+static struct efi_device_path *dp_part_cache_find(struct blk_desc *desc,
+						  int part)
+{
+	struct dp_part_cache *ent;
+
+	list_for_each_entry(ent, &dp_part_cache_list, link) {
+		if (ent->desc != desc || ent->part != part)
+			continue;
+
+		if (dp_part_cache_valid(ent, desc))
+			return ent->dp;
+
+		/* The old path may still be installed, so don't free it */
+		list_del(&ent->link);
+		free(ent);
+		break;
+	}
+
+	return NULL;
+}
+
+static void dp_part_cache_add(struct blk_desc *desc, int part,
+			      struct efi_device_path *dp)
+{
+	struct dp_part_cache *ent;
+
+	ent = malloc(sizeof(*ent));
+	if (!ent)
+		return;
+
+	ent->desc = desc;
+	ent->part = part;
+	ent->if_type = desc->if_type;
+	ent->devnum = desc->devnum;
+	ent->lba = desc->lba;
+	ent->part_type = desc->part_type;
+	ent->sig_type = desc->sig_type;
+	ent->guid_sig = desc->guid_sig;
+	ent->dp = dp;
+	list_add(&ent->link, &dp_part_cache_list);
+}
+
+/*
+ * Construct a device-path from a partition on a blk device. The result is
+ * shared between callers and must not be modified or freed.
+ */
 struct efi_device_path *efi_dp_from_part(struct blk_desc *desc, int part)
 {
 	void *buf, *start;
 
+	start = dp_part_cache_find(desc, part);
+	if (start)
+		return start;
+
 	start = buf = dp_alloc(dp_part_size(desc, part) + sizeof(END));
+	if (!start)
+		return NULL;
 
 	buf = dp_part_fill(buf, desc, part);
 
 	*((struct efi_device_path *)buf) = END;
 
+	dp_part_cache_add(desc, part, start);
+
 	return start;
 }
 
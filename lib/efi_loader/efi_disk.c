@@ -88,38 +88,92 @@ static efi_status_t EFIAPI efi_disk_rw_blocks(struct efi_block_io *this,
 	return EFI_SUCCESS;
 }
 
-static efi_status_t EFIAPI efi_disk_read_blocks(struct efi_block_io *this,
-			u32 media_id, u64 lba, unsigned long buffer_size,
-			void *buffer)
+/* Size of the bounce buffer used when there is no EFI_LOADER_BOUNCE_BUFFER */
+#define EFI_DISK_BOUNCE_SIZE	(1024 * 1024)
+
+/*
+ * Block drivers can DMA straight into the payload's buffer when it is cache
+ * line aligned and, on platforms with a bounce buffer, below 4GiB.
+ */
+static bool efi_disk_can_dma(void *buffer, unsigned long buffer_size)
 {
-	void *real_buffer = buffer;
-	efi_status_t r;
+	if ((uintptr_t)buffer & (ARCH_DMA_MINALIGN - 1))
+		return false;
+#ifdef CONFIG_EFI_LOADER_BOUNCE_BUFFER
+	if ((u64)(uintptr_t)buffer + buffer_size > 0x100000000ULL)
+		return false;
+#endif
+
+	return true;
+}
 
+static void *efi_disk_bounce_buffer(unsigned long *size)
+{
 #ifdef CONFIG_EFI_LOADER_BOUNCE_BUFFER
-	if (buffer_size > EFI_LOADER_BOUNCE_BUFFER_SIZE) {
-		r = efi_disk_read_blocks(this, media_id, lba,
-			EFI_LOADER_BOUNCE_BUFFER_SIZE, buffer);
+	*size = EFI_LOADER_BOUNCE_BUFFER_SIZE;
+	return efi_bounce_buffer;
+#else
+	static void *bounce;
+
+	if (!bounce)
+		bounce = memalign(ARCH_DMA_MINALIGN, EFI_DISK_BOUNCE_SIZE);
+	*size = EFI_DISK_BOUNCE_SIZE;
+	return bounce;
+#endif
+}
+
+static efi_status_t efi_disk_rw_buffer(struct efi_block_io *this,
+			u32 media_id, u64 lba, unsigned long buffer_size,
+			void *buffer, enum efi_disk_direction direction)
+{
+	unsigned long bounce_size, len;
+	efi_status_t r = EFI_SUCCESS;
+	void *bounce;
+
+	if (efi_disk_can_dma(buffer, buffer_size))
+		return efi_disk_rw_blocks(this, media_id, lba, buffer_size,
+					  buffer, direction);
+
+	bounce = efi_disk_bounce_buffer(&bounce_size);
+	if (!bounce)
+		return EFI_DEVICE_ERROR;
+
+	while (buffer_size) {
+		len = min(buffer_size, bounce_size);
+
+		/* Populate bounce buffer for writes */
+		if (direction == EFI_DISK_WRITE)
+			memcpy(bounce, buffer, len);
+
+		r = efi_disk_rw_blocks(this, media_id, lba, len, bounce,
+				       direction);
 		if (r != EFI_SUCCESS)
-			return r;
-		return efi_disk_read_blocks(this, media_id, lba +
-			EFI_LOADER_BOUNCE_BUFFER_SIZE / this->media->block_size,
-			buffer_size - EFI_LOADER_BOUNCE_BUFFER_SIZE,
-			buffer + EFI_LOADER_BOUNCE_BUFFER_SIZE);
+			break;
+
+		/* Copy from bounce buffer to real buffer for reads */
+		if (direction == EFI_DISK_READ)
+			memcpy(buffer, bounce, len);
+
+		lba += len / this->media->block_size;
+		buffer += len;
+		buffer_size -= len;
 	}
 
-	real_buffer = efi_bounce_buffer;
-#endif
+	return r;
+}
+
+static efi_status_t EFIAPI efi_disk_read_blocks(struct efi_block_io *this,
+			u32 media_id, u64 lba, unsigned long buffer_size,
+			void *buffer)
+{
+	efi_status_t r;
 
 	EFI_ENTRY("%p, %x, %"PRIx64", %lx, %p", this, media_id, lba,
 		  buffer_size, buffer);
 
-	r = efi_disk_rw_blocks(this, media_id, lba, buffer_size, real_buffer,
+	r = efi_disk_rw_buffer(this, media_id, lba, buffer_size, buffer,
 			       EFI_DISK_READ);
 
-	/* Copy from bounce buffer to real buffer if necessary */
-	if ((r == EFI_SUCCESS) && (real_buffer != buffer))
-		memcpy(buffer, real_buffer, buffer_size);
-
 	return EFI_EXIT(r);
 }
 
@@ -127,32 +181,12 @@ static efi_status_t EFIAPI efi_disk_write_blocks(struct efi_block_io *this,
 			u32 media_id, u64 lba, unsigned long buffer_size,
 			void *buffer)
 {
-	void *real_buffer = buffer;
 	efi_status_t r;
 
-#ifdef CONFIG_EFI_LOADER_BOUNCE_BUFFER
-	if (buffer_size > EFI_LOADER_BOUNCE_BUFFER_SIZE) {
-		r = efi_disk_write_blocks(this, media_id, lba,
-			EFI_LOADER_BOUNCE_BUFFER_SIZE, buffer);
-		if (r != EFI_SUCCESS)
-			return r;
-		return efi_disk_write_blocks(this, media_id, lba +
-			EFI_LOADER_BOUNCE_BUFFER_SIZE / this->media->block_size,
-			buffer_size - EFI_LOADER_BOUNCE_BUFFER_SIZE,
-			buffer + EFI_LOADER_BOUNCE_BUFFER_SIZE);
-	}
-
-	real_buffer = efi_bounce_buffer;
-#endif
-
 	EFI_ENTRY("%p, %x, %"PRIx64", %lx, %p", this, media_id, lba,
 		  buffer_size, buffer);
 
-	/* Populate bounce buffer if necessary */
-	if (real_buffer != buffer)
-		memcpy(real_buffer, buffer, buffer_size);
-
-	r = efi_disk_rw_blocks(this, media_id, lba, buffer_size, real_buffer,
+	r = efi_disk_rw_buffer(this, media_id, lba, buffer_size, buffer,
 			       EFI_DISK_WRITE);
 
 	return EFI_EXIT(r);
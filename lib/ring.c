@@ -0,0 +1,132 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <errno.h>
+#include <ring.h>
+#include <linux/log2.h>
+
+#define ring_load_acquire(p)		__atomic_load_n(p, __ATOMIC_ACQUIRE)
+#define ring_load_relaxed(p)		__atomic_load_n(p, __ATOMIC_RELAXED)
+#define ring_store_release(p, v)	__atomic_store_n(p, v, __ATOMIC_RELEASE)
+
+int ring_init(struct ring *r, void *data, u32 count, u32 elem_size,
+	      uint flags)
+{
+	if (!count || !is_power_of_2(count))
+		return -EINVAL;
+
+	memset(r, '\0', sizeof(*r));
+	r->data = data;
+	r->mask = count - 1;
+	r->elem_size = elem_size;
+	r->flags = flags;
+
+	return 0;
+}
+
+/* Limit @n to what is available from index @pos without wrapping */
+static u32 ring_span_fill(struct ring *r, u32 pos, u32 avail, u32 n,
+			  struct ring_span *span)
+{
+	n = min(n, avail);
+	n = min(n, r->mask + 1 - (pos & r->mask));
+
+	span->ptr = r->data + (pos & r->mask) * r->elem_size;
+	span->start = pos;
+	span->count = n;
+
+	return n;
+}
+
+u32 ring_reserve(struct ring *r, u32 n, struct ring_span *span)
+{
+	u32 head, tail;
+
+	head = ring_load_relaxed(&r->prod_head);
+	do {
+		/* Slots the consumer has released are free to overwrite */
+		tail = ring_load_acquire(&r->cons_tail);
+		if (!ring_span_fill(r, head, r->mask + 1 - (head - tail), n,
+				    span))
+			return 0;
+
+		if (!(r->flags & RING_F_MP_PRODUCER)) {
+			r->prod_head = head + span->count;
+			break;
+		}
+	} while (!__atomic_compare_exchange_n(&r->prod_head, &head,
+					      head + span->count, false,
+					      __ATOMIC_RELAXED,
+					      __ATOMIC_RELAXED));
+
+	return span->count;
+}
+
+void ring_commit(struct ring *r, const struct ring_span *span)
+{
+	/* Earlier reservations are published first, so wait for them */
+	if (r->flags & RING_F_MP_PRODUCER) {
+		while (ring_load_acquire(&r->prod_tail) != span->start)
+			;
+	}
+
+	ring_store_release(&r->prod_tail, span->start + span->count);
+}
+
+u32 ring_peek(struct ring *r, u32 n, struct ring_span *span)
+{
+	u32 head, tail;
+
+	tail = r->cons_tail;
+	head = ring_load_acquire(&r->prod_tail);
+
+	return ring_span_fill(r, tail, head - tail, n, span);
+}
+
+void ring_release(struct ring *r, const struct ring_span *span)
+{
+	ring_store_release(&r->cons_tail, span->start + span->count);
+}
+
+u32 ring_enqueue(struct ring *r, const void *elems, u32 n)
+{
+	struct ring_span span;
+	const char *src = elems;
+	u32 done = 0;
+
+	/* The free space may wrap, so this usually takes two goes */
+	while (done < n && ring_reserve(r, n - done, &span)) {
+		memcpy(span.ptr, src, span.count * r->elem_size);
+		ring_commit(r, &span);
+		src += span.count * r->elem_size;
+		done += span.count;
+	}
+
+	return done;
+}
+
+u32 ring_dequeue(struct ring *r, void *elems, u32 n)
+{
+	struct ring_span span;
+	char *dst = elems;
+	u32 done = 0;
+
+	while (done < n && ring_peek(r, n - done, &span)) {
+		memcpy(dst, span.ptr, span.count * r->elem_size);
+		ring_release(r, &span);
+		dst += span.count * r->elem_size;
+		done += span.count;
+	}
+
+	return done;
+}
+
+u32 ring_count(struct ring *r)
+{
+	return ring_load_acquire(&r->prod_tail) -
+		ring_load_acquire(&r->cons_tail);
+}
@@ -14,6 +14,10 @@ static const char test_cmd[] = "setenv list 1\n setenv list ${list}2; "
 
 static int do_ut_cmd(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
 {
+	cmd_tbl_t *start, *cmd;
+	ulong start_time;
+	int count, i;
+
 	printf("%s: Testing commands\n", __func__);
 	run_command("env default -f -a", 0);
 
@@ -57,6 +61,25 @@ static int do_ut_cmd(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
 
 	assert(run_command("'", 0) == 1);
 
+	/* command lookup must agree with a plain scan of the table */
+	start = ll_entry_start(cmd_tbl_t, cmd);
+	count = ll_entry_count(cmd_tbl_t, cmd);
+	for (cmd = start; cmd != start + count; cmd++)
+		assert(find_cmd(cmd->name) ==
+		       find_cmd_tbl(cmd->name, start, count));
+	assert(find_cmd("echo") != NULL);
+	assert(find_cmd("ech") == find_cmd("echo"));
+	assert(find_cmd("echo.b") == find_cmd("echo"));
+	assert(find_cmd("e") == NULL);
+	assert(find_cmd("no_such_command") == NULL);
+
+	/* time a long script, dominated by command lookup */
+	start_time = get_timer(0);
+	for (i = 0; i < 1000; i++)
+		run_command_list("true; true; true; true; true", -1, 0);
+	printf("%s: 5000 commands in %lu ms\n", __func__,
+	       get_timer(start_time));
+
 	printf("%s: Everything went swimmingly\n", __func__);
 	return 0;
 }
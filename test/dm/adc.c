@@ -18,6 +18,7 @@
 #include <power/regulator.h>
 #include <power/sandbox_pmic.h>
 #include <sandbox-adc.h>
+#include <asm/test.h>
 #include <test/ut.h>
 
 DECLARE_GLOBAL_DATA_PTR;
@@ -163,3 +164,37 @@ static int dm_test_adc_multi_channel_shot(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_adc_multi_channel_shot, DM_TESTF_SCAN_FDT);
+
+static int dm_test_adc_channels_average(struct unit_test_state *uts)
+{
+	struct adc_channel channels[SANDBOX_ADC_CHANNELS];
+	struct adc_channel *tdata = adc_channel_test_data;
+	unsigned int i, channel_mask, starts;
+	struct udevice *dev;
+
+	/* Channel 0 reads 0, which the noise would not average out */
+	channel_mask = ADC_CHANNEL(1) | ADC_CHANNEL(2) | ADC_CHANNEL(3);
+
+	ut_assertok(uclass_get_device_by_name(UCLASS_ADC, "adc", &dev));
+	sandbox_adc_set_noise(dev, 0x10);
+
+	/* A single sample is off by the noise */
+	ut_assertok(adc_channels_average(dev, channel_mask, 1, channels));
+	ut_assert(channels[0].data != tdata[1].data);
+
+	/* Each sample converts all the channels in one go */
+	starts = sandbox_adc_get_starts(dev);
+	ut_assertok(adc_channels_average(dev, channel_mask, 4, channels));
+	ut_asserteq(starts + 4, sandbox_adc_get_starts(dev));
+	for (i = 0; i < 3; i++) {
+		ut_asserteq(tdata[i + 1].id, channels[i].id);
+		ut_asserteq(tdata[i + 1].data, channels[i].data);
+	}
+
+	ut_asserteq(-EINVAL, adc_channels_average(dev, channel_mask, 0,
+						  channels));
+	sandbox_adc_set_noise(dev, 0);
+
+	return 0;
+}
+DM_TEST(dm_test_adc_channels_average, DM_TESTF_SCAN_FDT);
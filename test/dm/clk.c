@@ -5,6 +5,7 @@
  */
 
 #include <common.h>
+#include <clk.h>
 #include <dm.h>
 #include <asm/clk.h>
 #include <dm/test.h>
@@ -139,3 +140,40 @@ static int dm_test_clk_bulk(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_clk_bulk, DM_TESTF_SCAN_FDT);
+
+/* Test that assigned rates are set in bulk and rates are cached */
+static int dm_test_clk_cru(struct unit_test_state *uts)
+{
+	struct udevice *dev;
+	struct clk pll0, div0;
+
+	ut_assertok(uclass_get_device_by_name(UCLASS_CLK, "clk-cru", &dev));
+
+	/*
+	 * PLL0 is assigned twice and only its last rate is used. Both PLLs
+	 * are programmed before a single lock wait, then DIV0 is set.
+	 */
+	ut_asserteq(2, sandbox_clk_cru_pll_program_count(dev));
+	ut_asserteq(1, sandbox_clk_cru_lock_wait_count(dev));
+
+	pll0.dev = dev;
+	pll0.id = SANDBOX_CLK_CRU_ID_PLL0;
+	div0.dev = dev;
+	div0.id = SANDBOX_CLK_CRU_ID_DIV0;
+
+	sandbox_clk_cru_reset_counts(dev);
+	ut_asserteq(100000000, clk_get_rate(&div0));
+	ut_asserteq(100000000, clk_get_rate(&div0));
+	ut_asserteq(1, sandbox_clk_cru_get_rate_count(dev));
+	ut_asserteq(1200000000, clk_get_rate(&pll0));
+	ut_asserteq(2, sandbox_clk_cru_get_rate_count(dev));
+
+	/* Changing a PLL drops the cached rate of its divider */
+	ut_asserteq(600000000, clk_set_rate(&pll0, 600000000));
+	ut_asserteq(1, sandbox_clk_cru_lock_wait_count(dev));
+	ut_asserteq(50000000, clk_get_rate(&div0));
+	ut_asserteq(3, sandbox_clk_cru_get_rate_count(dev));
+
+	return 0;
+}
+DM_TEST(dm_test_clk_cru, DM_TESTF_SCAN_FDT);
@@ -250,3 +250,44 @@ static int dm_test_gpio_phandles(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_gpio_phandles, DM_TESTF_SCAN_PDATA | DM_TESTF_SCAN_FDT);
+
+/* Test that GPIO lists are read and written with one access per bank */
+static int dm_test_gpio_bulk(struct unit_test_state *uts)
+{
+	struct udevice *dev, *gpio_a, *gpio_b;
+	struct gpio_desc desc_list[3];
+	uint reads_a, reads_b;
+	ulong values;
+
+	ut_assertok(uclass_get_device(UCLASS_TEST_FDT, 0, &dev));
+	ut_assertok(uclass_get_device(UCLASS_GPIO, 1, &gpio_a));
+	ut_assertok(uclass_get_device(UCLASS_GPIO, 2, &gpio_b));
+
+	/* a1, a4 and b5 */
+	ut_asserteq(3, gpio_request_list_by_name(dev, "test-gpios", desc_list,
+						 ARRAY_SIZE(desc_list), 0));
+	sandbox_gpio_set_value(gpio_a, 1, 1);
+	sandbox_gpio_set_value(gpio_a, 4, 0);
+	sandbox_gpio_set_value(gpio_b, 5, 1);
+
+	reads_a = sandbox_gpio_get_read_count(gpio_a);
+	reads_b = sandbox_gpio_get_read_count(gpio_b);
+	ut_assertok(dm_gpio_get_values(desc_list, 3, &values));
+	ut_asserteq(0x5, values);
+	ut_asserteq(5, dm_gpio_get_values_as_int(desc_list, 3));
+	ut_asserteq(reads_a + 2, sandbox_gpio_get_read_count(gpio_a));
+	ut_asserteq(reads_b + 2, sandbox_gpio_get_read_count(gpio_b));
+	ut_assertok(gpio_free_list(dev, desc_list, 3));
+
+	ut_asserteq(3, gpio_request_list_by_name(dev, "test-gpios", desc_list,
+						 ARRAY_SIZE(desc_list),
+						 GPIOD_IS_OUT));
+	ut_assertok(dm_gpio_set_values(desc_list, 3, 0x2));
+	ut_asserteq(0, sandbox_gpio_get_value(gpio_a, 1));
+	ut_asserteq(1, sandbox_gpio_get_value(gpio_a, 4));
+	ut_asserteq(0, sandbox_gpio_get_value(gpio_b, 5));
+	ut_assertok(gpio_free_list(dev, desc_list, 3));
+
+	return 0;
+}
+DM_TEST(dm_test_gpio_bulk, DM_TESTF_SCAN_PDATA | DM_TESTF_SCAN_FDT);
@@ -0,0 +1,78 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <dm.h>
+#include <mapmem.h>
+#include <dm/pinctrl.h>
+#include <dm/test.h>
+#include <test/ut.h>
+
+#define RK_GRF_REGS		(0x40 / 4)
+#define RK_PMUGRF_REGS		(0x30 / 4)
+
+/* Clear the GRF and PMUGRF, leaving other pins set in the gpio0 iomux */
+static void rk_pinctrl_reset_regs(u32 *grf, u32 *pmugrf)
+{
+	memset(grf, '\0', RK_GRF_REGS * 4);
+	memset(pmugrf, '\0', RK_PMUGRF_REGS * 4);
+	pmugrf[0] = 0xff0000f3;
+}
+
+/* Test that a compiled Rockchip pin state gives the expected registers */
+static int dm_test_pinctrl_rockchip_state(struct unit_test_state *uts)
+{
+	u32 grf_image[RK_GRF_REGS], pmugrf_image[RK_PMUGRF_REGS];
+	struct udevice *dev, *config;
+	const struct pinctrl_ops *ops;
+	u32 *grf, *pmugrf;
+
+	ut_assertok(uclass_get_device_by_name(UCLASS_PINCTRL,
+					      "pinctrl-rockchip@3000", &dev));
+	ut_assertok(uclass_get_device_by_name(UCLASS_PINCONFIG, "rk-uart",
+					      &config));
+	ops = pinctrl_get_ops(dev);
+
+	grf = map_sysmem(dev_read_addr_index(dev, 0), RK_GRF_REGS * 4);
+	pmugrf = map_sysmem(dev_read_addr_index(dev, 1), RK_PMUGRF_REGS * 4);
+	rk_pinctrl_reset_regs(grf, pmugrf);
+
+	ut_assertok(ops->set_state(dev, config));
+
+	/*
+	 * gpio0 has no write enables, so the registers hold the real bits:
+	 * A2/A3 get mux 1 and pull-up, other pins keep their settings.
+	 */
+	ut_asserteq(0xff000053, pmugrf[0]);
+	ut_asserteq(0x50, pmugrf[0x10 / 4]);
+	ut_asserteq(0, pmugrf[0x20 / 4]);
+
+	/*
+	 * gpio1 registers hold the last value written. A0/A1 share their
+	 * iomux, pull and drive registers, so seeing both pins' write enables
+	 * means their writes were merged.
+	 */
+	ut_asserteq(0x00ff0032, grf[0x00 / 4]);
+	ut_asserteq(0x00f00050, grf[0x08 / 4]);
+	ut_asserteq(0x000f0000, grf[0x20 / 4]);
+	ut_asserteq(0x000c0004, grf[0x24 / 4]);
+	ut_asserteq(0x000f000a, grf[0x30 / 4]);
+
+	/* Selecting the state again replays the same writes */
+	memcpy(grf_image, grf, sizeof(grf_image));
+	memcpy(pmugrf_image, pmugrf, sizeof(pmugrf_image));
+	rk_pinctrl_reset_regs(grf, pmugrf);
+
+	ut_assertok(ops->set_state(dev, config));
+	ut_assertok(memcmp(grf_image, grf, sizeof(grf_image)));
+	ut_assertok(memcmp(pmugrf_image, pmugrf, sizeof(pmugrf_image)));
+
+	unmap_sysmem(grf);
+	unmap_sysmem(pmugrf);
+
+	return 0;
+}
+DM_TEST(dm_test_pinctrl_rockchip_state, DM_TESTF_SCAN_FDT);
@@ -19,6 +19,7 @@
 #include <dm/uclass-internal.h>
 #include <power/pmic.h>
 #include <power/sandbox_pmic.h>
+#include <asm/test.h>
 #include <test/ut.h>
 
 DECLARE_GLOBAL_DATA_PTR;
@@ -67,3 +68,71 @@ static int dm_test_power_pmic_io(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_power_pmic_io, DM_TESTF_SCAN_FDT);
+
+/* Test the PMIC register cache */
+static int dm_test_power_pmic_cache(struct unit_test_state *uts)
+{
+	const uint status_reg = SANDBOX_PMIC_REG_COUNT - 1;
+	uint8_t out[OUT_REG_COUNT] = { 0x11, 0x22, 0x33 };
+	uint8_t in[OUT_REG_COUNT];
+	struct udevice *dev, *emul;
+	int val;
+
+	ut_assertok(pmic_get("sandbox_pmic", &dev));
+	ut_assertok(uclass_get_device_by_name(UCLASS_I2C_EMUL, "pmic_emul",
+					      &emul));
+
+	/* Only the first read of a plain register goes to the bus */
+	val = pmic_reg_read(dev, SANDBOX_PMIC_REG_BUCK1_UV);
+	ut_assert(val >= 0);
+	sandbox_i2c_pmic_xfer_count(emul, true);
+	ut_asserteq(val, pmic_reg_read(dev, SANDBOX_PMIC_REG_BUCK1_UV));
+	ut_asserteq(0, sandbox_i2c_pmic_xfer_count(emul, false));
+
+	/* Volatile registers are always read */
+	ut_assert(pmic_reg_read(dev, status_reg) >= 0);
+	ut_assert(pmic_reg_read(dev, status_reg) >= 0);
+	ut_asserteq(2, sandbox_i2c_pmic_xfer_count(emul, true));
+
+	/* clrsetbits costs one write, or nothing if the value is unchanged */
+	ut_assertok(pmic_clrsetbits(dev, SANDBOX_PMIC_REG_BUCK1_UV, 0, val));
+	ut_asserteq(0, sandbox_i2c_pmic_xfer_count(emul, true));
+	ut_assertok(pmic_clrsetbits(dev, SANDBOX_PMIC_REG_BUCK1_UV, 0xff, 1));
+	ut_asserteq(1, sandbox_i2c_pmic_xfer_count(emul, true));
+	ut_asserteq(1, pmic_reg_read(dev, SANDBOX_PMIC_REG_BUCK1_UV));
+	ut_asserteq(0, sandbox_i2c_pmic_xfer_count(emul, false));
+
+	/* Deferred writes to consecutive registers become one burst */
+	pmic_cache_defer(dev);
+	ut_assertok(pmic_reg_write(dev, SANDBOX_PMIC_REG_BUCK2_UV, out[0]));
+	ut_assertok(pmic_reg_write(dev, SANDBOX_PMIC_REG_BUCK2_UA, out[1]));
+	ut_assertok(pmic_reg_write(dev, SANDBOX_PMIC_REG_BUCK2_OM, out[2]));
+	ut_asserteq(0, sandbox_i2c_pmic_xfer_count(emul, false));
+	ut_assertok(pmic_read(dev, SANDBOX_PMIC_REG_BUCK2_UV, in, sizeof(in)));
+	ut_assertok(memcmp(out, in, sizeof(in)));
+	ut_asserteq(0, sandbox_i2c_pmic_xfer_count(emul, false));
+	ut_assertok(pmic_cache_sync(dev));
+	ut_asserteq(1, sandbox_i2c_pmic_xfer_count(emul, true));
+
+	/* The device got them all, check behind the cache's back */
+	ut_assertok(dm_i2c_read(dev, SANDBOX_PMIC_REG_BUCK2_UV, in,
+				sizeof(in)));
+	ut_assertok(memcmp(out, in, sizeof(in)));
+	sandbox_i2c_pmic_xfer_count(emul, true);
+
+	/* A gap or a volatile access sends what is held back first */
+	pmic_cache_defer(dev);
+	ut_assertok(pmic_reg_write(dev, SANDBOX_PMIC_REG_BUCK1_UV, 2));
+	ut_assertok(pmic_reg_write(dev, SANDBOX_PMIC_REG_LDO1_UV, 3));
+	ut_asserteq(1, sandbox_i2c_pmic_xfer_count(emul, false));
+	ut_assertok(pmic_reg_write(dev, status_reg, 4));
+	ut_asserteq(3, sandbox_i2c_pmic_xfer_count(emul, false));
+	ut_assertok(pmic_cache_sync(dev));
+	ut_asserteq(3, sandbox_i2c_pmic_xfer_count(emul, true));
+
+	ut_assertok(dm_i2c_read(dev, SANDBOX_PMIC_REG_LDO1_UV, in, 1));
+	ut_asserteq(3, in[0]);
+
+	return 0;
+}
+DM_TEST(dm_test_power_pmic_cache, DM_TESTF_SCAN_FDT);
@@ -325,3 +325,37 @@ static int dm_test_power_regulator_autoset_list(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_power_regulator_autoset_list, DM_TESTF_SCAN_FDT);
+
+/* Test that batched regulator changes wait once, for the longest ramp */
+static int dm_test_power_regulator_ramp_batch(struct unit_test_state *uts)
+{
+	struct udevice *buck1, *ldo1;
+
+	ut_assertok(regulator_get_by_platname(regulator_names[BUCK1][PLATNAME],
+					      &buck1));
+	ut_assertok(regulator_get_by_platname(regulator_names[LDO1][PLATNAME],
+					      &ldo1));
+
+	/*
+	 * BUCK1: 1.0V -> 1.2V at 12500 uV/us = 16 us
+	 * LDO1:  1.6V -> 1.8V at 10000 uV/us = 20 us
+	 */
+	regulator_ramp_batch_begin();
+	ut_assertok(regulator_set_value(buck1,
+					SANDBOX_BUCK1_AUTOSET_EXPECTED_UV));
+	ut_assertok(regulator_set_value(ldo1,
+					SANDBOX_LDO1_AUTOSET_EXPECTED_UV));
+	ut_asserteq(20, regulator_ramp_batch_end());
+
+	ut_asserteq(SANDBOX_BUCK1_AUTOSET_EXPECTED_UV,
+		    regulator_get_value(buck1));
+	ut_asserteq(SANDBOX_LDO1_AUTOSET_EXPECTED_UV,
+		    regulator_get_value(ldo1));
+
+	/* Nothing is left over for the next batch */
+	regulator_ramp_batch_begin();
+	ut_asserteq(0, regulator_ramp_batch_end());
+
+	return 0;
+}
+DM_TEST(dm_test_power_regulator_ramp_batch, DM_TESTF_SCAN_FDT);
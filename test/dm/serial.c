@@ -0,0 +1,37 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <dm.h>
+#include <serial.h>
+#include <asm/test.h>
+#include <dm/test.h>
+#include <test/ut.h>
+
+/* Test that strings reach the driver in FIFO loads, not per character */
+static int dm_test_serial_puts(struct unit_test_state *uts)
+{
+	uint reads, writes, base_reads, base_writes;
+	struct udevice *dev;
+
+	ut_assertok(uclass_get_device_by_name(UCLASS_SERIAL, "serial", &dev));
+	sandbox_serial_get_access_counts(dev, &base_reads, &base_writes);
+
+	/* 20 characters take two FIFO loads, then one for "\r\n" */
+	serial_dev_puts(dev, "0123456789abcdefghij\n");
+	sandbox_serial_get_access_counts(dev, &reads, &writes);
+	ut_asserteq(3, reads - base_reads);
+	ut_asserteq(22, writes - base_writes);
+
+	/* Single characters still go through putc() */
+	serial_dev_putc(dev, '\n');
+	sandbox_serial_get_access_counts(dev, &reads, &writes);
+	ut_asserteq(5, reads - base_reads);
+	ut_asserteq(24, writes - base_writes);
+
+	return 0;
+}
+DM_TEST(dm_test_serial_puts, DM_TESTF_SCAN_FDT);
@@ -6,6 +6,7 @@
 
 #include <common.h>
 #include <dm.h>
+#include <watchdog.h>
 #include <wdt.h>
 #include <asm/state.h>
 #include <asm/test.h>
@@ -39,3 +40,35 @@ static int dm_test_wdt_base(struct unit_test_state *uts)
 	return 0;
 }
 DM_TEST(dm_test_wdt_base, DM_TESTF_SCAN_PDATA | DM_TESTF_SCAN_FDT);
+
+/* Test that progress reports kick a running watchdog at a limited rate */
+static int dm_test_wdt_progress(struct unit_test_state *uts)
+{
+	struct sandbox_state *state = state_get_current();
+	struct udevice *dev;
+	uint reset_count;
+	int i;
+
+	ut_assertok(uclass_get_device(UCLASS_WDT, 0, &dev));
+
+	/* Kicks are limited to half the timeout: every 10ms */
+	ut_assertok(wdt_start(dev, 20, 0));
+	reset_count = state->wdt.reset_count;
+	for (i = 0; i < 1000; i++)
+		watchdog_progress();
+	ut_asserteq(reset_count, state->wdt.reset_count);
+
+	sandbox_timer_add_offset(10);
+	for (i = 0; i < 1000; i++)
+		watchdog_progress();
+	ut_asserteq(reset_count + 1, state->wdt.reset_count);
+
+	/* A stopped watchdog is left alone */
+	ut_assertok(wdt_stop(dev));
+	sandbox_timer_add_offset(10);
+	watchdog_progress();
+	ut_asserteq(reset_count + 1, state->wdt.reset_count);
+
+	return 0;
+}
+DM_TEST(dm_test_wdt_progress, DM_TESTF_SCAN_PDATA | DM_TESTF_SCAN_FDT);
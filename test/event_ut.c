@@ -0,0 +1,151 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <event_loop.h>
+
+struct event_test_work {
+	struct event_work work;
+	struct completion *comp;
+	ulong ran_at;
+	int runs;
+};
+
+static void event_test_func(struct event_work *work)
+{
+	struct event_test_work *tw;
+
+	tw = container_of(work, struct event_test_work, work);
+	tw->ran_at = get_timer(0);
+	tw->runs++;
+	if (tw->comp)
+		complete(tw->comp);
+}
+
+static void event_test_init(struct event_test_work *tw,
+			    struct completion *comp)
+{
+	memset(tw, '\0', sizeof(*tw));
+	event_work_init(&tw->work, event_test_func);
+	tw->comp = comp;
+}
+
+/* Work queued with a delay completes a waiter no sooner than asked */
+static int test_event_completion(void)
+{
+	struct event_test_work tw;
+	struct completion comp;
+	ulong start;
+
+	init_completion(&comp);
+	event_test_init(&tw, &comp);
+
+	start = get_timer(0);
+	event_queue_work(&tw.work, 20);
+	if (wait_for_completion_timeout(&comp, 1000)) {
+		printf("%s: completion was not signalled\n", __func__);
+		return -EINVAL;
+	}
+	if (tw.runs != 1 || tw.ran_at - start < 20) {
+		printf("%s: runs=%d, ran after %lu ms, expected 1 run after 20 ms\n",
+		       __func__, tw.runs, tw.ran_at - start);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* A wait with nothing to complete it times out on time */
+static int test_event_timeout(void)
+{
+	struct completion comp;
+	ulong start, delta;
+	int ret;
+
+	init_completion(&comp);
+	start = get_timer(0);
+	ret = wait_for_completion_timeout(&comp, 50);
+	delta = get_timer(start);
+	if (ret != -ETIMEDOUT || delta < 50 || delta > 150) {
+		printf("%s: ret=%d after %lu ms, expected -ETIMEDOUT after 50 ms\n",
+		       __func__, ret, delta);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Work runs in the order it is due, and cancelled work does not run */
+static int test_event_order(void)
+{
+	struct event_test_work first, second, cancelled;
+
+	event_test_init(&first, NULL);
+	event_test_init(&second, NULL);
+	event_test_init(&cancelled, NULL);
+
+	event_queue_work(&second.work, 20);
+	event_queue_work(&first.work, 10);
+	event_queue_work(&cancelled.work, 5);
+	if (!event_cancel_work(&cancelled.work) ||
+	    event_cancel_work(&cancelled.work)) {
+		printf("%s: cancel did not report the queued state\n",
+		       __func__);
+		return -EINVAL;
+	}
+
+	event_loop_sleep(40);
+	if (first.runs != 1 || second.runs != 1 || cancelled.runs) {
+		printf("%s: runs=%d/%d/%d, expected 1/1/0\n", __func__,
+		       first.runs, second.runs, cancelled.runs);
+		return -EINVAL;
+	}
+	if (first.ran_at > second.ran_at) {
+		printf("%s: work ran out of order\n", __func__);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* A wakeup raised before the idle starts is not lost */
+static int test_event_wakeup(void)
+{
+	struct completion comp;
+	ulong start, delta;
+
+	init_completion(&comp);
+	complete(&comp);
+	start = get_timer(0);
+	if (wait_for_completion_timeout(&comp, 1000)) {
+		printf("%s: completion was not seen\n", __func__);
+		return -EINVAL;
+	}
+	delta = get_timer(start);
+	if (delta > 10) {
+		printf("%s: wait took %lu ms, expected it to return at once\n",
+		       __func__, delta);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+int do_ut_event(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	int ret = 0;
+
+	ret |= test_event_completion();
+	ret |= test_event_timeout();
+	ret |= test_event_order();
+	ret |= test_event_wakeup();
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -6,6 +6,7 @@
 
 import os
 import pytest
+import re
 import u_boot_utils
 import make_test_disk
 
@@ -50,6 +51,40 @@ def test_gpt_rename_partition(u_boot_console):
     output = u_boot_console.run_command('gpt read host 0')
     assert 'name second' in output
 
+def host_reads(u_boot_console):
+    """Return the number of reads made from host device 0 so far."""
+
+    output = u_boot_console.run_command('host stats')
+    m = re.search(r'host0: model \S+\s+reads (\d+),', output)
+    assert m
+    return int(m.group(1))
+
+@pytest.mark.buildconfigspec('cmd_gpt')
+@pytest.mark.buildconfigspec('partition_cache')
+def test_gpt_partition_cache(u_boot_console):
+    """Test that partition lookups do not re-read the GPT."""
+
+    if u_boot_console.config.buildconfig.get('config_cmd_gpt_rename', 'n') != 'y':
+        pytest.skip('gpt rename command not supported')
+    if u_boot_console.config.buildconfig.get('config_cmd_part', 'n') != 'y':
+        pytest.skip('partition cache test needs CMD_PART')
+    u_boot_console.run_command('host bind 0 testdisk.raw')
+    u_boot_console.run_command('part start host 0 1 part1_start')
+    u_boot_console.run_command('host stats reset')
+    for i in range(10):
+        u_boot_console.run_command('part start host 0 1 part1_start')
+        u_boot_console.run_command('part size host 0 2 part2_size')
+    assert host_reads(u_boot_console) == 0
+
+    # Rewriting the table must drop the cache
+    u_boot_console.run_command('gpt rename host 0 1 first')
+    u_boot_console.run_command('host stats reset')
+    u_boot_console.run_command('part start host 0 1 part1_start')
+    assert host_reads(u_boot_console) > 0
+    u_boot_console.run_command('host stats reset')
+    u_boot_console.run_command('part start host 0 1 part1_start')
+    assert host_reads(u_boot_console) == 0
+
 @pytest.mark.buildconfigspec('cmd_gpt')
 def test_gpt_swap_partitions(u_boot_console):
     """Test the gpt swap command to exchange two partition names."""
@@ -0,0 +1,103 @@
+# Copyright (C) 2026 Rockchip Electronics Co., Ltd
+#
+# SPDX-License-Identifier: GPL-2.0
+
+# Test the timing model of sandbox host block devices.
+
+import os
+import pytest
+import u_boot_utils
+
+DISK_SIZE = 1 << 20
+
+@pytest.fixture(scope='function')
+def storage_dev(u_boot_console):
+    """Bind a 1MiB file as host device 0, unbinding it after the test."""
+
+    fn = os.path.join(u_boot_console.config.persistent_data_dir,
+                      'storage_model.img')
+    with open(fn, 'wb') as fh:
+        fh.write(b'\0' * DISK_SIZE)
+    u_boot_console.run_command('host bind 0 %s' % fn)
+    yield u_boot_console
+    u_boot_console.run_command('host bind 0')
+    os.remove(fn)
+
+def get_stats(u_boot_console, name='host0'):
+    """Return the 'host stats' figures of a device as a dict."""
+
+    output = u_boot_console.run_command('host stats')
+    stats = {}
+    found = False
+    for line in output.splitlines():
+        line = line.strip()
+        if ': model ' in line:
+            if found:
+                break
+            found = line.startswith(name + ':')
+            if found:
+                stats['model'] = line.split()[-1]
+        elif found and line.startswith('time '):
+            stats['time'] = int(line.split()[1])
+        elif found and line:
+            op, rest = line.split(' ', 1)
+            count, nbytes = rest.split(', ')
+            stats[op] = int(count)
+            stats[op + '_bytes'] = int(nbytes.split()[0])
+    assert found
+    return stats
+
+def read_disk(u_boot_console, blocks):
+    """Read blocks from the start of host device 0."""
+
+    addr = u_boot_utils.find_ram_base(u_boot_console)
+    u_boot_console.run_command('host stats reset')
+    output = u_boot_console.run_command('read host 0:0 %x 0 %x && echo ok' %
+                                        (addr, blocks))
+    assert output.endswith('ok')
+
+def transfer_us(nbytes, kbps):
+    return (nbytes * 1000000 + kbps * 1024 - 1) // (kbps * 1024)
+
+@pytest.mark.boardspec('sandbox')
+@pytest.mark.buildconfigspec('cmd_read')
+def test_storage_model_none(storage_dev):
+    """Requests are counted but take no time without a model."""
+
+    read_disk(storage_dev, 8)
+    stats = get_stats(storage_dev)
+    assert stats['model'] == 'none'
+    assert stats['reads'] == 1
+    assert stats['reads_bytes'] == 4096
+    assert stats['writes'] == 0
+    assert stats['time'] == 0
+
+@pytest.mark.boardspec('sandbox')
+@pytest.mark.buildconfigspec('cmd_read')
+def test_storage_model_emmc(storage_dev):
+    """One large eMMC read costs one command plus the transfer."""
+
+    storage_dev.run_command('host model 0 emmc')
+    read_disk(storage_dev, DISK_SIZE // 512)
+    stats = get_stats(storage_dev)
+    assert stats['model'] == 'emmc'
+    assert stats['reads'] == 1
+    assert stats['time'] == 100 + transfer_us(DISK_SIZE, 180 * 1024)
+
+@pytest.mark.boardspec('sandbox')
+@pytest.mark.buildconfigspec('cmd_read')
+def test_storage_model_usb_msc(storage_dev):
+    """USB mass storage splits requests into 240-block commands."""
+
+    storage_dev.run_command('host model 0 usb-msc')
+    read_disk(storage_dev, DISK_SIZE // 512)
+    stats = get_stats(storage_dev)
+    cmds = (DISK_SIZE + 240 * 512 - 1) // (240 * 512)
+    assert stats['time'] == cmds * 1000 + transfer_us(DISK_SIZE, 35 * 1024)
+
+@pytest.mark.boardspec('sandbox')
+def test_storage_model_unknown(storage_dev):
+    """An unknown model is rejected."""
+
+    output = storage_dev.run_command('host model 0 floppy')
+    assert "Unknown model 'floppy'" in output
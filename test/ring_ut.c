@@ -0,0 +1,215 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ */
+
+#include <common.h>
+#include <command.h>
+#include <errno.h>
+#include <os.h>
+#include <ring.h>
+
+#define RING_TEST_SLOTS		64
+#define RING_TEST_ITEMS		200000
+#define RING_TEST_PRODUCERS	3
+
+struct ring_test_elem {
+	u32 producer;
+	u32 seq;
+};
+
+struct ring_test_producer {
+	struct ring *r;
+	u32 id;
+};
+
+/* Wrapping, partial reservations and the full and empty cases */
+static int test_ring_basic(void)
+{
+	u32 data[8], buf[8], i;
+	struct ring_span span;
+	struct ring r;
+
+	if (ring_init(&r, data, 6, sizeof(u32), 0) != -EINVAL) {
+		printf("%s: accepted a count that is not a power of two\n",
+		       __func__);
+		return -EINVAL;
+	}
+	ring_init(&r, data, ARRAY_SIZE(data), sizeof(u32), 0);
+
+	for (i = 0; i < 6; i++)
+		buf[i] = i;
+	if (ring_enqueue(&r, buf, 6) != 6 || ring_dequeue(&r, buf, 4) != 4 ||
+	    buf[3] != 3) {
+		printf("%s: simple enqueue/dequeue failed\n", __func__);
+		return -EINVAL;
+	}
+
+	/* Six slots are free, but only two before the end of the storage */
+	if (ring_reserve(&r, 6, &span) != 2 || span.ptr != &data[6]) {
+		printf("%s: reserve did not stop at the wrap\n", __func__);
+		return -EINVAL;
+	}
+	ring_commit(&r, &span);
+	if (ring_reserve(&r, 6, &span) != 4 || span.ptr != &data[0]) {
+		printf("%s: reserve did not continue after the wrap\n",
+		       __func__);
+		return -EINVAL;
+	}
+	ring_commit(&r, &span);
+
+	if (ring_count(&r) != 8 || ring_reserve(&r, 1, &span)) {
+		printf("%s: ring should be full\n", __func__);
+		return -EINVAL;
+	}
+
+	/* Releasing part of a peeked span frees exactly that part */
+	if (ring_peek(&r, 8, &span) != 4) {
+		printf("%s: peek did not stop at the wrap\n", __func__);
+		return -EINVAL;
+	}
+	span.count = 1;
+	ring_release(&r, &span);
+	if (ring_count(&r) != 7 || ring_dequeue(&r, buf, 8) != 7) {
+		printf("%s: partial release failed\n", __func__);
+		return -EINVAL;
+	}
+	if (ring_count(&r) || ring_peek(&r, 1, &span)) {
+		printf("%s: ring should be empty\n", __func__);
+		return -EINVAL;
+	}
+
+	return 0;
+}
+
+/* Fill the ring in batches of reserved slots, from a host thread */
+static void ring_test_spsc_producer(void *arg)
+{
+	struct ring *r = arg;
+	struct ring_span span;
+	u32 seq = 0, i, *slot;
+
+	while (seq < RING_TEST_ITEMS) {
+		if (!ring_reserve(r, min(RING_TEST_ITEMS - seq, 16U), &span)) {
+			os_thread_yield();
+			continue;
+		}
+
+		slot = span.ptr;
+		for (i = 0; i < span.count; i++)
+			slot[i] = seq++;
+		ring_commit(r, &span);
+	}
+}
+
+/* One producer thread, consumer on this one: nothing lost or reordered */
+static int test_ring_spsc(void)
+{
+	u32 data[RING_TEST_SLOTS], count = 0, i, *slot;
+	struct ring_span span;
+	struct ring r;
+	void *thread;
+	int ret = 0;
+
+	ring_init(&r, data, ARRAY_SIZE(data), sizeof(u32), 0);
+	if (os_thread_create(ring_test_spsc_producer, &r, &thread)) {
+		printf("%s: cannot start producer\n", __func__);
+		return -EINVAL;
+	}
+
+	/* Keep draining after an error so that the producer can finish */
+	while (count < RING_TEST_ITEMS) {
+		if (!ring_peek(&r, RING_TEST_SLOTS, &span)) {
+			os_thread_yield();
+			continue;
+		}
+
+		slot = span.ptr;
+		for (i = 0; i < span.count; i++, count++) {
+			if (slot[i] != count && !ret) {
+				printf("%s: got %u at item %u\n", __func__,
+				       slot[i], count);
+				ret = -EINVAL;
+			}
+		}
+		ring_release(&r, &span);
+	}
+	os_thread_join(thread);
+
+	return ret;
+}
+
+static void ring_test_mpsc_producer(void *arg)
+{
+	struct ring_test_producer *prod = arg;
+	struct ring_test_elem elem;
+
+	elem.producer = prod->id;
+	for (elem.seq = 0; elem.seq < RING_TEST_ITEMS; elem.seq++) {
+		while (!ring_enqueue(prod->r, &elem, 1))
+			os_thread_yield();
+	}
+}
+
+/* Several producer threads: each one's elements arrive once and in order */
+static int test_ring_mpsc(void)
+{
+	struct ring_test_producer prod[RING_TEST_PRODUCERS];
+	struct ring_test_elem data[RING_TEST_SLOTS], elem;
+	u32 next[RING_TEST_PRODUCERS] = { 0 };
+	void *thread[RING_TEST_PRODUCERS];
+	u32 total = 0;
+	struct ring r;
+	int i, started, ret = 0;
+
+	ring_init(&r, data, ARRAY_SIZE(data), sizeof(elem),
+		  RING_F_MP_PRODUCER);
+	for (started = 0; started < RING_TEST_PRODUCERS; started++) {
+		prod[started].r = &r;
+		prod[started].id = started;
+		if (os_thread_create(ring_test_mpsc_producer, &prod[started],
+				     &thread[started])) {
+			printf("%s: cannot start producer %d\n", __func__,
+			       started);
+			ret = -EINVAL;
+			break;
+		}
+	}
+
+	/* Keep draining after an error so that the producers can finish */
+	while (total < started * RING_TEST_ITEMS) {
+		if (!ring_dequeue(&r, &elem, 1)) {
+			os_thread_yield();
+			continue;
+		}
+
+		total++;
+		if (elem.producer >= RING_TEST_PRODUCERS ||
+		    elem.seq != next[elem.producer]) {
+			if (!ret)
+				printf("%s: got item %u from producer %u\n",
+				       __func__, elem.seq, elem.producer);
+			ret = -EINVAL;
+			continue;
+		}
+		next[elem.producer]++;
+	}
+	for (i = 0; i < started; i++)
+		os_thread_join(thread[i]);
+
+	return ret;
+}
+
+int do_ut_ring(cmd_tbl_t *cmdtp, int flag, int argc, char * const argv[])
+{
+	int ret = 0;
+
+	ret |= test_ring_basic();
+	ret |= test_ring_spsc();
+	ret |= test_ring_mpsc();
+
+	printf("Test %s\n", ret ? "failed" : "passed");
+
+	return ret ? CMD_RET_FAILURE : CMD_RET_SUCCESS;
+}
@@ -0,0 +1,1321 @@
+/*
+ * (C) Copyright 2026 Rockchip Electronics Co., Ltd
+ *
+ * SPDX-License-Identifier:	GPL-2.0+
+ *
+ * Native implementation of the dtoc platform-data generator.
+ *
+ * This produces the same dt-structs-gen.h and dt-platdata.c output as
+ * tools/dtoc/dtoc, but without the Python start-up and tree-building cost.
+ * When writing to a file, a SHA256 of the input DTB (plus the options used)
+ * is kept in a stamp file next to the output so that unchanged DTBs do not
+ * cause the output to be regenerated, and the output file is only rewritten
+ * if its contents actually change. This keeps incremental builds from
+ * recompiling dt-platdata.c every time dts/dt.dtb is rebuilt.
+ */
+
+#include <errno.h>
+#include <getopt.h>
+#include <stdarg.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/stat.h>
+
+#include "fdt_host.h"
+#include <u-boot/sha256.h>
+
+#define STRUCT_PREFIX	"dtd_"
+#define VAL_PREFIX	"dtv_"
+
+#define ARRAY_SIZE(x)		(sizeof(x) / sizeof((x)[0]))
+
+/* Property types, in the same order as fdt.py (lower is less specific) */
+enum {
+	TYPE_BYTE,
+	TYPE_INT,
+	TYPE_STRING,
+	TYPE_BOOL,
+	TYPE_INT64,
+};
+
+static const char *const type_names[] = {
+	[TYPE_BYTE]	= "unsigned char",
+	[TYPE_INT]	= "fdt32_t",
+	[TYPE_STRING]	= "const char *",
+	[TYPE_BOOL]	= "bool",
+	[TYPE_INT64]	= "fdt64_t",
+};
+
+/* Properties which never produce a structure member */
+static const char *const prop_ignore_list[] = {
+	"#address-cells",
+	"#gpio-cells",
+	"#size-cells",
+	"compatible",
+	"linux,phandle",
+	"status",
+	"phandle",
+	"u-boot,dm-pre-reloc",
+	"u-boot,dm-tpl",
+	"u-boot,dm-spl",
+};
+
+/**
+ * struct dtoc_val - a single value within a property
+ *
+ * @data: Raw bytes of the value (not nul-terminated), or NULL for values
+ *	which only have a numeric form (64-bit 'reg' cells and padding)
+ * @len: Number of bytes in @data
+ * @val64: Numeric value, used for TYPE_INT64 and TYPE_BOOL
+ */
+struct dtoc_val {
+	const char *data;
+	int len;
+	uint64_t val64;
+};
+
+/**
+ * struct dtoc_prop - a property, as seen by dtoc
+ *
+ * @name: Property name
+ * @type: Property type (TYPE_...)
+ * @is_list: true if the value is a list, false if it is a single value
+ * @count: Number of values (1 if !is_list)
+ * @vals: Values
+ */
+struct dtoc_prop {
+	const char *name;
+	int type;
+	bool is_list;
+	int count;
+	struct dtoc_val *vals;
+};
+
+/**
+ * struct dtoc_node - a device tree node
+ *
+ * @name: Node name
+ * @parent: Parent node, or NULL for the root
+ * @props: Properties, in device tree order
+ * @num_props: Number of properties
+ * @order: Order in which to output properties (indexes into @props)
+ * @deps: Nodes whose platdata this node refers to via phandles
+ * @num_deps: Number of entries in @deps
+ * @output: true once the node has been written to dt-platdata.c
+ */
+struct dtoc_node {
+	const char *name;
+	struct dtoc_node *parent;
+	struct dtoc_prop *props;
+	int num_props;
+	int *order;
+	struct dtoc_node **deps;
+	int num_deps;
+	bool output;
+};
+
+/* A C structure, one for each distinct first compatible string */
+struct dtoc_struct {
+	char *name;
+	struct dtoc_prop *fields;
+	int num_fields;
+};
+
+struct phandle_map {
+	uint32_t phandle;
+	struct dtoc_node *node;
+};
+
+/* Information about a property which contains phandles */
+struct phandle_info {
+	int max_args;
+	int num_args;
+	int *args;
+};
+
+/* Output buffer, so that the output file is only written if it changed */
+struct outbuf {
+	char *buf;
+	size_t len;
+	size_t size;
+};
+
+struct dtoc {
+	const char *blob;
+	bool include_disabled;
+	struct dtoc_node **valid;
+	int num_valid;
+	struct phandle_map *phandles;
+	int num_phandles;
+	struct dtoc_struct *structs;
+	int num_structs;
+	char **alias_keys;
+	char **alias_vals;
+	int num_aliases;
+	struct outbuf out;
+};
+
+static void __attribute__((noreturn, format(printf, 1, 2)))
+fail(const char *fmt, ...)
+{
+	va_list args;
+
+	va_start(args, fmt);
+	fprintf(stderr, "dtoc: ");
+	vfprintf(stderr, fmt, args);
+	fprintf(stderr, "\n");
+	va_end(args);
+	exit(EXIT_FAILURE);
+}
+
+static void *xrealloc(void *ptr, size_t size)
+{
+	ptr = realloc(ptr, size);
+	if (!ptr && size)
+		fail("Out of memory");
+
+	return ptr;
+}
+
+static char *xstrdup(const char *str)
+{
+	char *new = strdup(str);
+
+	if (!new)
+		fail("Out of memory");
+
+	return new;
+}
+
+static void __attribute__((format(printf, 2, 3)))
+out(struct dtoc *dtoc, const char *fmt, ...)
+{
+	struct outbuf *ob = &dtoc->out;
+	va_list args;
+	int len;
+
+	for (;;) {
+		va_start(args, fmt);
+		len = vsnprintf(ob->buf + ob->len, ob->size - ob->len, fmt,
+				args);
+		va_end(args);
+		if (len < 0)
+			fail("Output error");
+		if (ob->len + len < ob->size)
+			break;
+		ob->size = (ob->size + len + 1) * 2;
+		ob->buf = xrealloc(ob->buf, ob->size);
+	}
+	ob->len += len;
+}
+
+/* Output a value in the same format as Python's '%#x' */
+static void out_hex(struct dtoc *dtoc, uint64_t val)
+{
+	out(dtoc, "0x%llx", (unsigned long long)val);
+}
+
+/**
+ * out_tab_to() - Output a string padded with tabs to reach a tab stop
+ *
+ * If the string already extends past that tab stop then a single space is
+ * appended instead.
+ *
+ * @num_tabs: Tab stop to reach (0 = column 0, 1 = column 8, etc.)
+ * @str: String to output
+ */
+static void out_tab_to(struct dtoc *dtoc, int num_tabs, const char *str)
+{
+	int len = strlen(str);
+
+	out(dtoc, "%s", str);
+	if (len >= num_tabs * 8) {
+		out(dtoc, " ");
+		return;
+	}
+	for (len /= 8; len < num_tabs; len++)
+		out(dtoc, "\t");
+}
+
+/* Convert a device-tree name to a C identifier (caller must free) */
+static char *conv_name_to_c(const char *name)
+{
+	char *new = xrealloc(NULL, strlen(name) * 4 + 1);
+	char *p = new;
+
+	for (; *name; name++) {
+		switch (*name) {
+		case '@':
+			strcpy(p, "_at_");
+			p += 4;
+			break;
+		case '-':
+		case ',':
+		case '.':
+			*p++ = '_';
+			break;
+		default:
+			*p++ = *name;
+		}
+	}
+	*p = '\0';
+
+	return new;
+}
+
+static bool prop_ignored(const char *name)
+{
+	int i;
+
+	if (*name == '#')
+		return true;
+	for (i = 0; i < ARRAY_SIZE(prop_ignore_list); i++) {
+		if (!strcmp(name, prop_ignore_list[i]))
+			return true;
+	}
+
+	return false;
+}
+
+/*
+ * dtoc keeps the properties of each node in a Python 2 dict and emits the
+ * platdata initialisers in dict iteration order. To produce identical output
+ * we replay the CPython 2.7 string hash and open-addressing insertion here.
+ */
+static uint64_t py2_hash(const char *str)
+{
+	const unsigned char *p = (const unsigned char *)str;
+	size_t len = strlen(str);
+	uint64_t x;
+	size_t i;
+
+	if (!len)
+		return 0;
+	x = (uint64_t)p[0] << 7;
+	for (i = 0; i < len; i++)
+		x = (x * 1000003) ^ p[i];
+	x ^= len;
+	if (x == (uint64_t)-1)
+		x = (uint64_t)-2;
+
+	return x;
+}
+
+static int *py2_dict_slot(const char *const *keys, int *slots, size_t mask,
+			  uint64_t hash, const char *key)
+{
+	size_t perturb = hash;
+	size_t i = hash & mask;
+
+	while (slots[i & mask] != -1) {
+		if (key && !strcmp(keys[slots[i & mask]], key))
+			break;
+		i = (i << 2) + i + perturb + 1;
+		perturb >>= 5;
+	}
+
+	return &slots[i & mask];
+}
+
+/**
+ * py2_dict_order() - Work out the iteration order of a Python 2 dict
+ *
+ * @keys: Keys, in the order they are inserted into the dict
+ * @count: Number of keys
+ * @nump: Returns the number of unique keys
+ * @return list of indexes into @keys (first occurrence of each key) in the
+ *	order in which Python 2 would iterate over the dict
+ */
+static int *py2_dict_order(const char *const *keys, int count, int *nump)
+{
+	size_t mask = 7, old_mask, newsize, i;
+	int *slots, *old, *slot, *order;
+	int used = 0, num = 0;
+	int n;
+
+	slots = xrealloc(NULL, (mask + 1) * sizeof(int));
+	memset(slots, 0xff, (mask + 1) * sizeof(int));
+	for (n = 0; n < count; n++) {
+		slot = py2_dict_slot(keys, slots, mask, py2_hash(keys[n]),
+				     keys[n]);
+		if (*slot != -1)
+			continue;
+		*slot = n;
+		if (++used * 3 < (mask + 1) * 2)
+			continue;
+
+		/* Resize as dictresize() does, re-inserting in slot order */
+		for (newsize = 8; newsize <= used * 4; newsize <<= 1)
+			;
+		old = slots;
+		old_mask = mask;
+		mask = newsize - 1;
+		slots = xrealloc(NULL, newsize * sizeof(int));
+		memset(slots, 0xff, newsize * sizeof(int));
+		for (i = 0; i <= old_mask; i++) {
+			if (old[i] == -1)
+				continue;
+			slot = py2_dict_slot(keys, slots, mask,
+					     py2_hash(keys[old[i]]), NULL);
+			*slot = old[i];
+		}
+		free(old);
+	}
+
+	order = xrealloc(NULL, (used + 1) * sizeof(int));
+	for (i = 0; i <= mask; i++) {
+		if (slots[i] != -1)
+			order[num++] = slots[i];
+	}
+	free(slots);
+	*nump = num;
+
+	return order;
+}
+
+static void prop_add_val(struct dtoc_prop *prop, const char *data, int len,
+			 uint64_t val64)
+{
+	struct dtoc_val *val;
+
+	prop->vals = xrealloc(prop->vals,
+			      (prop->count + 1) * sizeof(*prop->vals));
+	val = &prop->vals[prop->count++];
+	val->data = data;
+	val->len = len;
+	val->val64 = val64;
+}
+
+/* Equivalent of Python's len(prop.value) */
+static int prop_len(const struct dtoc_prop *prop)
+{
+	return prop->is_list ? prop->count : prop->vals[0].len;
+}
+
+static void prop_copy(struct dtoc_prop *dst, const struct dtoc_prop *src)
+{
+	*dst = *src;
+	dst->vals = xrealloc(NULL, src->count * sizeof(*src->vals));
+	memcpy(dst->vals, src->vals, src->count * sizeof(*src->vals));
+}
+
+/**
+ * prop_parse() - Convert property bytes into a type and value
+ *
+ * This follows Prop.BytesToValue() in fdt.py
+ */
+static void prop_parse(struct dtoc_prop *prop, const char *name,
+		       const char *data, int size)
+{
+	bool is_string = false;
+	int count = 0;
+	int i, start;
+
+	memset(prop, '\0', sizeof(*prop));
+	prop->name = name;
+	if (!size) {
+		prop->type = TYPE_BOOL;
+		prop_add_val(prop, NULL, 0, 1);
+		return;
+	}
+
+	for (i = 0; i < size; i++)
+		count += !data[i];
+	if (count && !data[size - 1]) {
+		is_string = true;
+		for (i = 0, start = 0; i < size && is_string; i++) {
+			if (data[i])
+				is_string = data[i] >= ' ' && data[i] <= '~';
+			else if (i == start)
+				is_string = false;
+			else
+				start = i + 1;
+		}
+	}
+
+	if (is_string) {
+		prop->type = TYPE_STRING;
+		prop->is_list = count > 1;
+		for (i = 0; i < size; i += strlen(data + i) + 1)
+			prop_add_val(prop, data + i, strlen(data + i), 0);
+	} else if (size % 4) {
+		prop->type = TYPE_BYTE;
+		prop->is_list = size > 1;
+		for (i = 0; i < size; i++)
+			prop_add_val(prop, data + i, 1, 0);
+	} else {
+		prop->type = TYPE_INT;
+		prop->is_list = size > 4;
+		for (i = 0; i < size; i += 4)
+			prop_add_val(prop, data + i, 4, 0);
+	}
+}
+
+/**
+ * prop_widen() - Widen a property so it can hold the value of another
+ *
+ * This follows Prop.Widen() in fdt.py, including its padding behaviour,
+ * so that the generated arrays have the same sizes and contents.
+ */
+static void prop_widen(struct dtoc_prop *prop, const struct dtoc_prop *newprop)
+{
+	int len;
+
+	if (newprop->type < prop->type)
+		prop->type = newprop->type;
+	if (newprop->is_list && !prop->is_list)
+		prop->is_list = true;
+	if (!prop->is_list)
+		return;
+
+	len = prop_len(newprop);
+	while (prop->count < len) {
+		switch (prop->type) {
+		case TYPE_BYTE:
+			prop_add_val(prop, "", 1, 0);
+			break;
+		case TYPE_INT:
+			prop_add_val(prop, "\0\0\0", 4, 0);
+			break;
+		case TYPE_STRING:
+			prop_add_val(prop, "", 0, 0);
+			break;
+		default:
+			prop_add_val(prop, NULL, 0, 1);
+			break;
+		}
+	}
+}
+
+static struct dtoc_prop *node_find_prop(struct dtoc_node *node,
+					const char *name)
+{
+	int i;
+
+	for (i = 0; i < node->num_props; i++) {
+		if (!strcmp(node->props[i].name, name))
+			return &node->props[i];
+	}
+
+	return NULL;
+}
+
+static uint32_t val_to_u32(const struct dtoc_val *val, const char *what)
+{
+	if (!val->data || val->len != 4)
+		fail("Cannot convert %s to a 32-bit cell", what);
+
+	return fdt32_to_cpu(*(fdt32_t *)val->data);
+}
+
+static struct dtoc_node *phandle_to_node(struct dtoc *dtoc, uint32_t phandle)
+{
+	int i;
+
+	for (i = 0; i < dtoc->num_phandles; i++) {
+		if (dtoc->phandles[i].phandle == phandle)
+			return dtoc->phandles[i].node;
+	}
+
+	return NULL;
+}
+
+/**
+ * get_compat_name() - Get a node's compatible strings as C identifiers
+ *
+ * @node: Node to check
+ * @index: Index of compatible string to return
+ * @return allocated C identifier, or NULL if there is no such string
+ */
+static char *get_compat_name(struct dtoc_node *node, int index)
+{
+	struct dtoc_prop *prop = node_find_prop(node, "compatible");
+	char *str, *name;
+
+	if (index >= prop->count)
+		return NULL;
+	if (prop->type != TYPE_STRING)
+		fail("Node '%s' has an invalid compatible string", node->name);
+	str = xrealloc(NULL, prop->vals[index].len + 1);
+	memcpy(str, prop->vals[index].data, prop->vals[index].len);
+	str[prop->vals[index].len] = '\0';
+	name = conv_name_to_c(str);
+	free(str);
+
+	return name;
+}
+
+/**
+ * get_phandle_argc() - Check if a property contains phandles
+ *
+ * We have no reliable way of detecting whether a property uses a phandle
+ * or not. As with dtoc, use a list of known property names.
+ *
+ * @prop: Property to check
+ * @node_name: Name of the node containing @prop, for error messages
+ * @info: Returns information about the phandles (caller frees @info->args)
+ * @return true if @prop is a phandle property, false if not
+ */
+static bool get_phandle_argc(struct dtoc *dtoc, const struct dtoc_prop *prop,
+			     const char *node_name, struct phandle_info *info)
+{
+	const char *cells_name = "#clock-cells";
+	struct dtoc_node *target;
+	struct dtoc_prop *cells;
+	int i, num_args;
+
+	if (strcmp(prop->name, "clocks"))
+		return false;
+
+	memset(info, '\0', sizeof(*info));
+	for (i = 0; i < prop->count; i += 1 + num_args) {
+		target = phandle_to_node(dtoc, val_to_u32(&prop->vals[i],
+							  prop->name));
+		if (!target)
+			fail("Cannot parse '%s' in node '%s'", prop->name,
+			     node_name);
+		cells = node_find_prop(target, cells_name);
+		if (!cells)
+			fail("Node '%s' has no '%s' property", target->name,
+			     cells_name);
+		num_args = val_to_u32(&cells->vals[0], cells_name);
+		if (num_args > info->max_args)
+			info->max_args = num_args;
+		info->args = xrealloc(info->args,
+				      (info->num_args + 1) * sizeof(int));
+		info->args[info->num_args++] = num_args;
+	}
+
+	return true;
+}
+
+static bool node_is_valid(struct dtoc *dtoc, struct dtoc_node *node)
+{
+	struct dtoc_prop *status;
+
+	if (!node_find_prop(node, "compatible"))
+		return false;
+	status = node_find_prop(node, "status");
+	if (!status || status->is_list || status->type != TYPE_STRING)
+		return true;
+
+	return status->vals[0].len != 8 ||
+		memcmp(status->vals[0].data, "disabled", 8);
+}
+
+/**
+ * scan_node() - Scan a node and its subnodes
+ *
+ * This builds the node's property list and records it in the phandle map
+ * and (if it has a compatible string) the list of valid nodes, in the same
+ * order as dtoc does.
+ */
+static struct dtoc_node *scan_node(struct dtoc *dtoc,
+				   struct dtoc_node *parent, int offset)
+{
+	const char **names = NULL;
+	struct dtoc_node *node;
+	struct dtoc_prop *prop;
+	const char *data, *name;
+	int poffset, len, subnode;
+
+	node = xrealloc(NULL, sizeof(*node));
+	memset(node, '\0', sizeof(*node));
+	node->parent = parent;
+	node->name = parent ? fdt_get_name(dtoc->blob, offset, NULL) : "/";
+
+	fdt_for_each_property_offset(poffset, dtoc->blob, offset) {
+		data = fdt_getprop_by_offset(dtoc->blob, poffset, &name, &len);
+		if (!data)
+			fail("Cannot read property in node '%s': %s",
+			     node->name, fdt_strerror(len));
+		node->props = xrealloc(node->props, (node->num_props + 1) *
+				       sizeof(*node->props));
+		names = xrealloc(names, (node->num_props + 1) *
+				 sizeof(*names));
+		names[node->num_props] = name;
+		prop_parse(&node->props[node->num_props++], name, data, len);
+	}
+	node->order = py2_dict_order(names, node->num_props, &len);
+	free(names);
+
+	prop = node_find_prop(node, "phandle");
+	if (prop) {
+		dtoc->phandles = xrealloc(dtoc->phandles,
+					  (dtoc->num_phandles + 1) *
+					  sizeof(*dtoc->phandles));
+		dtoc->phandles[dtoc->num_phandles].phandle =
+			val_to_u32(&prop->vals[0], prop->name);
+		dtoc->phandles[dtoc->num_phandles++].node = node;
+	}
+
+	if (parent && node_is_valid(dtoc, node)) {
+		dtoc->valid = xrealloc(dtoc->valid, (dtoc->num_valid + 1) *
+				       sizeof(*dtoc->valid));
+		dtoc->valid[dtoc->num_valid++] = node;
+	}
+
+	fdt_for_each_subnode(subnode, dtoc->blob, offset)
+		scan_node(dtoc, node, subnode);
+
+	return node;
+}
+
+static void get_num_cells(struct dtoc_node *node, int *nap, int *nsp)
+{
+	struct dtoc_prop *prop;
+
+	*nap = 2;
+	*nsp = 2;
+	if (!node->parent)
+		return;
+	prop = node_find_prop(node->parent, "#address-cells");
+	if (prop)
+		*nap = val_to_u32(&prop->vals[0], prop->name);
+	prop = node_find_prop(node->parent, "#size-cells");
+	if (prop)
+		*nsp = val_to_u32(&prop->vals[0], prop->name);
+}
+
+static uint64_t cells_to_cpu(struct dtoc_val *vals, int avail, int cells)
+{
+	uint64_t out;
+
+	if (!cells)
+		return 0;
+	if (avail < 1 || (cells == 2 && avail < 2))
+		fail("Not enough cells in 'reg' property");
+	out = val_to_u32(&vals[0], "reg");
+	if (cells == 2)
+		out = out << 32 | val_to_u32(&vals[1], "reg");
+
+	return out;
+}
+
+/* Convert 'reg' properties which are not 1/1 cells into 64-bit values */
+static void scan_reg_sizes(struct dtoc *dtoc)
+{
+	struct dtoc_prop *reg;
+	struct dtoc_val *vals;
+	int na, ns, i, n, count;
+	uint64_t addr, size;
+
+	for (n = 0; n < dtoc->num_valid; n++) {
+		reg = node_find_prop(dtoc->valid[n], "reg");
+		if (!reg)
+			continue;
+		get_num_cells(dtoc->valid[n], &na, &ns);
+		if (reg->type != TYPE_INT)
+			fail("Node '%s' reg property is not an int",
+			     dtoc->valid[n]->name);
+		if (!(na + ns) || prop_len(reg) % (na + ns))
+			fail("Node '%s' reg property has %d cells which is not a multiple of na + ns = %d + %d)",
+			     dtoc->valid[n]->name, prop_len(reg), na, ns);
+		if (na == 1 && ns == 1)
+			continue;
+
+		vals = reg->vals;
+		count = reg->count;
+		reg->type = TYPE_INT64;
+		reg->is_list = true;
+		reg->vals = NULL;
+		reg->count = 0;
+		for (i = 0; i < count;) {
+			addr = cells_to_cpu(&vals[i], count - i, na);
+			i += na;
+			size = cells_to_cpu(&vals[i], count - i, ns);
+			i += ns;
+			prop_add_val(reg, NULL, 0, addr);
+			prop_add_val(reg, NULL, 0, size);
+		}
+		free(vals);
+	}
+}
+
+static struct dtoc_prop *struct_find_field(struct dtoc_struct *st,
+					   const char *name)
+{
+	int i;
+
+	for (i = 0; i < st->num_fields; i++) {
+		if (!strcmp(st->fields[i].name, name))
+			return &st->fields[i];
+	}
+
+	return NULL;
+}
+
+static struct dtoc_struct *find_struct(struct dtoc *dtoc, const char *name)
+{
+	int i;
+
+	for (i = 0; i < dtoc->num_structs; i++) {
+		if (!strcmp(dtoc->structs[i].name, name))
+			return &dtoc->structs[i];
+	}
+
+	return NULL;
+}
+
+/**
+ * scan_structs() - Build up the C structures we will use
+ *
+ * Where the same struct appears multiple times, use the 'widest' property,
+ * i.e. the one with a type which can express all others, then widen each
+ * node's properties to match.
+ */
+static void scan_structs(struct dtoc *dtoc)
+{
+	struct dtoc_struct *st;
+	struct dtoc_prop *prop, *field;
+	struct dtoc_node *node;
+	char *name;
+	int n, i;
+
+	for (n = 0; n < dtoc->num_valid; n++) {
+		node = dtoc->valid[n];
+		name = get_compat_name(node, 0);
+		st = find_struct(dtoc, name);
+		if (st) {
+			free(name);
+		} else {
+			dtoc->structs = xrealloc(dtoc->structs,
+						 (dtoc->num_structs + 1) *
+						 sizeof(*dtoc->structs));
+			st = &dtoc->structs[dtoc->num_structs++];
+			st->name = name;
+			st->fields = NULL;
+			st->num_fields = 0;
+		}
+
+		for (i = 0; i < node->num_props; i++) {
+			prop = &node->props[i];
+			if (prop_ignored(prop->name))
+				continue;
+			field = struct_find_field(st, prop->name);
+			if (field) {
+				prop_widen(field, prop);
+				continue;
+			}
+			st->fields = xrealloc(st->fields,
+					      (st->num_fields + 1) *
+					      sizeof(*st->fields));
+			prop_copy(&st->fields[st->num_fields++], prop);
+		}
+	}
+
+	for (n = 0; n < dtoc->num_valid; n++) {
+		node = dtoc->valid[n];
+		name = get_compat_name(node, 0);
+		st = find_struct(dtoc, name);
+		for (i = 0; i < node->num_props; i++) {
+			prop = &node->props[i];
+			if (!prop_ignored(prop->name))
+				prop_widen(prop, struct_find_field(st,
+								   prop->name));
+		}
+
+		for (i = 1; (name = get_compat_name(node, i)); i++) {
+			dtoc->alias_keys = xrealloc(dtoc->alias_keys,
+						    (dtoc->num_aliases + 1) *
+						    sizeof(char *));
+			dtoc->alias_vals = xrealloc(dtoc->alias_vals,
+						    (dtoc->num_aliases + 1) *
+						    sizeof(char *));
+			dtoc->alias_keys[dtoc->num_aliases] = name;
+			dtoc->alias_vals[dtoc->num_aliases++] = st->name;
+		}
+	}
+}
+
+/**
+ * scan_phandles() - Figure out what phandles each node uses
+ *
+ * Nodes that use phandles must be output after the nodes they refer to,
+ * otherwise the referenced platdata is not yet declared in the C file.
+ *
+ * dtoc keeps these dependencies in a Python set, so the order in which
+ * several not-yet-output dependencies are emitted depends on object
+ * addresses there. We use the order of the phandle references instead.
+ */
+static void scan_phandles(struct dtoc *dtoc)
+{
+	struct phandle_info info;
+	struct dtoc_node *node, *target;
+	struct dtoc_prop *prop;
+	int n, i, j, pos;
+
+	for (n = 0; n < dtoc->num_valid; n++) {
+		node = dtoc->valid[n];
+		for (i = 0; i < node->num_props; i++) {
+			prop = &node->props[i];
+			if (prop_ignored(prop->name) ||
+			    !get_phandle_argc(dtoc, prop, node->name, &info))
+				continue;
+			prop->is_list = true;
+			for (pos = 0, j = 0; j < info.num_args;
+			     pos += 1 + info.args[j++]) {
+				target = phandle_to_node(dtoc,
+					val_to_u32(&prop->vals[pos],
+						   prop->name));
+				node->deps = xrealloc(node->deps,
+						      (node->num_deps + 1) *
+						      sizeof(*node->deps));
+				node->deps[node->num_deps++] = target;
+			}
+			free(info.args);
+		}
+	}
+}
+
+static void out_header(struct dtoc *dtoc)
+{
+	out(dtoc, "/*\n"
+	    " * DO NOT MODIFY\n"
+	    " *\n"
+	    " * This file was generated by dtoc from a .dtb (device tree binary) file.\n"
+	    " */\n"
+	    "\n");
+}
+
+static int h_cmp_struct(const void *v1, const void *v2)
+{
+	const struct dtoc_struct *s1 = v1, *s2 = v2;
+
+	return strcmp(s1->name, s2->name);
+}
+
+static int h_cmp_prop(const void *v1, const void *v2)
+{
+	const struct dtoc_prop *p1 = v1, *p2 = v2;
+
+	return strcmp(p1->name, p2->name);
+}
+
+/* Output the struct definitions for dt-structs-gen.h */
+static void generate_structs(struct dtoc *dtoc)
+{
+	struct phandle_info info;
+	struct dtoc_struct *st;
+	struct dtoc_prop *prop;
+	char type[40], *name;
+	int *order, num;
+	int n, i;
+
+	out_header(dtoc);
+	out(dtoc, "#include <stdbool.h>\n");
+	out(dtoc, "#include <linux/libfdt.h>\n");
+
+	qsort(dtoc->structs, dtoc->num_structs, sizeof(*dtoc->structs),
+	      h_cmp_struct);
+	for (n = 0; n < dtoc->num_structs; n++) {
+		st = &dtoc->structs[n];
+		qsort(st->fields, st->num_fields, sizeof(*st->fields),
+		      h_cmp_prop);
+		out(dtoc, "struct %s%s {\n", STRUCT_PREFIX, st->name);
+		for (i = 0; i < st->num_fields; i++) {
+			prop = &st->fields[i];
+			name = conv_name_to_c(prop->name);
+			if (get_phandle_argc(dtoc, prop, st->name, &info)) {
+				snprintf(type, sizeof(type),
+					 "struct phandle_%d_arg",
+					 info.max_args);
+				out(dtoc, "\t");
+				out_tab_to(dtoc, 2, type);
+				out(dtoc, "%s[%d]", name, info.num_args);
+				free(info.args);
+			} else {
+				out(dtoc, "\t");
+				out_tab_to(dtoc, 2, type_names[prop->type]);
+				out(dtoc, "%s", name);
+				if (prop->is_list)
+					out(dtoc, "[%d]", prop->count);
+			}
+			out(dtoc, ";\n");
+			free(name);
+		}
+		out(dtoc, "};\n");
+	}
+
+	order = py2_dict_order((const char *const *)dtoc->alias_keys,
+			       dtoc->num_aliases, &num);
+	for (n = 0; n < num; n++) {
+		/* A later assignment to the same key replaces the value */
+		for (i = dtoc->num_aliases - 1; i >= 0; i--) {
+			if (!strcmp(dtoc->alias_keys[i],
+				    dtoc->alias_keys[order[n]]))
+				break;
+		}
+		out(dtoc, "#define %s%s %s%s\n", STRUCT_PREFIX,
+		    dtoc->alias_keys[i], STRUCT_PREFIX, dtoc->alias_vals[i]);
+	}
+	free(order);
+}
+
+static void out_value(struct dtoc *dtoc, int type, const struct dtoc_val *val)
+{
+	switch (type) {
+	case TYPE_INT:
+		out_hex(dtoc, val_to_u32(val, "value"));
+		break;
+	case TYPE_BYTE:
+		if (!val->data || !val->len)
+			fail("Cannot convert value to a byte");
+		out_hex(dtoc, (unsigned char)val->data[0]);
+		break;
+	case TYPE_STRING:
+		if (!val->data && val->len)
+			fail("Cannot convert value to a string");
+		out(dtoc, "\"%.*s\"", val->len, val->data ? val->data : "");
+		break;
+	case TYPE_BOOL:
+		out(dtoc, "true");
+		break;
+	case TYPE_INT64:
+		if (val->data)
+			fail("Cannot convert value to a 64-bit integer");
+		out_hex(dtoc, val->val64);
+		break;
+	}
+}
+
+static void output_phandles(struct dtoc *dtoc, struct dtoc_node *node,
+			    struct dtoc_prop *prop, struct phandle_info *info)
+{
+	struct dtoc_node *target;
+	char *name;
+	int pos, i, j;
+
+	for (pos = 0, i = 0; i < info->num_args; pos += 1 + info->args[i++]) {
+		target = phandle_to_node(dtoc, val_to_u32(&prop->vals[pos],
+							  prop->name));
+		name = conv_name_to_c(target->name);
+		out(dtoc, "\n\t\t\t{&%s%s, {", VAL_PREFIX, name);
+		for (j = 0; j < info->args[i]; j++) {
+			if (pos + 1 + j >= prop->count)
+				fail("Not enough arguments for '%s' in node '%s'",
+				     prop->name, node->name);
+			out(dtoc, "%s%u", j ? ", " : "",
+			    val_to_u32(&prop->vals[pos + 1 + j], prop->name));
+		}
+		out(dtoc, "}},");
+		free(name);
+	}
+}
+
+/* Output the C code for a node */
+static void output_node(struct dtoc *dtoc, struct dtoc_node *node)
+{
+	struct phandle_info info;
+	struct dtoc_prop *prop;
+	char *struct_name, *var_name, *name, *member;
+	int i, j;
+
+	struct_name = get_compat_name(node, 0);
+	var_name = conv_name_to_c(node->name);
+	out(dtoc, "static struct %s%s %s%s = {\n", STRUCT_PREFIX, struct_name,
+	    VAL_PREFIX, var_name);
+	for (i = 0; i < node->num_props; i++) {
+		prop = &node->props[node->order[i]];
+		if (prop_ignored(prop->name))
+			continue;
+		name = conv_name_to_c(prop->name);
+		member = xrealloc(NULL, strlen(name) + 2);
+		sprintf(member, ".%s", name);
+		out(dtoc, "\t");
+		out_tab_to(dtoc, 3, member);
+		free(member);
+		free(name);
+		out(dtoc, "= ");
+
+		if (prop->is_list) {
+			out(dtoc, "{");
+			if (get_phandle_argc(dtoc, prop, node->name, &info)) {
+				output_phandles(dtoc, node, prop, &info);
+				free(info.args);
+			} else {
+				/* Put 8 values per line to avoid long lines */
+				for (j = 0; j < prop->count; j++) {
+					if (j)
+						out(dtoc, j % 8 ? ", " :
+						    ",\n\t\t");
+					out_value(dtoc, prop->type,
+						  &prop->vals[j]);
+				}
+			}
+			out(dtoc, "}");
+		} else {
+			out_value(dtoc, prop->type, &prop->vals[0]);
+		}
+		out(dtoc, ",\n");
+	}
+	out(dtoc, "};\n");
+
+	/* Add a device declaration */
+	out(dtoc, "U_BOOT_DEVICE(%s) = {\n", var_name);
+	out(dtoc, "\t.name\t\t= \"%s\",\n", struct_name);
+	out(dtoc, "\t.platdata\t= &%s%s,\n", VAL_PREFIX, var_name);
+	out(dtoc, "\t.platdata_size\t= sizeof(%s%s),\n", VAL_PREFIX, var_name);
+	out(dtoc, "};\n");
+	out(dtoc, "\n");
+	node->output = true;
+	free(struct_name);
+	free(var_name);
+}
+
+static bool node_pending(struct dtoc *dtoc, struct dtoc_node *node)
+{
+	int i;
+
+	if (node->output)
+		return false;
+	for (i = 0; i < dtoc->num_valid; i++) {
+		if (dtoc->valid[i] == node)
+			return true;
+	}
+
+	return false;
+}
+
+/* Output the platform data and U_BOOT_DEVICE() declarations */
+static void generate_tables(struct dtoc *dtoc)
+{
+	struct dtoc_node *node;
+	int n, i;
+
+	out_header(dtoc);
+	out(dtoc, "#include <common.h>\n");
+	out(dtoc, "#include <dm.h>\n");
+	out(dtoc, "#include <dt-structs.h>\n");
+	out(dtoc, "\n");
+
+	for (n = 0; n < dtoc->num_valid; n++) {
+		node = dtoc->valid[n];
+		if (node->output)
+			continue;
+		/* Output all the node's dependencies first */
+		for (i = 0; i < node->num_deps; i++) {
+			if (node->deps[i] != node &&
+			    node_pending(dtoc, node->deps[i]))
+				output_node(dtoc, node->deps[i]);
+		}
+		output_node(dtoc, node);
+	}
+}
+
+static char *read_file(const char *fname, size_t *sizep)
+{
+	struct stat st;
+	char *buf;
+	FILE *f;
+
+	f = fopen(fname, "rb");
+	if (!f)
+		return NULL;
+	if (fstat(fileno(f), &st)) {
+		fclose(f);
+		return NULL;
+	}
+	buf = xrealloc(NULL, st.st_size + 1);
+	if (fread(buf, 1, st.st_size, f) != st.st_size) {
+		free(buf);
+		fclose(f);
+		return NULL;
+	}
+	fclose(f);
+	*sizep = st.st_size;
+
+	return buf;
+}
+
+static int write_file(const char *fname, const char *buf, size_t size)
+{
+	FILE *f;
+
+	f = fopen(fname, "wb");
+	if (!f)
+		return -errno;
+	if (fwrite(buf, 1, size, f) != size) {
+		fclose(f);
+		return -EIO;
+	}
+
+	return fclose(f) ? -errno : 0;
+}
+
+/* Get the name of the stamp file, e.g. spl/dts/.dt-platdata.c.dtoc */
+static char *stamp_name(const char *output)
+{
+	const char *base = strrchr(output, '/');
+	char *stamp;
+	int dirlen;
+
+	base = base ? base + 1 : output;
+	dirlen = base - output;
+	stamp = xrealloc(NULL, strlen(output) + 7);
+	sprintf(stamp, "%.*s.%s.dtoc", dirlen, output, base);
+
+	return stamp;
+}
+
+/**
+ * get_stamp() - Work out the content hash for this run
+ *
+ * This covers the DTB contents and everything which affects the output.
+ */
+static void get_stamp(const char *blob, size_t size, const char *cmds,
+		      bool include_disabled, char *hex)
+{
+	uint8_t digest[SHA256_SUM_LEN];
+	sha256_context ctx;
+	int i;
+
+	sha256_starts(&ctx);
+	sha256_update(&ctx, (const uint8_t *)blob, size);
+	sha256_update(&ctx, (const uint8_t *)cmds, strlen(cmds) + 1);
+	sha256_update(&ctx, (const uint8_t *)&include_disabled, 1);
+	sha256_finish(&ctx, digest);
+	for (i = 0; i < SHA256_SUM_LEN; i++)
+		sprintf(hex + i * 2, "%02x", digest[i]);
+}
+
+/**
+ * stamp_matches() - Check if the output is up to date
+ *
+ * The stamp is only trusted if it is newer than this tool, so that a
+ * rebuilt dtoc regenerates its output.
+ */
+static bool stamp_matches(const char *prog, const char *output,
+			  const char *stamp, const char *hex)
+{
+	struct stat st_prog, st_stamp, st_out;
+	size_t size;
+	char *old;
+	bool match;
+
+	if (stat(prog, &st_prog) || stat(stamp, &st_stamp) ||
+	    stat(output, &st_out) || st_stamp.st_mtime < st_prog.st_mtime)
+		return false;
+	old = read_file(stamp, &size);
+	if (!old)
+		return false;
+	match = size == strlen(hex) + 1 && !memcmp(old, hex, size - 1);
+	free(old);
+
+	return match;
+}
+
+static void usage(const char *msg)
+{
+	if (msg)
+		fprintf(stderr, "Error: %s\n\n", msg);
+	fprintf(stderr,
+		"Usage: dtoc-native [options] <struct|platdata>[,...]\n"
+		"\n"
+		"Options:\n"
+		"  -d, --dtb-file <file>   Specify the .dtb input file\n"
+		"      --include-disabled  Include disabled nodes\n"
+		"  -o, --output <file>     Select output filename (default: -)\n"
+		"  -h, --help              Show this help\n");
+	exit(msg ? EXIT_FAILURE : EXIT_SUCCESS);
+}
+
+int main(int argc, char *argv[])
+{
+	static const struct option long_opts[] = {
+		{ "dtb-file", required_argument, NULL, 'd' },
+		{ "include-disabled", no_argument, NULL, 'i' },
+		{ "output", required_argument, NULL, 'o' },
+		{ "help", no_argument, NULL, 'h' },
+		{ NULL, 0, NULL, 0 },
+	};
+	char hex[SHA256_SUM_LEN * 2 + 1];
+	const char *dtb_fname = NULL;
+	const char *output = "-";
+	struct dtoc dtoc;
+	char *cmds, *cmd, *blob, *stamp = NULL, *old;
+	size_t size, old_size;
+	int opt, ret;
+
+	memset(&dtoc, '\0', sizeof(dtoc));
+	while ((opt = getopt_long(argc, argv, "d:o:h", long_opts,
+				  NULL)) != -1) {
+		switch (opt) {
+		case 'd':
+			dtb_fname = optarg;
+			break;
+		case 'i':
+			dtoc.include_disabled = true;
+			break;
+		case 'o':
+			output = optarg;
+			break;
+		case 'h':
+			usage(NULL);
+		default:
+			usage("Unknown option");
+		}
+	}
+	if (optind >= argc)
+		usage("Please specify a command: struct, platdata");
+	if (!dtb_fname)
+		usage("Please specify a .dtb file with -d");
+
+	blob = read_file(dtb_fname, &size);
+	if (!blob)
+		fail("Cannot read '%s': %s", dtb_fname, strerror(errno));
+	ret = fdt_check_header(blob);
+	if (ret || fdt_totalsize(blob) > size)
+		fail("'%s' is not a valid device tree: %s", dtb_fname,
+		     fdt_strerror(ret ? ret : -FDT_ERR_TRUNCATED));
+	dtoc.blob = blob;
+
+	if (strcmp(output, "-")) {
+		stamp = stamp_name(output);
+		get_stamp(blob, size, argv[optind], dtoc.include_disabled, hex);
+		if (stamp_matches(argv[0], output, stamp, hex))
+			return 0;
+	}
+
+	scan_node(&dtoc, NULL, 0);
+	scan_reg_sizes(&dtoc);
+	scan_structs(&dtoc);
+	scan_phandles(&dtoc);
+
+	cmds = xstrdup(argv[optind]);
+	for (cmd = strtok(cmds, ","); cmd; cmd = strtok(NULL, ",")) {
+		if (!strcmp(cmd, "struct"))
+			generate_structs(&dtoc);
+		else if (!strcmp(cmd, "platdata"))
+			generate_tables(&dtoc);
+		else
+			fail("Unknown command '%s': (use: struct, platdata)",
+			     cmd);
+	}
+	free(cmds);
+
+	if (!stamp) {
+		fwrite(dtoc.out.buf, 1, dtoc.out.len, stdout);
+		return 0;
+	}
+
+	/* Leave the output (and its timestamp) alone if nothing changed */
+	old = read_file(output, &old_size);
+	if (!old || old_size != dtoc.out.len ||
+	    memcmp(old, dtoc.out.buf, old_size)) {
+		ret = write_file(output, dtoc.out.buf, dtoc.out.len);
+		if (ret)
+			fail("Cannot write '%s': %s", output, strerror(-ret));
+	}
+	free(old);
+
+	strcat(hex, "\n");
+	ret = write_file(stamp, hex, strlen(hex));
+	if (ret)
+		fail("Cannot write '%s': %s", stamp, strerror(-ret));
+
+	return 0;
+}
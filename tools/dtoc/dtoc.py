@@ -43,7 +43,7 @@ def run_tests():
 
     result = unittest.TestResult()
     sys.argv = [sys.argv[0]]
-    for module in (test_dtoc.TestDtoc,):
+    for module in (test_dtoc.TestDtoc, test_dtoc.TestDtocNative):
         suite = unittest.TestLoader().loadTestsFromTestCase(module)
         suite.run(result)
 
@@ -12,6 +12,7 @@ This includes unit tests for some functions and functional tests for
 import collections
 import os
 import struct
+import subprocess
 import unittest
 
 import dtb_platdata
@@ -521,3 +522,66 @@ U_BOOT_DEVICE(test3) = {
 };
 
 ''', data)
+
+
+# Location of the native dtoc, which must produce identical output
+DTOC_NATIVE = os.environ.get('DTOC_NATIVE',
+                             os.path.join(our_path, '..', 'dtoc-native'))
+
+TEST_FILES = [
+    'dtoc_test_empty.dts',
+    'dtoc_test_simple.dts',
+    'dtoc_test_phandle.dts',
+    'dtoc_test_aliases.dts',
+    'dtoc_test_addr32.dts',
+    'dtoc_test_addr64.dts',
+    'dtoc_test_addr32_64.dts',
+    'dtoc_test_addr64_32.dts',
+]
+
+
+@unittest.skipUnless(os.path.exists(DTOC_NATIVE),
+                     'dtoc-native not built (set DTOC_NATIVE)')
+class TestDtocNative(unittest.TestCase):
+    """Check that tools/dtoc-native matches the output of dtoc"""
+    @classmethod
+    def setUpClass(cls):
+        tools.PrepareOutputDir(None)
+
+    @classmethod
+    def tearDownClass(cls):
+        tools._RemoveOutputDir()
+
+    def run_native(self, cmd, dtb_file, output):
+        """Run dtoc-native and return the contents of its output file"""
+        subprocess.check_call([DTOC_NATIVE, '-d', dtb_file, '-o', output,
+                               cmd])
+        with open(output) as infile:
+            return infile.read()
+
+    def test_native_output(self):
+        """Test that both implementations give the same output"""
+        expected = tools.GetOutputFilename('expected')
+        output = tools.GetOutputFilename('native')
+        for dts in TEST_FILES:
+            dtb_file = get_dtb_file(dts)
+            for cmd in ['struct', 'platdata', 'struct,platdata']:
+                dtb_platdata.run_steps([cmd], dtb_file, False, expected)
+                with open(expected) as infile:
+                    data = infile.read()
+                self.assertEqual(data, self.run_native(cmd, dtb_file, output),
+                                 '%s: %s' % (dts, cmd))
+
+    def test_native_unchanged(self):
+        """Test that an unchanged DTB does not rewrite the output"""
+        dtb_file = get_dtb_file('dtoc_test_simple.dts')
+        output = tools.GetOutputFilename('native')
+        data = self.run_native('platdata', dtb_file, output)
+        os.utime(output, (0, 0))
+        self.assertEqual(data, self.run_native('platdata', dtb_file, output))
+        self.assertEqual(0, os.stat(output).st_mtime)
+
+        # A different DTB must regenerate the output
+        dtb_file = get_dtb_file('dtoc_test_phandle.dts')
+        self.run_native('platdata', dtb_file, output)
+        self.assertNotEqual(0, os.stat(output).st_mtime)
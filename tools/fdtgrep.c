@@ -66,6 +66,17 @@ struct display_info {
 	struct value_node *value_head;	/* List of values to match */
 	const char *output_fname;	/* Output filename */
 	FILE *fout;		/* File to write dts/dtb output */
+	struct display_info *then;	/* Next pass over our output, or NULL */
+	struct display_info *next;	/* Next output variant, or NULL */
+};
+
+/*
+ * Region list shared by all passes, sized up-front so that each pass only
+ * needs to walk the tree once
+ */
+struct region_arena {
+	struct fdt_region *region;	/* List of regions */
+	int max_regions;		/* Number of entries in @region */
 };
 
 static void report_error(const char *where, int err)
@@ -765,21 +776,180 @@ char *utilfdt_read(const char *filename)
 	return utilfdt_read_len(filename, &len);
 }
 
+/**
+ * region_arena_fit() - Make sure the region arena is large enough for a blob
+ *
+ * Each region starts at a tag in the structure block, with the mem_rsvmap
+ * and string table adding one each. Aliases can add the same again, so
+ * this bound means fdtgrep_find_regions() never runs out of space and we
+ * do not need a counting pass.
+ *
+ * @arena:	Arena to update
+ * @blob:	FDT blob which is about to be grepped
+ * @return 0 if OK, -1 if out of memory
+ */
+static int region_arena_fit(struct region_arena *arena, const void *blob)
+{
+	struct fdt_region *region;
+	int size, needed;
+
+	size = fdt_version(blob) >= 17 ? fdt_size_dt_struct(blob) :
+		fdt_totalsize(blob);
+	needed = (size / FDT_TAGSIZE + 3) * 2;
+	if (needed <= arena->max_regions)
+		return 0;
+
+	region = realloc(arena->region, needed * sizeof(struct fdt_region));
+	if (!region) {
+		fprintf(stderr, "Out of memory for %d regions\n", needed);
+		return -1;
+	}
+	arena->region = region;
+	arena->max_regions = needed;
+
+	return 0;
+}
+
+/**
+ * dump_fdt_blob() - Produce a binary FDT from a list of regions
+ *
+ * @disp:	Display information / options
+ * @blob:	FDT blob the regions refer to
+ * @region:	List of regions
+ * @count:	Number of regions
+ * @fdtp:	Returns the allocated output, which the caller must free
+ * @return size of output in bytes, or -1 on error
+ */
+static int dump_fdt_blob(struct display_info *disp, const void *blob,
+			 struct fdt_region *region, int count, void **fdtp)
+{
+	void *fdt, *out;
+	/* Allow reserved memory section to expand slightly */
+	int size = fdt_totalsize(blob) + 16;
+	int ret;
+
+	fdt = malloc(size);
+	if (!fdt) {
+		fprintf(stderr, "Out_of_memory\n");
+		return -1;
+	}
+	size = dump_fdt_regions(disp, blob, region, count, fdt);
+	if (disp->remove_strings) {
+		out = malloc(size);
+		if (!out) {
+			fprintf(stderr, "Out_of_memory\n");
+			goto err;
+		}
+		ret = fdt_remove_unused_strings(fdt, out);
+		if (ret < 0) {
+			fprintf(stderr,
+				"Failed to remove unused strings: err=%d\n",
+				ret);
+			free(out);
+			goto err;
+		}
+		free(fdt);
+		fdt = out;
+		ret = fdt_pack(fdt);
+		if (ret < 0) {
+			fprintf(stderr, "Failed to pack: err=%d\n", ret);
+			goto err;
+		}
+		size = fdt_totalsize(fdt);
+	}
+	*fdtp = fdt;
+
+	return size;
+err:
+	free(fdt);
+	return -1;
+}
+
+/**
+ * do_fdtgrep_variant() - Produce one output variant from a blob
+ *
+ * The variant consists of one or more passes. Each pass except the last
+ * produces a .dtb which is handed straight to the next pass, as if the
+ * output had been piped into another fdtgrep.
+ *
+ * @disp:	Display information / options for the first pass
+ * @blob:	FDT blob to grep
+ * @arena:	Region arena to use
+ * @return 0 if ok, -ve on error
+ */
+static int do_fdtgrep_variant(struct display_info *disp, const void *blob,
+			      struct region_arena *arena)
+{
+	void *fdt, *prev = NULL;
+	char path[1024];
+	int count, size;
+	int ret = 0;
+
+	for (; disp; disp = disp->then) {
+		if (region_arena_fit(arena, blob)) {
+			ret = -1;
+			break;
+		}
+		count = fdtgrep_find_regions(blob, h_include, disp,
+					     arena->region, arena->max_regions,
+					     path, sizeof(path), disp->flags);
+		if (count < 0) {
+			report_error("fdt_find_regions", count);
+			ret = -1;
+			break;
+		}
+		if (count > arena->max_regions) {
+			fprintf(stderr, "Too many regions (%d)\n", count);
+			ret = -1;
+			break;
+		}
+
+		/* Optionally print a list of regions */
+		if (disp->region_list)
+			show_region_list(arena->region, count);
+
+		/* Output either source .dts or binary .dtb */
+		if (disp->output == OUT_DTS) {
+			ret = display_fdt_by_regions(disp, blob, arena->region,
+						     count);
+			break;
+		}
+		size = dump_fdt_blob(disp, blob, arena->region, count, &fdt);
+		if (size < 0) {
+			ret = -1;
+			break;
+		}
+		free(prev);
+		prev = fdt;
+		blob = fdt;
+		if (disp->then)
+			continue;
+
+		if (size != fwrite(fdt, 1, size, disp->fout)) {
+			fprintf(stderr, "Write failure, %d bytes\n", size);
+			ret = 1;
+		}
+	}
+	free(prev);
+
+	return ret;
+}
+
 /**
  * Run the main fdtgrep operation, given a filename and valid arguments
  *
- * @param disp		Display information / options
+ * The input is read once and each output variant is produced from it in
+ * turn, sharing the same region arena.
+ *
+ * @param disp		Display information / options (first variant)
  * @param filename	Filename of blob file
  * @param return 0 if ok, -ve on error
  */
 static int do_fdtgrep(struct display_info *disp, const char *filename)
 {
-	struct fdt_region *region;
-	int max_regions;
-	int count = 100;
-	char path[1024];
+	struct region_arena arena = { NULL, 0 };
 	char *blob;
-	int i, ret;
+	int ret;
 
 	blob = utilfdt_read(filename);
 	if (!blob)
@@ -797,89 +967,13 @@ static int do_fdtgrep(struct display_info *disp, const char *filename)
 			fdt_version(blob));
 	}
 
-	/*
-	 * We do two passes, since we don't know how many regions we need.
-	 * The first pass will count the regions, but if it is too many,
-	 * we do another pass to actually record them.
-	 */
-	for (i = 0; i < 3; i++) {
-		region = malloc(count * sizeof(struct fdt_region));
-		if (!region) {
-			fprintf(stderr, "Out of memory for %d regions\n",
-				count);
-			return -1;
-		}
-		max_regions = count;
-		count = fdtgrep_find_regions(blob,
-				h_include, disp,
-				region, max_regions, path, sizeof(path),
-				disp->flags);
-		if (count < 0) {
-			report_error("fdt_find_regions", count);
-			return -1;
-		}
-		if (count <= max_regions)
+	for (; disp; disp = disp->next) {
+		ret = do_fdtgrep_variant(disp, blob, &arena);
+		if (ret)
 			break;
-		free(region);
-	}
-
-	/* Optionally print a list of regions */
-	if (disp->region_list)
-		show_region_list(region, count);
-
-	/* Output either source .dts or binary .dtb */
-	if (disp->output == OUT_DTS) {
-		ret = display_fdt_by_regions(disp, blob, region, count);
-	} else {
-		void *fdt;
-		/* Allow reserved memory section to expand slightly */
-		int size = fdt_totalsize(blob) + 16;
-
-		fdt = malloc(size);
-		if (!fdt) {
-			fprintf(stderr, "Out_of_memory\n");
-			ret = -1;
-			goto err;
-		}
-		size = dump_fdt_regions(disp, blob, region, count, fdt);
-		if (disp->remove_strings) {
-			void *out;
-
-			out = malloc(size);
-			if (!out) {
-				fprintf(stderr, "Out_of_memory\n");
-				ret = -1;
-				goto err;
-			}
-			ret = fdt_remove_unused_strings(fdt, out);
-			if (ret < 0) {
-				fprintf(stderr,
-					"Failed to remove unused strings: err=%d\n",
-					ret);
-				goto err;
-			}
-			free(fdt);
-			fdt = out;
-			ret = fdt_pack(fdt);
-			if (ret < 0) {
-				fprintf(stderr, "Failed to pack: err=%d\n",
-					ret);
-				goto err;
-			}
-			size = fdt_totalsize(fdt);
-		}
-
-		if (size != fwrite(fdt, 1, size, disp->fout)) {
-			fprintf(stderr, "Write failure, %d bytes\n", size);
-			free(fdt);
-			ret = 1;
-			goto err;
-		}
-		free(fdt);
 	}
-err:
 	free(blob);
-	free(region);
+	free(arena.region);
 
 	return ret;
 }
@@ -892,7 +986,10 @@ static const char usage_synopsis[] =
 	"Output formats are:\n"
 	"\tdts - device tree soure text\n"
 	"\tdtb - device tree blob (sets -Hmt automatically)\n"
-	"\tbin - device tree fragment (may not be a valid .dtb)";
+	"\tbin - device tree fragment (may not be a valid .dtb)\n\n"
+	"Use -J to pass the output through a further set of options, as if\n"
+	"piped into another fdtgrep, and -X to produce several outputs (each\n"
+	"with its own options and -o file) from a single read of the input.";
 
 /* Helper for usage_short_opts string constant */
 #define USAGE_COMMON_SHORT_OPTS "hV"
@@ -919,7 +1016,7 @@ static const char usage_synopsis[] =
 	case '?': usage("unknown option");
 
 static const char usage_short_opts[] =
-		"haAc:b:C:defg:G:HIlLmn:N:o:O:p:P:rRsStTv"
+		"haAc:b:C:defg:G:HIJlLmn:N:o:O:p:P:rRsStTvX"
 		USAGE_COMMON_SHORT_OPTS;
 static struct option const usage_long_opts[] = {
 	{"show-address",	no_argument, NULL, 'a'},
@@ -934,6 +1031,7 @@ static struct option const usage_long_opts[] = {
 	{"exclude-match",	a_argument, NULL, 'G'},
 	{"show-header",		no_argument, NULL, 'H'},
 	{"show-version",	no_argument, NULL, 'I'},
+	{"then",		no_argument, NULL, 'J'},
 	{"list-regions",	no_argument, NULL, 'l'},
 	{"list-strings",	no_argument, NULL, 'L'},
 	{"include-mem",		no_argument, NULL, 'm'},
@@ -950,6 +1048,7 @@ static struct option const usage_long_opts[] = {
 	{"out",			a_argument, NULL, 'o'},
 	{"out-format",		a_argument, NULL, 'O'},
 	{"invert-match",	no_argument, NULL, 'v'},
+	{"variant",		no_argument, NULL, 'X'},
 	USAGE_COMMON_LONG_OPTS,
 };
 static const char * const usage_opts_help[] = {
@@ -965,6 +1064,7 @@ static const char * const usage_opts_help[] = {
 	"Node/property/compatible string to exclude in grep",
 	"Output a header",
 	"Put \"/dts-v1/;\" on first line of dts output",
+	"Pass the .dtb output through the options which follow",
 	"Output a region list",
 	"List strings in string table",
 	"Include mem_rsvmap section in binary output",
@@ -981,6 +1081,7 @@ static const char * const usage_opts_help[] = {
 	"-o <output file>",
 	"-O <output format>",
 	"Invert the sense of matching (select non-matching lines)",
+	"Start a new output variant, using the options which follow",
 	USAGE_COMMON_OPTS_HELP
 };
 
@@ -1067,8 +1168,23 @@ void util_version(void)
 	exit(0);
 }
 
-static void scan_args(struct display_info *disp, int argc, char *argv[])
+static struct display_info *new_pass(void)
 {
+	struct display_info *disp;
+
+	disp = calloc(1, sizeof(*disp));
+	if (!disp) {
+		fprintf(stderr, "Out of memory\n");
+		exit(EXIT_FAILURE);
+	}
+	disp->flags = FDT_REG_SUPERNODES;	/* Default flags */
+
+	return disp;
+}
+
+static void scan_args(struct display_info *head, int argc, char *argv[])
+{
+	struct display_info *variant = head, *disp = head;
 	int opt;
 
 	while ((opt = util_getopt_long()) != EOF) {
@@ -1077,6 +1193,15 @@ static void scan_args(struct display_info *disp, int argc, char *argv[])
 
 		switch (opt) {
 		case_USAGE_COMMON_FLAGS
+		case 'J':
+			disp->then = new_pass();
+			disp = disp->then;
+			break;
+		case 'X':
+			variant->next = new_pass();
+			variant = variant->next;
+			disp = variant;
+			break;
 		case 'a':
 			disp->show_addr = 1;
 			break;
@@ -1175,12 +1300,53 @@ static void scan_args(struct display_info *disp, int argc, char *argv[])
 			usage("Cannot add value");
 	}
 
-	if (disp->invert && disp->types_exc)
-		usage("-v has no meaning when used with 'exclude' conditions");
+	for (variant = head; variant; variant = variant->next) {
+		for (disp = variant; disp; disp = disp->then) {
+			if (disp->invert && disp->types_exc)
+				usage("-v has no meaning when used with 'exclude' conditions");
+			if (disp->then && disp->output_fname)
+				usage("-o can only be used on the last pass");
+		}
+	}
+}
+
+/**
+ * setup_pass() - Finish setting up the options for a pass
+ *
+ * @disp:	Display information / options for the pass
+ * @return 0 if OK, -1 if the output file could not be opened
+ */
+static int setup_pass(struct display_info *disp)
+{
+	/* Show matched lines in colour if we can */
+	disp->colour = disp->all && isatty(0);
+
+	/* Each pass but the last feeds a .dtb to the next */
+	if (disp->then)
+		disp->output = OUT_DTB;
+
+	/* If a valid .dtb is required, set flags to ensure we get one */
+	if (disp->output == OUT_DTB) {
+		disp->header = 1;
+		disp->flags |= FDT_REG_ADD_MEM_RSVMAP | FDT_REG_ADD_STRING_TAB;
+	}
+
+	if (disp->then)
+		return 0;
+	if (disp->output_fname) {
+		disp->fout = fopen(disp->output_fname, "w");
+		if (!disp->fout)
+			return -1;
+	} else {
+		disp->fout = stdout;
+	}
+
+	return 0;
 }
 
 int main(int argc, char *argv[])
 {
+	struct display_info *variant, *pass;
 	char *filename = NULL;
 	struct display_info disp;
 	int ret;
@@ -1191,9 +1357,6 @@ int main(int argc, char *argv[])
 
 	scan_args(&disp, argc, argv);
 
-	/* Show matched lines in colour if we can */
-	disp.colour = disp.all && isatty(0);
-
 	/* Any additional arguments can match anything, just like -g */
 	while (optind < argc - 1) {
 		if (value_add(&disp, &disp.value_head, FDT_IS_ANY, 1,
@@ -1206,24 +1369,21 @@ int main(int argc, char *argv[])
 	if (!filename)
 		usage("Missing filename");
 
-	/* If a valid .dtb is required, set flags to ensure we get one */
-	if (disp.output == OUT_DTB) {
-		disp.header = 1;
-		disp.flags |= FDT_REG_ADD_MEM_RSVMAP | FDT_REG_ADD_STRING_TAB;
-	}
-
-	if (disp.output_fname) {
-		disp.fout = fopen(disp.output_fname, "w");
-		if (!disp.fout)
-			usage("Cannot open output file");
-	} else {
-		disp.fout = stdout;
+	for (variant = &disp; variant; variant = variant->next) {
+		for (pass = variant; pass; pass = pass->then) {
+			if (setup_pass(pass))
+				usage("Cannot open output file");
+		}
 	}
 
 	/* Run the grep and output the results */
 	ret = do_fdtgrep(&disp, filename);
-	if (disp.output_fname)
-		fclose(disp.fout);
+	for (variant = &disp; variant; variant = variant->next) {
+		for (pass = variant; pass->then; pass = pass->then)
+			;
+		if (pass->output_fname)
+			fclose(pass->fout);
+	}
 	if (ret)
 		return 1;
 
@@ -0,0 +1,1063 @@
+// SPDX-License-Identifier: GPL-2.0+
+/*
+ * Boot I/O planner for Rockchip firmware images
+ *
+ * Walks the partition table, misc, resource and kernel images of a Rockchip
+ * firmware the same way U-Boot does on the way to the kernel, and reports
+ * every block read it would issue together with the number of bytes, seeks
+ * and re-reads. It then suggests layout changes (ordering, alignment) which
+ * reduce the boot I/O.
+ *
+ * The firmware can be given as a raw storage image (GPT or Rockchip
+ * parameter partition table), an update.img (RKFW/RKAF), or a parameter.txt
+ * plus the individual partition images.
+ *
+ * Copyright (C) 2026 Rockchip Electronics Co., Ltd
+ */
+
+#include "mkimage.h"
+#include <getopt.h>
+#include <image.h>
+#include <u-boot/crc.h>
+
+/* The target headers below expect kernel-style types */
+typedef uint8_t u8;
+typedef uint16_t u16;
+typedef uint32_t u32;
+typedef uint64_t u64;
+typedef int16_t s16;
+#ifndef __packed
+#define __packed __attribute__((packed))
+#endif
+
+#include <android_image.h>
+#include <part_efi.h>
+
+#define ARRAY_SIZE(x)		(sizeof(x) / sizeof((x)[0]))
+#define DIV_ROUND_UP(n, d)	(((n) + (d) - 1) / (d))
+#define ALIGN(x, a)		(((x) + (a) - 1) & ~((uint64_t)(a) - 1))
+
+#define MAX_PARTS		128
+#define MAX_IOS			256
+#define PART_NAME_LEN		32
+
+/* disk/part_rkparm.c */
+#define RK_PARAM_OFFSET		0x2000
+#define MAX_PARAM_SIZE		(1024 * 64)
+
+/* struct bootloader_message, include/android_bootloader_message.h */
+#define BCB_MESSAGE_SIZE	2048
+#define BCB_MESSAGE_BLK_OFFSET	0x20
+
+/* arch/arm/mach-rockchip/resource_img.c */
+#define RESOURCE_MAGIC		"RSCE"
+#define RESOURCE_MAGIC_SIZE	4
+#define MAX_FILE_NAME_LEN	220
+#define MAX_HASH_LEN		32
+#define DEFAULT_DTB_FILE	"rk-kernel.dtb"
+
+struct resource_img_hdr {
+	char		magic[4];
+	uint16_t	version;
+	uint16_t	c_version;
+	uint8_t		blks;
+	uint8_t		c_offset;
+	uint8_t		e_blks;
+	uint32_t	e_nums;
+};
+
+struct resource_entry {
+	char		tag[4];
+	char		name[MAX_FILE_NAME_LEN];
+	char		hash[MAX_HASH_LEN];
+	uint32_t	hash_size;
+	uint32_t	blk_offset;
+	uint32_t	size;
+};
+
+/* arch/arm/mach-rockchip/fit.c */
+#define FIT_FDT_MAX_SIZE	4096
+
+/* update.img: RKFW wrapper around an RKAF package */
+#define RKFW_IMAGE_OFFSET	0x21
+#define RKFW_IMAGE_LENGTH	0x25
+#define RKAF_MAX_PARTS		16
+#define RKAF_NO_FLASH		0xffffffff
+
+struct rkaf_part {
+	char		name[32];
+	char		filename[60];
+	uint32_t	nand_size;
+	uint32_t	pos;
+	uint32_t	nand_addr;
+	uint32_t	padded_size;
+	uint32_t	size;
+} __packed;
+
+struct rkaf_header {
+	char		magic[4];
+	uint32_t	length;
+	char		model[0x22];
+	char		id[0x1e];
+	char		manufacturer[0x38];
+	uint32_t	unknown1;
+	uint32_t	version;
+	uint32_t	num_parts;
+	struct rkaf_part parts[RKAF_MAX_PARTS];
+	char		reserved[0x74];
+} __packed;
+
+struct part {
+	char name[PART_NAME_LEN];
+	uint64_t start;		/* in blocks */
+	uint64_t size;		/* in blocks */
+	int fd;			/* image backing the partition, or -1 */
+	uint64_t file_offset;	/* offset of the image in @fd */
+	uint64_t file_size;	/* size of the image in @fd */
+	int first_io;		/* index of the first read, or -1 */
+};
+
+struct io {
+	const char *what;
+	const struct part *part;
+	uint64_t lba;
+	uint64_t blkcnt;
+};
+
+/* Holds information about the boot device and the reads issued to it */
+struct plan {
+	unsigned int blksz;	/* Block size of the boot device */
+	unsigned int align;	/* Suggested partition alignment, in blocks */
+	const char *slot;	/* A/B slot suffix, or NULL */
+	bool recovery;		/* Follow the recovery boot path */
+	bool verbose;		/* Print each partition */
+	int disk_fd;		/* Raw disk image, or -1 */
+	uint64_t disk_size;	/* Size of raw disk image in bytes */
+	bool gpt;		/* Partition table is GPT, else rkparm */
+	struct part parts[MAX_PARTS];
+	int num_parts;
+	struct io ios[MAX_IOS];
+	int num_ios;
+};
+
+static void *xmalloc(size_t size)
+{
+	void *buf = calloc(1, size);
+
+	if (!buf) {
+		fprintf(stderr, "Out of memory\n");
+		exit(1);
+	}
+
+	return buf;
+}
+
+static uint32_t get_le32(const void *ptr)
+{
+	const uint8_t *p = ptr;
+
+	return p[0] | p[1] << 8 | p[2] << 16 | (uint32_t)p[3] << 24;
+}
+
+static struct part *find_part(struct plan *plan, const char *name)
+{
+	char slotted[PART_NAME_LEN + 4];
+	int i;
+
+	if (plan->slot) {
+		snprintf(slotted, sizeof(slotted), "%s%s", name, plan->slot);
+		for (i = 0; i < plan->num_parts; i++)
+			if (!strcmp(plan->parts[i].name, slotted))
+				return &plan->parts[i];
+	}
+	for (i = 0; i < plan->num_parts; i++)
+		if (!strcmp(plan->parts[i].name, name))
+			return &plan->parts[i];
+
+	return NULL;
+}
+
+static struct part *add_part(struct plan *plan, const char *name,
+			     uint64_t start, uint64_t size)
+{
+	struct part *part;
+
+	if (plan->num_parts == MAX_PARTS) {
+		fprintf(stderr, "Too many partitions\n");
+		exit(1);
+	}
+	part = &plan->parts[plan->num_parts++];
+	snprintf(part->name, sizeof(part->name), "%s", name);
+	part->start = start;
+	part->size = size;
+	part->fd = -1;
+	part->first_io = -1;
+
+	return part;
+}
+
+static struct part *part_of_lba(struct plan *plan, uint64_t lba)
+{
+	int i;
+
+	for (i = 0; i < plan->num_parts; i++) {
+		struct part *part = &plan->parts[i];
+
+		if (lba >= part->start && lba < part->start + part->size)
+			return part;
+	}
+
+	return NULL;
+}
+
+static void read_file(int fd, uint64_t offset, uint64_t file_size,
+		      void *buf, size_t len)
+{
+	ssize_t ret;
+
+	if (offset >= file_size)
+		return;
+	if (len > file_size - offset)
+		len = file_size - offset;
+	ret = pread(fd, buf, len, offset);
+	if (ret < 0)
+		fprintf(stderr, "Read error: %s\n", strerror(errno));
+}
+
+/**
+ * dev_read() - Record a block read and return the data it would return
+ *
+ * @plan:	Boot device
+ * @what:	Description of the read, for the report
+ * @lba:	First block to read
+ * @blkcnt:	Number of blocks to read
+ * @return buffer holding the blocks (zeros where the image has no data),
+ * which the caller must free
+ */
+static void *dev_read(struct plan *plan, const char *what, uint64_t lba,
+		      uint64_t blkcnt)
+{
+	struct part *part = part_of_lba(plan, lba);
+	size_t len = blkcnt * plan->blksz;
+	struct io *io;
+	void *buf;
+
+	if (plan->num_ios == MAX_IOS) {
+		fprintf(stderr, "Too many reads\n");
+		exit(1);
+	}
+	io = &plan->ios[plan->num_ios];
+	io->what = what;
+	io->part = part;
+	io->lba = lba;
+	io->blkcnt = blkcnt;
+	if (part && part->first_io < 0)
+		part->first_io = plan->num_ios;
+	plan->num_ios++;
+
+	buf = xmalloc(len);
+	if (plan->disk_fd >= 0)
+		read_file(plan->disk_fd, lba * plan->blksz, plan->disk_size,
+			  buf, len);
+	else if (part && part->fd >= 0)
+		read_file(part->fd, part->file_offset +
+			  (lba - part->start) * plan->blksz,
+			  part->file_offset + part->file_size, buf, len);
+
+	return buf;
+}
+
+static int open_file(const char *fname, uint64_t *sizep)
+{
+	struct stat st;
+	int fd;
+
+	fd = open(fname, O_RDONLY | O_BINARY);
+	if (fd < 0 || fstat(fd, &st)) {
+		fprintf(stderr, "Cannot open '%s': %s\n", fname,
+			strerror(errno));
+		exit(1);
+	}
+	*sizep = st.st_size;
+
+	return fd;
+}
+
+/**
+ * parse_parameter() - Add partitions from the mtdparts of a parameter.txt
+ *
+ * This follows rkparm_param_parse() in disk/part_rkparm.c, including the
+ * RK_PARAM_OFFSET which is added for non-NAND devices. With 'TYPE: GPT' the
+ * offsets are used directly, as the GPT is generated from them.
+ *
+ * @plan:	Boot device to add partitions to
+ * @param:	Text of parameter.txt, nul-terminated
+ * @return 0 if OK, -EINVAL if no partitions were found
+ */
+static int parse_parameter(struct plan *plan, const char *param)
+{
+	const char *next, *pend;
+	char name[PART_NAME_LEN];
+	uint64_t size, start;
+	unsigned int offset;
+	int len;
+
+	plan->gpt = strstr(param, "TYPE: GPT") || strstr(param, "TYPE:GPT");
+	offset = plan->gpt ? 0 : RK_PARAM_OFFSET;
+
+	next = strstr(param, "mtdparts");
+	if (next)
+		next = strchr(next, ':');
+	while (next) {
+		/* Skip ':' and ',' */
+		next++;
+		if (*next == '-') {
+			size = 0;
+			next++;
+		} else {
+			size = strtoull(next, (char **)&next, 16);
+		}
+		/* Skip '@' */
+		next++;
+		start = strtoull(next, (char **)&next, 16);
+		next++;
+		pend = strchr(next, ')');
+		if (!pend)
+			break;
+		len = pend - next;
+		if (len >= PART_NAME_LEN)
+			len = PART_NAME_LEN - 1;
+		memcpy(name, next, len);
+		name[len] = '\0';
+		/* drop flags such as ':grow' */
+		name[strcspn(name, ":")] = '\0';
+		/* the last partition uses all remaining space */
+		add_part(plan, name, start + offset, size ? size : ~0ULL >> 1);
+		next = strpbrk(next, ",\n");
+		if (next && *next != ',')
+			break;
+	}
+
+	return plan->num_parts ? 0 : -EINVAL;
+}
+
+static void read_part_table_gpt(struct plan *plan)
+{
+	gpt_header *hdr;
+	gpt_entry *entries;
+	uint64_t blkcnt;
+	void *pmbr;
+	uint32_t i, num;
+
+	pmbr = dev_read(plan, "GPT protective MBR", 0, 1);
+	free(pmbr);
+	hdr = dev_read(plan, "GPT header", GPT_PRIMARY_PARTITION_TABLE_LBA, 1);
+	if (plan->disk_fd >= 0 && le64_to_cpu(hdr->signature) !=
+	    GPT_HEADER_SIGNATURE) {
+		fprintf(stderr, "No valid GPT header\n");
+		exit(1);
+	}
+	if (plan->disk_fd < 0) {
+		/* layout from parameter.txt: assume a default GPT */
+		hdr->partition_entry_lba = cpu_to_le64(2);
+		hdr->num_partition_entries = cpu_to_le32(128);
+		hdr->sizeof_partition_entry = cpu_to_le32(GPT_ENTRY_SIZE);
+	}
+
+	num = le32_to_cpu(hdr->num_partition_entries);
+	blkcnt = DIV_ROUND_UP((uint64_t)num *
+			      le32_to_cpu(hdr->sizeof_partition_entry),
+			      plan->blksz);
+	entries = dev_read(plan, "GPT entries",
+			   le64_to_cpu(hdr->partition_entry_lba), blkcnt);
+	for (i = 0; plan->disk_fd >= 0 && i < num; i++) {
+		gpt_entry *gpte = (void *)entries +
+			i * le32_to_cpu(hdr->sizeof_partition_entry);
+		uint64_t start = le64_to_cpu(gpte->starting_lba);
+		char name[PART_NAME_LEN];
+		int j;
+
+		if (!start)
+			continue;
+		for (j = 0; j < PART_NAME_LEN - 1 && j < PARTNAME_SZ; j++)
+			name[j] = le16_to_cpu(gpte->partition_name[j]) & 0x7f;
+		name[j] = '\0';
+		add_part(plan, name, start,
+			 le64_to_cpu(gpte->ending_lba) - start + 1);
+	}
+	free(entries);
+	free(hdr);
+}
+
+static void read_part_table_rkparm(struct plan *plan)
+{
+	char *param;
+
+	param = dev_read(plan, "parameter", RK_PARAM_OFFSET,
+			 MAX_PARAM_SIZE / plan->blksz);
+	if (plan->disk_fd >= 0) {
+		/* skip the 'PARM' tag and length */
+		param[MAX_PARAM_SIZE - 1] = '\0';
+		if (parse_parameter(plan, param + 8)) {
+			fprintf(stderr, "No valid parameter partition table\n");
+			exit(1);
+		}
+	}
+	free(param);
+}
+
+/*
+ * Rockchip puts the BCB at 16KB in misc.img, except for Android 10 and
+ * later which puts it at the start (see android_bcb_msg_sector_offset()).
+ */
+static void read_misc(struct plan *plan, int android_version)
+{
+	struct part *misc = find_part(plan, ANDROID_PARTITION_MISC);
+	uint64_t offset;
+
+	if (!misc)
+		return;
+	offset = android_version >= 10 ? 0 : BCB_MESSAGE_BLK_OFFSET;
+	free(dev_read(plan, "misc: bootloader message", misc->start + offset,
+		      DIV_ROUND_UP(BCB_MESSAGE_SIZE, plan->blksz)));
+}
+
+/* Same reads as populate_andr_img_hdr() for a v0-2 header */
+static struct andr_img_hdr *read_android_hdr(struct plan *plan,
+					     struct part *part)
+{
+	struct andr_img_hdr *hdr;
+
+	hdr = dev_read(plan, "android: header check", part->start, 1);
+	if (memcmp(hdr->magic, ANDR_BOOT_MAGIC, ANDR_BOOT_MAGIC_SIZE)) {
+		free(hdr);
+		return NULL;
+	}
+	free(hdr);
+
+	return dev_read(plan, "android: header", part->start,
+			DIV_ROUND_UP(sizeof(*hdr), plan->blksz));
+}
+
+static const struct resource_entry *resource_get_entry(const void *buf,
+							unsigned int stride,
+							int index)
+{
+	return buf + (size_t)index * stride;
+}
+
+static const struct resource_entry *find_dtb(const void *buf,
+					     unsigned int stride, int count)
+{
+	const struct resource_entry *et, *dtb = NULL;
+	int i;
+
+	for (i = 0; i < count; i++) {
+		const char *ext;
+
+		et = resource_get_entry(buf, stride, i);
+		ext = strrchr(et->name, '.');
+		if (!strcmp(et->name, DEFAULT_DTB_FILE))
+			return et;
+		if (!dtb && ext && !strcmp(ext, ".dtb"))
+			dtb = et;
+	}
+
+	return dtb;
+}
+
+/* Reads of resource_setup_blk_list() and rockchip_read_resource_dtb() */
+static void read_resource(struct plan *plan, uint64_t blk_start)
+{
+	const struct resource_entry *et, *dtb;
+	struct resource_img_hdr *hdr;
+	unsigned int stride;
+	uint64_t blkcnt;
+	int i, count;
+	void *buf;
+
+	hdr = dev_read(plan, "resource: header", blk_start, 1);
+	if (memcmp(hdr->magic, RESOURCE_MAGIC, RESOURCE_MAGIC_SIZE)) {
+		fprintf(stderr, "No resource image at block %#llx\n",
+			(unsigned long long)blk_start);
+		free(hdr);
+		return;
+	}
+	/* each entry takes e_blks blocks */
+	count = hdr->e_nums;
+	stride = hdr->e_blks * plan->blksz;
+	blkcnt = (uint64_t)hdr->e_blks * count;
+	buf = dev_read(plan, "resource: entries", blk_start + hdr->c_offset,
+		       blkcnt);
+	free(hdr);
+	if (stride < sizeof(*et))
+		count = 0;
+
+	for (i = 0; i < count; i++) {
+		et = resource_get_entry(buf, stride, i);
+		if (!strcmp(et->name, "logo.bmp") ||
+		    !strcmp(et->name, "logo_kernel.bmp"))
+			free(dev_read(plan, "resource: logo header",
+				      blk_start + et->blk_offset, 1));
+	}
+	dtb = find_dtb(buf, stride, count);
+	if (dtb)
+		free(dev_read(plan, "resource: dtb",
+			      blk_start + dtb->blk_offset,
+			      DIV_ROUND_UP(dtb->size, plan->blksz)));
+	free(buf);
+}
+
+/* Same as image_load() in common/image-android.c */
+static void read_android_image(struct plan *plan, struct part *part,
+			       const char *what, uint64_t offset,
+			       uint64_t size)
+{
+	if (!size)
+		return;
+	free(dev_read(plan, what, part->start +
+		      DIV_ROUND_UP(offset, plan->blksz),
+		      DIV_ROUND_UP(size, plan->blksz)));
+}
+
+static int boot_android(struct plan *plan, struct part *boot)
+{
+	struct andr_img_hdr *hdr;
+	struct part *resc;
+	uint64_t pgsz, offset;
+	void *buf;
+
+	/* resource: in the second stage of boot.img, else 'resource' */
+	hdr = read_android_hdr(plan, boot);
+	if (!hdr)
+		return -EINVAL;
+	if (hdr->header_version > 2) {
+		fprintf(stderr, "Android boot image v%u is not supported\n",
+			hdr->header_version);
+		free(hdr);
+		return -EINVAL;
+	}
+	pgsz = hdr->page_size;
+	offset = pgsz + ALIGN(hdr->kernel_size, pgsz) +
+		 ALIGN(hdr->ramdisk_size, pgsz);
+	buf = dev_read(plan, "android: resource check", boot->start +
+		       DIV_ROUND_UP(offset, plan->blksz), 1);
+	if (!memcmp(buf, RESOURCE_MAGIC, RESOURCE_MAGIC_SIZE)) {
+		read_resource(plan, boot->start +
+			      DIV_ROUND_UP(offset, plan->blksz));
+	} else {
+		resc = find_part(plan, ANDROID_PARTITION_RESOURCE);
+		if (resc)
+			read_resource(plan, resc->start);
+	}
+	free(buf);
+	free(hdr);
+
+	/* android_image_load() */
+	hdr = read_android_hdr(plan, boot);
+	free(dev_read(plan, "android: kernel compression check",
+		      boot->start + DIV_ROUND_UP(pgsz, plan->blksz), 1));
+	read_android_image(plan, boot, "android: kernel", 0,
+			   hdr->kernel_size + pgsz);
+	offset = pgsz + ALIGN(hdr->kernel_size, pgsz);
+	read_android_image(plan, boot, "android: ramdisk", offset,
+			   hdr->ramdisk_size);
+	offset += ALIGN(hdr->ramdisk_size, pgsz);
+	read_android_image(plan, boot, "android: second", offset,
+			   hdr->second_size);
+	offset += ALIGN(hdr->second_size, pgsz);
+	if (hdr->header_version > 0)
+		read_android_image(plan, boot, "android: recovery dtbo",
+				   offset, hdr->recovery_dtbo_size);
+	offset += ALIGN(hdr->recovery_dtbo_size, pgsz);
+	if (hdr->header_version > 1)
+		read_android_image(plan, boot, "android: dtb", offset,
+				   hdr->dtb_size);
+	free(hdr);
+
+	return 0;
+}
+
+/* Same as fit_get_blob() in arch/arm/mach-rockchip/fit.c */
+static void *read_fit_blob(struct plan *plan, struct part *boot)
+{
+	uint32_t size;
+	void *fdt;
+
+	fdt = dev_read(plan, "fit: header", boot->start,
+		       DIV_ROUND_UP(sizeof(struct fdt_header), plan->blksz));
+	size = fdt_totalsize(fdt);
+	if (fdt_check_header(fdt) || size >= FIT_FDT_MAX_SIZE) {
+		free(fdt);
+		return NULL;
+	}
+	free(fdt);
+
+	return dev_read(plan, "fit: blob", boot->start,
+			DIV_ROUND_UP(size, plan->blksz));
+}
+
+/* Same as fdt_image_get_offset_size() in arch/arm/mach-rockchip/fit.c */
+static int fit_get_offset_size(const void *fit, const char *prop_name,
+			       int *offset, int *size)
+{
+	int noffset;
+
+	noffset = fit_conf_get_node(fit, NULL);
+	if (noffset < 0)
+		return noffset;
+	noffset = fit_conf_get_prop_node(fit, noffset, prop_name);
+	if (noffset < 0)
+		return noffset;
+	if (fit_image_get_data_size(fit, noffset, size))
+		return -ENOENT;
+	if (!fit_image_get_data_position(fit, noffset, offset)) {
+		*offset -= fdt_totalsize(fit);
+		return 0;
+	}
+
+	return fit_image_get_data_offset(fit, noffset, offset);
+}
+
+static int boot_fit(struct plan *plan, struct part *boot)
+{
+	static const char * const bootables[] = {
+		FIT_FDT_PROP, FIT_KERNEL_PROP, FIT_RAMDISK_PROP,
+	};
+	uint64_t end, max_end = 0;
+	int offset, size;
+	unsigned int i;
+	void *fit;
+
+	/* fit_image_init_resource() */
+	fit = read_fit_blob(plan, boot);
+	if (!fit)
+		return -EINVAL;
+	if (!fit_get_offset_size(fit, FIT_MULTI_PROP, &offset, &size))
+		free(dev_read(plan, "fit: resource", boot->start +
+			      (FIT_ALIGN(fdt_totalsize(fit)) + offset) /
+			      plan->blksz, DIV_ROUND_UP(size, plan->blksz)));
+	free(fit);
+
+	/* fit_image_load_bootables() */
+	fit = read_fit_blob(plan, boot);
+	for (i = 0; i < ARRAY_SIZE(bootables); i++) {
+		if (fit_get_offset_size(fit, bootables[i], &offset, &size))
+			continue;
+		end = offset + FIT_ALIGN(size);
+		if (end > max_end)
+			max_end = end;
+	}
+	if (max_end)
+		free(dev_read(plan, "fit: bootables", boot->start,
+			      DIV_ROUND_UP(FIT_ALIGN(fdt_totalsize(fit)) +
+					   max_end, plan->blksz)));
+	free(fit);
+
+	return 0;
+}
+
+/**
+ * simulate_boot() - Issue the reads U-Boot makes up to kernel handoff
+ *
+ * This models the default Rockchip flow (CONFIG_RKIMG_BOOTLOADER with
+ * CONFIG_ROCKCHIP_RESOURCE_IMAGE): partition table, Android version
+ * detection, boot mode from misc, resource (from FIT, boot.img or the
+ * resource partition) and finally the kernel images.
+ *
+ * @plan:	Boot device
+ * @return 0 if OK, -ve on error
+ */
+static int simulate_boot(struct plan *plan)
+{
+	const char *name = plan->recovery ? ANDROID_PARTITION_RECOVERY :
+					    ANDROID_PARTITION_BOOT;
+	struct andr_img_hdr *hdr;
+	struct part *boot;
+	int android_version = -1;
+
+	if (plan->gpt)
+		read_part_table_gpt(plan);
+	else
+		read_part_table_rkparm(plan);
+
+	boot = find_part(plan, name);
+	if (!boot) {
+		fprintf(stderr, "No '%s' partition\n", name);
+		return -ENOENT;
+	}
+
+	/* android_version_init() */
+	hdr = read_android_hdr(plan, boot);
+	if (hdr) {
+		android_version = (hdr->os_version >> 25) & 0x7f;
+		free(hdr);
+	}
+	read_misc(plan, android_version);
+
+	if (!boot_fit(plan, boot) || !boot_android(plan, boot))
+		return 0;
+
+	fprintf(stderr, "No FIT or Android image in '%s'\n", boot->name);
+
+	return -EINVAL;
+}
+
+static int cmp_io_lba(const void *a, const void *b)
+{
+	const struct io *x = a, *y = b;
+
+	return x->lba < y->lba ? -1 : x->lba > y->lba;
+}
+
+/* Number of blocks covered by the reads, counting each block only once */
+static uint64_t unique_blocks(struct plan *plan)
+{
+	struct io *sorted;
+	uint64_t total = 0, end = 0;
+	int i;
+
+	sorted = xmalloc((plan->num_ios + 1) * sizeof(*sorted));
+	memcpy(sorted, plan->ios, plan->num_ios * sizeof(*sorted));
+	qsort(sorted, plan->num_ios, sizeof(*sorted), cmp_io_lba);
+	for (i = 0; i < plan->num_ios; i++) {
+		uint64_t start = sorted[i].lba;
+		uint64_t stop = start + sorted[i].blkcnt;
+
+		if (start < end)
+			start = end;
+		if (stop > start) {
+			total += stop - start;
+			end = stop;
+		}
+	}
+	free(sorted);
+
+	return total;
+}
+
+static void print_plan(struct plan *plan)
+{
+	uint64_t total = 0, prev_end = 0, uniq;
+	int i, seeks = 0;
+
+	if (plan->verbose) {
+		printf("Partitions (%s):\n", plan->gpt ? "GPT" : "rkparm");
+		for (i = 0; i < plan->num_parts; i++)
+			printf("  %-16s %#10llx %#10llx\n",
+			       plan->parts[i].name,
+			       (unsigned long long)plan->parts[i].start,
+			       (unsigned long long)plan->parts[i].size);
+		printf("\n");
+	}
+
+	printf("I/O plan (block size %u):\n", plan->blksz);
+	printf("  %3s  %-36s %-12s %10s %8s %s\n", "#", "read", "partition",
+	       "lba", "blocks", "seek");
+	for (i = 0; i < plan->num_ios; i++) {
+		struct io *io = &plan->ios[i];
+		bool seek = i && io->lba != prev_end;
+
+		printf("  %3d  %-36s %-12s %#10llx %8llu %s\n", i, io->what,
+		       io->part ? io->part->name : "-",
+		       (unsigned long long)io->lba,
+		       (unsigned long long)io->blkcnt, seek ? "yes" : "");
+		seeks += seek;
+		total += io->blkcnt;
+		prev_end = io->lba + io->blkcnt;
+	}
+	uniq = unique_blocks(plan);
+	printf("\nTotal: %d reads, %llu bytes, %d seeks, %llu bytes re-read\n",
+	       plan->num_ios, (unsigned long long)total * plan->blksz, seeks,
+	       (unsigned long long)(total - uniq) * plan->blksz);
+}
+
+static int cmp_part_first_io(const void *a, const void *b)
+{
+	const struct part *x = *(const struct part **)a;
+	const struct part *y = *(const struct part **)b;
+
+	return x->first_io - y->first_io;
+}
+
+static void print_suggestions(struct plan *plan)
+{
+	struct part *used[MAX_PARTS];
+	int i, j, count = 0, suggestions = 0;
+	bool ordered = true;
+
+	printf("\nSuggestions:\n");
+
+	/* reads which return blocks already read earlier */
+	for (i = 1; i < plan->num_ios; i++) {
+		struct io *io = &plan->ios[i];
+
+		for (j = i - 1; j >= 0; j--) {
+			struct io *prev = &plan->ios[j];
+
+			if (io->lba < prev->lba + prev->blkcnt &&
+			    prev->lba < io->lba + io->blkcnt) {
+				printf("  - read %d (%s) overlaps read %d (%s); keep the data from the first read\n",
+				       i, io->what, j, prev->what);
+				suggestions++;
+				break;
+			}
+		}
+	}
+
+	/* partitions should be laid out in the order they are read */
+	for (i = 0; i < plan->num_parts; i++)
+		if (plan->parts[i].first_io >= 0)
+			used[count++] = &plan->parts[i];
+	qsort(used, count, sizeof(*used), cmp_part_first_io);
+	for (i = 1; i < count; i++)
+		if (used[i]->start < used[i - 1]->start)
+			ordered = false;
+	if (!ordered) {
+		printf("  - place partitions in the order they are read:");
+		for (i = 0; i < count; i++)
+			printf(" %s", used[i]->name);
+		printf("\n");
+		suggestions++;
+	}
+
+	/* partitions and reads should start on an aligned block */
+	for (i = 0; i < count; i++) {
+		if (used[i]->start % plan->align) {
+			printf("  - align partition '%s' (start %#llx) to %u blocks\n",
+			       used[i]->name,
+			       (unsigned long long)used[i]->start,
+			       plan->align);
+			suggestions++;
+		}
+	}
+	for (i = 0, j = 0; i < plan->num_ios; i++)
+		if ((plan->ios[i].lba * plan->blksz) % 4096)
+			j++;
+	if (j) {
+		printf("  - %d reads do not start on a 4KiB boundary; use a 4KiB page size in boot.img and align FIT external data to 4KiB\n",
+		       j);
+		suggestions++;
+	}
+
+	if (!suggestions)
+		printf("  (none)\n");
+}
+
+static void add_image(struct plan *plan, const char *arg)
+{
+	const char *eq = strchr(arg, '=');
+	char name[PART_NAME_LEN];
+	struct part *part;
+	int len;
+
+	if (!eq) {
+		fprintf(stderr, "Expected <partition>=<file>: '%s'\n", arg);
+		exit(1);
+	}
+	len = eq - arg < PART_NAME_LEN ? eq - arg : PART_NAME_LEN - 1;
+	memcpy(name, arg, len);
+	name[len] = '\0';
+	part = find_part(plan, name);
+	if (!part) {
+		fprintf(stderr, "No partition '%s' in parameter\n", name);
+		exit(1);
+	}
+	part->fd = open_file(eq + 1, &part->file_size);
+}
+
+static char *read_text(const char *fname)
+{
+	uint64_t size;
+	char *text;
+	int fd;
+
+	fd = open_file(fname, &size);
+	text = xmalloc(size + 1);
+	read_file(fd, 0, size, text, size);
+	close(fd);
+
+	return text;
+}
+
+/* Set up partitions and their images from an RKFW/RKAF update.img */
+static void open_update_img(struct plan *plan, int fd, uint64_t size)
+{
+	struct rkaf_header *hdr;
+	uint8_t fw[0x30];
+	uint64_t base = 0;
+	char *param;
+	uint32_t i, num;
+
+	read_file(fd, 0, size, fw, sizeof(fw));
+	if (!memcmp(fw, "RKFW", 4))
+		base = get_le32(fw + RKFW_IMAGE_OFFSET);
+
+	hdr = xmalloc(sizeof(*hdr));
+	read_file(fd, base, size, hdr, sizeof(*hdr));
+	if (memcmp(hdr->magic, "RKAF", 4)) {
+		fprintf(stderr, "Not an update image\n");
+		exit(1);
+	}
+
+	num = le32_to_cpu(hdr->num_parts);
+	if (num > RKAF_MAX_PARTS)
+		num = RKAF_MAX_PARTS;
+	for (i = 0; i < num; i++) {
+		struct rkaf_part *p = &hdr->parts[i];
+
+		if (strcmp(p->name, "parameter"))
+			continue;
+		param = xmalloc(le32_to_cpu(p->size) + 1);
+		read_file(fd, base + le32_to_cpu(p->pos), size, param,
+			  le32_to_cpu(p->size));
+		/* skip the 'PARM' tag and length */
+		if (parse_parameter(plan, param + 8)) {
+			fprintf(stderr, "No partitions in parameter\n");
+			exit(1);
+		}
+		free(param);
+	}
+	for (i = 0; i < num; i++) {
+		struct rkaf_part *p = &hdr->parts[i];
+		struct part *part = find_part(plan, p->name);
+
+		if (!part || le32_to_cpu(p->nand_addr) == RKAF_NO_FLASH)
+			continue;
+		part->fd = fd;
+		part->file_offset = base + le32_to_cpu(p->pos);
+		part->file_size = le32_to_cpu(p->size);
+	}
+	free(hdr);
+}
+
+static void open_disk_img(struct plan *plan, int fd, uint64_t size)
+{
+	gpt_header hdr;
+	char tag[4];
+
+	plan->disk_fd = fd;
+	plan->disk_size = size;
+	read_file(fd, plan->blksz, size, &hdr, sizeof(hdr));
+	plan->gpt = le64_to_cpu(hdr.signature) == GPT_HEADER_SIGNATURE;
+	read_file(fd, RK_PARAM_OFFSET * plan->blksz, size, tag, sizeof(tag));
+	if (!plan->gpt && memcmp(tag, "PARM", 4)) {
+		fprintf(stderr, "No GPT or parameter partition table found\n");
+		exit(1);
+	}
+}
+
+static void usage(const char *msg)
+{
+	if (msg)
+		fprintf(stderr, "Error: %s\n\n", msg);
+	fprintf(stderr,
+		"boot_ioplan - report the reads U-Boot makes to boot a Rockchip firmware\n\n"
+		"Usage: boot_ioplan [options] <disk.img | update.img>\n"
+		"       boot_ioplan [options] -p parameter.txt -i <part>=<file> ...\n\n"
+		"Options:\n"
+		"  -a, --align <blocks>     Suggested partition alignment (default 0x2000)\n"
+		"  -b, --blksz <bytes>      Block size of the boot device (default 512)\n"
+		"  -h, --help               Print this help\n"
+		"  -i, --image <part>=<f>   Image file for a partition in parameter.txt\n"
+		"  -p, --parameter <file>   Partition layout from parameter.txt\n"
+		"  -r, --recovery           Follow the recovery boot path\n"
+		"  -s, --slot <suffix>      A/B slot suffix, e.g. _a\n"
+		"  -v, --verbose            Also print the partition table\n");
+	exit(msg ? 1 : 0);
+}
+
+static const struct option options[] = {
+	{ "align", required_argument, NULL, 'a' },
+	{ "blksz", required_argument, NULL, 'b' },
+	{ "help", no_argument, NULL, 'h' },
+	{ "image", required_argument, NULL, 'i' },
+	{ "parameter", required_argument, NULL, 'p' },
+	{ "recovery", no_argument, NULL, 'r' },
+	{ "slot", required_argument, NULL, 's' },
+	{ "verbose", no_argument, NULL, 'v' },
+	{ NULL, 0, NULL, 0 },
+};
+
+int main(int argc, char *argv[])
+{
+	static struct plan plan;
+	const char *images[MAX_PARTS];
+	const char *param = NULL;
+	int num_images = 0;
+	uint64_t size;
+	char *text;
+	int i, opt, fd;
+
+	plan.blksz = 512;
+	plan.align = RK_PARAM_OFFSET;
+	plan.disk_fd = -1;
+	while ((opt = getopt_long(argc, argv, "a:b:hi:p:rs:v", options,
+				  NULL)) != -1) {
+		switch (opt) {
+		case 'a':
+			plan.align = strtoul(optarg, NULL, 0);
+			break;
+		case 'b':
+			plan.blksz = strtoul(optarg, NULL, 0);
+			break;
+		case 'h':
+			usage(NULL);
+			break;
+		case 'i':
+			if (num_images == MAX_PARTS)
+				usage("Too many images");
+			images[num_images++] = optarg;
+			break;
+		case 'p':
+			param = optarg;
+			break;
+		case 'r':
+			plan.recovery = true;
+			break;
+		case 's':
+			plan.slot = optarg;
+			break;
+		case 'v':
+			plan.verbose = true;
+			break;
+		default:
+			usage("Invalid option");
+		}
+	}
+	if (plan.blksz < 512 || plan.blksz & (plan.blksz - 1))
+		usage("Block size must be a power of two, at least 512");
+	if (!plan.align)
+		usage("Alignment must not be zero");
+
+	if (param) {
+		if (optind != argc)
+			usage("Cannot use an image file with -p");
+		text = read_text(param);
+		if (parse_parameter(&plan, text))
+			usage("No partitions in parameter file");
+		free(text);
+		for (i = 0; i < num_images; i++)
+			add_image(&plan, images[i]);
+	} else {
+		if (optind != argc - 1)
+			usage("Expected one image file");
+		if (num_images)
+			usage("-i needs -p");
+		fd = open_file(argv[optind], &size);
+		text = xmalloc(4);
+		read_file(fd, 0, size, text, 4);
+		if (!memcmp(text, "RKFW", 4) || !memcmp(text, "RKAF", 4))
+			open_update_img(&plan, fd, size);
+		else
+			open_disk_img(&plan, fd, size);
+		free(text);
+	}
+
+	if (simulate_boot(&plan))
+		return 1;
+	print_plan(&plan);
+	print_suggestions(&plan);
+
+	return 0;
+}